@@ -10,7 +10,9 @@ public class BlueprintMCPServer : ModuleRules
         {
             "Core",
             "CoreUObject",
+            "TraceLog",
             "Engine",
+            "DeveloperSettings",
             "Slate",
             "SlateCore",
             "Json",
@@ -30,6 +32,8 @@ public class BlueprintMCPServer : ModuleRules
             "EditorStyle",
             "HttpServer",
             "HTTPServer",
+            "HTTP",
+            "WebSocketNetworking",
             "Projects"
         });
     }
@@ -2,60 +2,50 @@
 
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
 #include "Engine/Blueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Misc/PackageName.h"
+#include "UObject/Package.h"
 #include "Json.h"
+#include "McpNodeTitleCache.h"
+#include "McpTrace.h"
 
 bool FMcpBlueprintInspector::BuildBlueprintJson(const FString& BlueprintPath, TSharedRef<FJsonObject>& OutJson, FString& OutError)
 {
-    UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+    UBlueprint* Blueprint = nullptr;
+    {
+        MCP_TRACE_SCOPE("Mcp::LoadObject");
+        Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+    }
     if (!Blueprint)
     {
         OutError = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *BlueprintPath);
         return false;
     }
 
-    OutJson->SetStringField(TEXT("asset_name"), Blueprint->GetName());
-    OutJson->SetStringField(TEXT("asset_path"), Blueprint->GetPathName());
-
-    TArray<TSharedPtr<FJsonValue>> VarArray;
-    for (const FBPVariableDescription& Var : Blueprint->NewVariables)
-    {
-        TSharedRef<FJsonObject> VarObj = MakeShared<FJsonObject>();
-        VarObj->SetStringField(TEXT("name"), Var.VarName.ToString());
-        VarObj->SetStringField(TEXT("type"), DescribePinType(Var.VarType));
-        VarObj->SetBoolField(TEXT("is_array"), Var.VarType.IsArray());
-        VarObj->SetBoolField(TEXT("is_set"), Var.VarType.IsSet());
-        VarObj->SetBoolField(TEXT("is_map"), Var.VarType.IsMap());
-
-        VarArray.Add(MakeShared<FJsonValueObject>(VarObj));
-    }
-    OutJson->SetArrayField(TEXT("variables"), VarArray);
-
-    TArray<TSharedPtr<FJsonValue>> GraphArray;
-    if (!GatherGraphs(Blueprint, GraphArray))
-    {
-        OutError = TEXT("Failed to traverse Blueprint graphs.");
-        return false;
-    }
-    OutJson->SetArrayField(TEXT("graphs"), GraphArray);
+    return BuildBlueprintJson(Blueprint, OutJson, OutError);
+}
 
-    TSharedPtr<FJsonObject> RefJson;
-    if (!GetReferences(BlueprintPath, RefJson, OutError))
+bool FMcpBlueprintInspector::BuildBlueprintJson(UBlueprint* Blueprint, TSharedRef<FJsonObject>& OutJson, FString& OutError, const FMcpExportOptions& Options)
+{
+    FMcpBlueprintJsonBuilder Builder(Blueprint, Options, OutJson);
+    Builder.Step(TNumericLimits<double>::Max());
+    if (!Builder.Succeeded())
     {
+        OutError = Builder.GetError();
         return false;
     }
-    OutJson->SetObjectField(TEXT("references"), RefJson);
-
     return true;
 }
 
 bool FMcpBlueprintInspector::ListBlueprints(const TArray<FString>& Roots, TArray<FString>& OutBlueprints, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Inspector::ListBlueprints");
+
     FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
     IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 
@@ -82,8 +72,37 @@ bool FMcpBlueprintInspector::ListBlueprints(const TArray<FString>& Roots, TArray
     return true;
 }
 
+bool FMcpBlueprintInspector::IsScratchObject(const UObject* Object)
+{
+    const UPackage* Package = Object ? Object->GetOutermost() : nullptr;
+    return Package
+        && (Package == GetTransientPackage() || Package->HasAnyPackageFlags(PKG_ForDiffing) || IsScratchPath(Package->GetName()));
+}
+
+bool FMcpBlueprintInspector::IsScratchPath(const FString& Path)
+{
+    return Path.StartsWith(TEXT("/Temp/")) || Path.StartsWith(TEXT("/Diff/")) || Path.StartsWith(TEXT("/Engine/Transient"));
+}
+
+FString FMcpBlueprintInspector::GetFunctionName(const UEdGraphNode* Node)
+{
+    if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+    {
+        return CallNode->FunctionReference.GetMemberName().ToString();
+    }
+    if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+    {
+        return EventNode->CustomFunctionName.IsNone()
+            ? EventNode->EventReference.GetMemberName().ToString()
+            : EventNode->CustomFunctionName.ToString();
+    }
+    return FString();
+}
+
 bool FMcpBlueprintInspector::GetReferences(const FString& BlueprintPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Inspector::GetReferences");
+
     FString PackageName;
     if (!FPackageName::TryConvertFilenameToLongPackageName(BlueprintPath, PackageName))
     {
@@ -120,65 +139,29 @@ bool FMcpBlueprintInspector::GetReferences(const FString& BlueprintPath, TShared
     return true;
 }
 
-bool FMcpBlueprintInspector::GatherGraphs(UBlueprint* Blueprint, TArray<TSharedPtr<FJsonValue>>& OutGraphs)
+void FMcpBlueprintInspector::SerializeNode(const UEdGraphNode* Node, const FMcpExportOptions& Options, TSharedRef<FJsonObject>& OutJson)
 {
-    if (!Blueprint)
-    {
-        return false;
-    }
-
-    auto SerializeGraph = [](UEdGraph* Graph, TArray<TSharedPtr<FJsonValue>>& TargetArray)
-    {
-        if (!Graph)
-        {
-            return;
-        }
-
-        TSharedRef<FJsonObject> GraphObj = MakeShared<FJsonObject>();
-        GraphObj->SetStringField(TEXT("name"), Graph->GetName());
-
-        TArray<TSharedPtr<FJsonValue>> NodeArray;
-        for (const UEdGraphNode* Node : Graph->Nodes)
-        {
-            if (!Node)
-            {
-                continue;
-            }
-
-            TSharedRef<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-            SerializeNode(Node, NodeObj);
-            NodeArray.Add(MakeShared<FJsonValueObject>(NodeObj));
-        }
+    MCP_TRACE_SCOPE("Mcp::Inspector::SerializeNode");
 
-        GraphObj->SetArrayField(TEXT("nodes"), NodeArray);
-        TargetArray.Add(MakeShared<FJsonValueObject>(GraphObj));
-    };
-
-    for (UEdGraph* Graph : Blueprint->UbergraphPages)
+    const FString NodeId = FString::Printf(TEXT("0x%p"), Node);
+    OutJson->SetStringField(TEXT("id"), NodeId);
+    OutJson->SetStringField(TEXT("guid"), Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+    OutJson->SetStringField(TEXT("class"), Node->GetClass()->GetName());
+    if (Options.bIncludeTitles)
     {
-        SerializeGraph(Graph, OutGraphs);
+        OutJson->SetStringField(TEXT("title"), FMcpNodeTitleCache::Get().GetTitle(Node));
     }
-
-    for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+    if (Options.bIncludeFullTitles)
     {
-        SerializeGraph(Graph, OutGraphs);
+        MCP_TRACE_SCOPE("Mcp::GetNodeTitle");
+        OutJson->SetStringField(TEXT("full_title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
     }
-
-    for (UEdGraph* Graph : Blueprint->DelegateSignatureGraphs)
+    if (Options.bIncludeTooltips)
     {
-        SerializeGraph(Graph, OutGraphs);
+        MCP_TRACE_SCOPE("Mcp::GetTooltipText");
+        OutJson->SetStringField(TEXT("tooltip"), Node->GetTooltipText().ToString());
     }
 
-    return true;
-}
-
-void FMcpBlueprintInspector::SerializeNode(const UEdGraphNode* Node, TSharedRef<FJsonObject>& OutJson)
-{
-    const FString NodeId = FString::Printf(TEXT("0x%p"), Node);
-    OutJson->SetStringField(TEXT("id"), NodeId);
-    OutJson->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-    OutJson->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
-
     TSharedRef<FJsonObject> PosObj = MakeShared<FJsonObject>();
     PosObj->SetNumberField(TEXT("x"), Node->NodePosX);
     PosObj->SetNumberField(TEXT("y"), Node->NodePosY);
@@ -196,6 +179,10 @@ void FMcpBlueprintInspector::SerializeNode(const UEdGraphNode* Node, TSharedRef<
         PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
         PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Output ? TEXT("out") : TEXT("in"));
         PinObj->SetStringField(TEXT("type"), DescribePinType(Pin->PinType));
+        if (!Pin->DefaultValue.IsEmpty())
+        {
+            PinObj->SetStringField(TEXT("default"), Pin->DefaultValue);
+        }
 
         TArray<TSharedPtr<FJsonValue>> LinkedArray;
         for (UEdGraphPin* Linked : Pin->LinkedTo)
@@ -207,6 +194,7 @@ void FMcpBlueprintInspector::SerializeNode(const UEdGraphNode* Node, TSharedRef<
 
             TSharedRef<FJsonObject> LinkObj = MakeShared<FJsonObject>();
             LinkObj->SetStringField(TEXT("node_id"), FString::Printf(TEXT("0x%p"), Linked->GetOwningNode()));
+            LinkObj->SetStringField(TEXT("node_guid"), Linked->GetOwningNode()->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
             LinkObj->SetStringField(TEXT("pin_name"), Linked->PinName.ToString());
             LinkedArray.Add(MakeShared<FJsonValueObject>(LinkObj));
         }
@@ -249,3 +237,150 @@ FString FMcpBlueprintInspector::DescribePinType(const FEdGraphPinType& PinType)
 
     return Result;
 }
+
+FMcpBlueprintJsonBuilder::FMcpBlueprintJsonBuilder(UBlueprint* InBlueprint, const FMcpExportOptions& InOptions, const TSharedRef<FJsonObject>& InJson)
+    : Blueprint(InBlueprint)
+    , Options(InOptions)
+    , Json(InJson)
+{
+}
+
+FMcpBlueprintJsonBuilder::~FMcpBlueprintJsonBuilder()
+{
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+}
+
+bool FMcpBlueprintJsonBuilder::Step(double Deadline)
+{
+    MCP_TRACE_SCOPE("Mcp::Inspector::BuildBlueprintJson");
+
+    if (bDone)
+    {
+        return true;
+    }
+
+    UBlueprint* BlueprintPtr = Blueprint.Get();
+    if (!BlueprintPtr)
+    {
+        Finish(TEXT("Blueprint was unloaded during export."));
+        return true;
+    }
+
+    if (bModified)
+    {
+        Restart();
+        if (++Restarts >= MaxRestarts)
+        {
+            Deadline = TNumericLimits<double>::Max();
+        }
+    }
+
+    if (!bStarted)
+    {
+        Json->SetStringField(TEXT("asset_name"), BlueprintPtr->GetName());
+        Json->SetStringField(TEXT("asset_path"), BlueprintPtr->GetPathName());
+
+        TArray<TSharedPtr<FJsonValue>> VarArray;
+        for (const FBPVariableDescription& Var : BlueprintPtr->NewVariables)
+        {
+            TSharedRef<FJsonObject> VarObj = MakeShared<FJsonObject>();
+            VarObj->SetStringField(TEXT("name"), Var.VarName.ToString());
+            VarObj->SetStringField(TEXT("type"), FMcpBlueprintInspector::DescribePinType(Var.VarType));
+            VarObj->SetBoolField(TEXT("is_array"), Var.VarType.IsArray());
+            VarObj->SetBoolField(TEXT("is_set"), Var.VarType.IsSet());
+            VarObj->SetBoolField(TEXT("is_map"), Var.VarType.IsMap());
+
+            VarArray.Add(MakeShared<FJsonValueObject>(VarObj));
+        }
+        Json->SetArrayField(TEXT("variables"), VarArray);
+
+        Graphs.Append(BlueprintPtr->UbergraphPages);
+        Graphs.Append(BlueprintPtr->FunctionGraphs);
+        Graphs.Append(BlueprintPtr->DelegateSignatureGraphs);
+        bStarted = true;
+    }
+
+    {
+        MCP_TRACE_SCOPE("Mcp::Inspector::GatherGraphs");
+        for (; GraphIndex < Graphs.Num(); ++GraphIndex, NodeIndex = 0)
+        {
+            const UEdGraph* Graph = Graphs[GraphIndex];
+            if (!Graph)
+            {
+                continue;
+            }
+
+            MCP_TRACE_SCOPE("Mcp::Inspector::SerializeGraph");
+            while (NodeIndex < Graph->Nodes.Num())
+            {
+                if (const UEdGraphNode* Node = Graph->Nodes[NodeIndex++])
+                {
+                    TSharedRef<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+                    FMcpBlueprintInspector::SerializeNode(Node, Options, NodeObj);
+                    NodeArray.Add(MakeShared<FJsonValueObject>(NodeObj));
+                }
+
+                if (FPlatformTime::Seconds() >= Deadline && (NodeIndex < Graph->Nodes.Num() || GraphIndex + 1 < Graphs.Num()))
+                {
+                    // Suspended: watch for edits so the next step does not mix old and new state.
+                    if (!ObjectModifiedHandle.IsValid())
+                    {
+                        ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMcpBlueprintJsonBuilder::OnObjectModified);
+                    }
+                    return false;
+                }
+            }
+
+            TSharedRef<FJsonObject> GraphObj = MakeShared<FJsonObject>();
+            GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+            GraphObj->SetArrayField(TEXT("nodes"), NodeArray);
+            GraphArray.Add(MakeShared<FJsonValueObject>(GraphObj));
+            NodeArray.Reset();
+        }
+    }
+    Json->SetArrayField(TEXT("graphs"), GraphArray);
+
+    TSharedPtr<FJsonObject> RefJson;
+    FString RefError;
+    if (!FMcpBlueprintInspector::GetReferences(BlueprintPtr->GetOutermost()->GetName(), RefJson, RefError))
+    {
+        Finish(RefError);
+        return true;
+    }
+    Json->SetObjectField(TEXT("references"), RefJson);
+
+    Finish();
+    return true;
+}
+
+void FMcpBlueprintJsonBuilder::Restart()
+{
+    Json->Values.Empty();
+    Graphs.Reset();
+    GraphArray.Reset();
+    NodeArray.Reset();
+    GraphIndex = 0;
+    NodeIndex = 0;
+    bStarted = false;
+    bModified = false;
+}
+
+void FMcpBlueprintJsonBuilder::Finish(const FString& InError)
+{
+    bDone = true;
+    Error = InError;
+    Graphs.Empty();
+    GraphArray.Empty();
+    NodeArray.Empty();
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    ObjectModifiedHandle.Reset();
+}
+
+void FMcpBlueprintJsonBuilder::OnObjectModified(UObject* Object)
+{
+    const UBlueprint* BlueprintPtr = Blueprint.Get();
+    if (Object && BlueprintPtr && Object->GetOutermost() == BlueprintPtr->GetOutermost())
+    {
+        bModified = true;
+    }
+}
@@ -1,7 +1,10 @@
 #include "BlueprintMCPServerModule.h"
 
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "BlueprintMcpServerUI.h"
+#include "McpNodeTitleCache.h"
 #include "McpServer.h"
+#include "McpServerSettings.h"
 #include "ToolMenus.h"
 #include "LevelEditor.h"
 #include "Widgets/Docking/SDockTab.h"
@@ -16,6 +19,12 @@ void FBlueprintMCPServerModule::StartupModule()
 {
     McpServer = MakeShared<FMcpServer>();
 
+    // The headless commandlet owns its own server and has no Slate.
+    if (IsRunningCommandlet())
+    {
+        return;
+    }
+
     FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
         BlueprintMcpTabName,
         FOnSpawnTab::CreateRaw(this, &FBlueprintMCPServerModule::SpawnMainTab))
@@ -23,16 +32,75 @@ void FBlueprintMCPServerModule::StartupModule()
         .SetMenuType(ETabSpawnerMenuType::Hidden);
 
     RegisterMenus();
+
+    const UMcpServerSettings* Settings = GetDefault<UMcpServerSettings>();
+    McpServer->SetWarmUpOnStart(Settings->bWarmUp);
+    if (Settings->bAutoStart)
+    {
+        // Binding before the initial scan would only serve incomplete asset lists.
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        if (AssetRegistry.IsLoadingAssets())
+        {
+            FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FBlueprintMCPServerModule::AutoStartServer);
+        }
+        else
+        {
+            AutoStartServer();
+        }
+    }
+}
+
+void FBlueprintMCPServerModule::AutoStartServer()
+{
+    if (FilesLoadedHandle.IsValid())
+    {
+        if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+        {
+            AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+        }
+        FilesLoadedHandle.Reset();
+    }
+
+    if (!McpServer.IsValid() || McpServer->IsRunning())
+    {
+        return;
+    }
+
+    const UMcpServerSettings* Settings = GetDefault<UMcpServerSettings>();
+    McpServer->SetAllowWrites(Settings->bAllowWrites);
+    McpServer->SetWebSocketPort((uint16)Settings->WebSocketPort);
+
+    FString Error;
+    if (!McpServer->Start((uint16)Settings->Port, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MCP] Auto-start failed: %s"), *Error);
+    }
 }
 
 void FBlueprintMCPServerModule::ShutdownModule()
 {
+    if (FilesLoadedHandle.IsValid())
+    {
+        if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+        {
+            AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+        }
+        FilesLoadedHandle.Reset();
+    }
+
     if (McpServer.IsValid())
     {
         McpServer->Stop();
         McpServer.Reset();
     }
 
+    FMcpNodeTitleCache::Shutdown();
+
+    if (IsRunningCommandlet())
+    {
+        return;
+    }
+
     UnregisterMenus();
     FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(BlueprintMcpTabName);
 }
@@ -0,0 +1,118 @@
+#include "BlueprintMcpServerCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadManager.h"
+#include "McpRequestRecorder.h"
+#include "McpServer.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace McpCommandlet
+{
+    static constexpr double GarbageCollectionInterval = 60.0;
+    static constexpr float IdleSleepSeconds = 0.001f;
+    static constexpr double ShutdownDrainSeconds = 0.2;
+}
+
+UBlueprintMcpServerCommandlet::UBlueprintMcpServerCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    ShowErrorCount = false;
+}
+
+int32 UBlueprintMcpServerCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamMap;
+    ParseCommandLine(*Params, Tokens, Switches, ParamMap);
+
+    int32 PortValue = 9000;
+    int32 WebSocketPortValue = 0;
+    FParse::Value(*Params, TEXT("port="), PortValue);
+    FParse::Value(*Params, TEXT("wsport="), WebSocketPortValue);
+    FString UnixSocketPath;
+    FParse::Value(*Params, TEXT("unixsocket="), UnixSocketPath);
+    FString CapturePath;
+    FParse::Value(*Params, TEXT("capture="), CapturePath);
+    const bool bAllowWrites = Switches.Contains(TEXT("allowwrites"));
+
+    if (PortValue <= 0 || PortValue > 65535 || WebSocketPortValue < 0 || WebSocketPortValue > 65535)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MCP] Invalid port."));
+        return 1;
+    }
+
+    const double BootStart = FPlatformTime::Seconds();
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/true);
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Asset registry ready in %.2fs."), FPlatformTime::Seconds() - BootStart);
+
+    TSharedRef<FMcpServer> Server = MakeShared<FMcpServer>();
+    Server->SetAllowWrites(bAllowWrites);
+    Server->SetAllowShutdown(true);
+    Server->SetWebSocketPort((uint16)WebSocketPortValue);
+    Server->SetUnixSocketPath(UnixSocketPath);
+
+    FString Error;
+    if (!Server->Start((uint16)PortValue, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MCP] %s"), *Error);
+        return 1;
+    }
+
+    if (!CapturePath.IsEmpty())
+    {
+        if (FMcpRequestRecorder::Get().Start(CapturePath, Error))
+        {
+            UE_LOG(LogTemp, Display, TEXT("[MCP] Capturing requests to %s"), *FMcpRequestRecorder::Get().GetPath());
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[MCP] %s"), *Error);
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Serving headless on port %d (writes %s). Send 'shutdown' or Ctrl+C to exit."),
+        PortValue, bAllowWrites ? TEXT("enabled") : TEXT("disabled"));
+
+    double LastTime = FPlatformTime::Seconds();
+    double LastGarbageCollection = LastTime;
+    while (!IsEngineExitRequested() && !Server->IsShutdownRequested())
+    {
+        const double Now = FPlatformTime::Seconds();
+        const float DeltaTime = (float)(Now - LastTime);
+        LastTime = Now;
+
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FTSTicker::GetCoreTicker().Tick(DeltaTime);
+        FThreadManager::Get().Tick();
+
+        if (Now - LastGarbageCollection > McpCommandlet::GarbageCollectionInterval)
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            LastGarbageCollection = Now;
+        }
+
+        FPlatformProcess::Sleep(McpCommandlet::IdleSleepSeconds);
+    }
+
+    // Let the shutdown response go out before the listeners close.
+    const double DrainEnd = FPlatformTime::Seconds() + McpCommandlet::ShutdownDrainSeconds;
+    while (FPlatformTime::Seconds() < DrainEnd)
+    {
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FTSTicker::GetCoreTicker().Tick(McpCommandlet::IdleSleepSeconds);
+        FPlatformProcess::Sleep(McpCommandlet::IdleSleepSeconds);
+    }
+
+    FMcpRequestRecorder::Get().Shutdown();
+    Server->Stop();
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Headless server exited."));
+    return 0;
+}
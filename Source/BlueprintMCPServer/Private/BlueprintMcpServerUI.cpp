@@ -1,28 +1,42 @@
 #include "BlueprintMcpServerUI.h"
 
 #include "BlueprintInspector.h"
+#include "McpAdmissionController.h"
 #include "McpServer.h"
+#include "McpServerSettings.h"
 #include "Async/Async.h"
 #include "Json.h"
+#include "Styling/AppStyle.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
-#include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SSpinBox.h"
 #include "Widgets/Layout/SUniformGridPanel.h"
 #include "Widgets/Text/STextBlock.h"
-#include "Framework/Text/TextLayout.h"
+#include "Widgets/Views/STableRow.h"
 
 #define LOCTEXT_NAMESPACE "BlueprintMcpServerUI"
 
+namespace McpPanel
+{
+    static constexpr int32 MinRetention = 100;
+    static constexpr int32 MaxRetention = 100000;
+    static constexpr int32 CollapseThreshold = 512;
+    static constexpr int32 SummaryLength = 160;
+}
+
 void SBlueprintMcpServerPanel::Construct(const FArguments& InArgs)
 {
     McpServerWeak = InArgs._McpServer;
 
     if (TSharedPtr<FMcpServer> Server = McpServerWeak.Pin())
     {
-        LogDelegateHandle = Server->OnLog.AddSP(this, &SBlueprintMcpServerPanel::OnServerLog);
+        Server->SetLogCaptureEnabled(true);
+        bAllowWrites = Server->GetAllowWrites();
     }
 
+    LogRing.SetNum(LogRetention);
+
     ChildSlot
     [
         SNew(SVerticalBox)
@@ -53,7 +67,24 @@ void SBlueprintMcpServerPanel::Construct(const FArguments& InArgs)
             .Padding(4,0)
             [
                 SAssignNew(PortTextBox, SEditableTextBox)
-                .Text(FText::FromString(TEXT("9000")))
+                .Text(FText::AsCultureInvariant(FString::FromInt(GetDefault<UMcpServerSettings>()->Port)))
+                .MinDesiredWidth(80.0f)
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(4,0)
+            [
+                SNew(STextBlock)
+                .Text(LOCTEXT("WebSocketPortLabel", "WebSocket port:"))
+                .ToolTipText(LOCTEXT("WebSocketPortTip", "Optional JSON-RPC WebSocket listener. Leave empty or 0 to disable."))
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(4,0)
+            [
+                SAssignNew(WebSocketPortTextBox, SEditableTextBox)
+                .HintText(LOCTEXT("WebSocketPortHint", "off"))
                 .MinDesiredWidth(80.0f)
             ]
             + SHorizontalBox::Slot()
@@ -73,6 +104,15 @@ void SBlueprintMcpServerPanel::Construct(const FArguments& InArgs)
             ]
         ]
 
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4)
+        [
+            SNew(STextBlock)
+            .Text_Lambda([this]() { return GetQueueText(); })
+            .Visibility_Lambda([this]() { return IsServerRunning() ? EVisibility::Visible : EVisibility::Collapsed; })
+        ]
+
         + SVerticalBox::Slot()
         .AutoHeight()
         .Padding(4)
@@ -126,13 +166,85 @@ void SBlueprintMcpServerPanel::Construct(const FArguments& InArgs)
             ]
         ]
 
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            [
+                SNew(SCheckBox)
+                .IsChecked_Lambda([this]() { return bShowInfo ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                .OnCheckStateChanged(this, &SBlueprintMcpServerPanel::OnToggleSeverity, EMcpLogSeverity::Info)
+                [
+                    SNew(STextBlock).Text(LOCTEXT("ShowInfo", "Info"))
+                ]
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(8,0)
+            [
+                SNew(SCheckBox)
+                .IsChecked_Lambda([this]() { return bShowWarnings ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                .OnCheckStateChanged(this, &SBlueprintMcpServerPanel::OnToggleSeverity, EMcpLogSeverity::Warning)
+                [
+                    SNew(STextBlock).Text(LOCTEXT("ShowWarnings", "Warnings"))
+                ]
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            [
+                SNew(SCheckBox)
+                .IsChecked_Lambda([this]() { return bShowErrors ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                .OnCheckStateChanged(this, &SBlueprintMcpServerPanel::OnToggleSeverity, EMcpLogSeverity::Error)
+                [
+                    SNew(STextBlock).Text(LOCTEXT("ShowErrors", "Errors"))
+                ]
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(16,0,4,0)
+            [
+                SNew(STextBlock)
+                .Text(LOCTEXT("Retention", "Keep last:"))
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SSpinBox<int32>)
+                .MinValue(McpPanel::MinRetention)
+                .MaxValue(McpPanel::MaxRetention)
+                .MinDesiredWidth(80.0f)
+                .Value_Lambda([this]() { return LogRetention; })
+                .OnValueCommitted_Lambda([this](int32 NewValue, ETextCommit::Type) { SetRetention(NewValue); })
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SNullWidget::NullWidget
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SButton)
+                .Text(LOCTEXT("ClearLog", "Clear"))
+                .OnClicked(this, &SBlueprintMcpServerPanel::OnClearLog)
+            ]
+        ]
+
         + SVerticalBox::Slot()
         .FillHeight(1.0f)
         .Padding(4)
         [
-            SAssignNew(LogTextBox, SMultiLineEditableTextBox)
-            .IsReadOnly(true)
-            .AutoWrapText(true)
+            SAssignNew(LogListView, SListView<TSharedPtr<FMcpLogItem>>)
+            .ListItemsSource(&VisibleLog)
+            .SelectionMode(ESelectionMode::None)
+            .OnGenerateRow(this, &SBlueprintMcpServerPanel::OnGenerateLogRow)
         ]
 
         + SVerticalBox::Slot()
@@ -150,30 +262,257 @@ SBlueprintMcpServerPanel::~SBlueprintMcpServerPanel()
 {
     if (TSharedPtr<FMcpServer> Server = McpServerWeak.Pin())
     {
-        Server->OnLog.Remove(LogDelegateHandle);
+        Server->SetLogCaptureEnabled(false);
+    }
+}
+
+void SBlueprintMcpServerPanel::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+    SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+    if (TSharedPtr<FMcpServer> Server = McpServerWeak.Pin())
+    {
+        DrainScratch.Reset();
+        Server->DrainLog(DrainScratch, LogRetention);
+        for (FMcpLogEntry& Entry : DrainScratch)
+        {
+            PushLogEntry(MoveTemp(Entry));
+        }
+    }
+
+    if (bLogNeedsRebuild)
+    {
+        RebuildVisibleLog();
+    }
+    else if (PendingVisible.Num() > 0 || NumEvictedVisible > 0)
+    {
+        AppendVisibleLog();
+    }
+}
+
+void SBlueprintMcpServerPanel::AppendLog(const FString& Message, EMcpLogSeverity Severity)
+{
+    FMcpLogEntry Entry;
+    Entry.Time = FDateTime::Now();
+    Entry.Severity = Severity;
+    Entry.Message = Message;
+    PushLogEntry(MoveTemp(Entry));
+}
+
+void SBlueprintMcpServerPanel::PushLogEntry(FMcpLogEntry&& Entry)
+{
+    TSharedPtr<FMcpLogItem> Item = MakeShared<FMcpLogItem>();
+    Item->Entry = MoveTemp(Entry);
+
+    const FString& Message = Item->Entry.Message;
+    int32 NewLine = INDEX_NONE;
+    Message.FindChar(TEXT('\n'), NewLine);
+    Item->bCollapsible = Message.Len() > McpPanel::CollapseThreshold || NewLine != INDEX_NONE;
+    if (Item->bCollapsible)
+    {
+        const int32 SummaryLen = FMath::Min(NewLine == INDEX_NONE ? Message.Len() : NewLine, McpPanel::SummaryLength);
+        Item->Summary = FString::Printf(TEXT("%s... (%.1f KB)"), *Message.Left(SummaryLen), Message.Len() / 1024.0);
+    }
+
+    // Entries leave the ring oldest first, so the visible ones it evicts are a prefix of VisibleLog
+    // (or of PendingVisible, when a burst overwrites entries that were never shown).
+    if (const TSharedPtr<FMcpLogItem>& Evicted = LogRing[LogHead])
+    {
+        if (PendingVisible.Num() > 0 && PendingVisible[0] == Evicted)
+        {
+            PendingVisible.RemoveAt(0);
+        }
+        else if (PassesFilter(*Evicted))
+        {
+            ++NumEvictedVisible;
+        }
+    }
+
+    if (PassesFilter(*Item))
+    {
+        PendingVisible.Add(Item);
+    }
+    LogRing[LogHead] = MoveTemp(Item);
+    LogHead = (LogHead + 1) % LogRing.Num();
+}
+
+void SBlueprintMcpServerPanel::RebuildVisibleLog()
+{
+    const bool bFollowTail = IsFollowingTail();
+
+    bLogNeedsRebuild = false;
+    PendingVisible.Reset();
+    NumEvictedVisible = 0;
+    VisibleLog.Reset();
+    for (int32 Offset = 0; Offset < LogRing.Num(); ++Offset)
+    {
+        const TSharedPtr<FMcpLogItem>& Item = LogRing[(LogHead + Offset) % LogRing.Num()];
+        if (Item.IsValid() && PassesFilter(*Item))
+        {
+            VisibleLog.Add(Item);
+        }
+    }
+
+    RefreshLogView(bFollowTail);
+}
+
+void SBlueprintMcpServerPanel::AppendVisibleLog()
+{
+    const bool bFollowTail = IsFollowingTail();
+
+    VisibleLog.RemoveAt(0, FMath::Min(NumEvictedVisible, VisibleLog.Num()), EAllowShrinking::No);
+    VisibleLog.Append(PendingVisible);
+    PendingVisible.Reset();
+    NumEvictedVisible = 0;
+
+    RefreshLogView(bFollowTail);
+}
+
+bool SBlueprintMcpServerPanel::IsFollowingTail() const
+{
+    return VisibleLog.Num() == 0 || !LogListView.IsValid() || LogListView->IsItemVisible(VisibleLog.Last());
+}
+
+void SBlueprintMcpServerPanel::RefreshLogView(bool bFollowTail)
+{
+    if (LogListView.IsValid())
+    {
+        LogListView->RequestListRefresh();
+        if (bFollowTail)
+        {
+            LogListView->ScrollToBottom();
+        }
+    }
+}
+
+void SBlueprintMcpServerPanel::SetRetention(int32 NewRetention)
+{
+    NewRetention = FMath::Clamp(NewRetention, McpPanel::MinRetention, McpPanel::MaxRetention);
+    if (NewRetention == LogRing.Num())
+    {
+        return;
+    }
+
+    TArray<TSharedPtr<FMcpLogItem>> Ordered;
+    Ordered.Reserve(LogRing.Num());
+    for (int32 Offset = 0; Offset < LogRing.Num(); ++Offset)
+    {
+        if (const TSharedPtr<FMcpLogItem>& Item = LogRing[(LogHead + Offset) % LogRing.Num()])
+        {
+            Ordered.Add(Item);
+        }
+    }
+
+    const int32 Keep = FMath::Min(Ordered.Num(), NewRetention);
+    LogRing.Reset();
+    LogRing.SetNum(NewRetention);
+    for (int32 Index = 0; Index < Keep; ++Index)
+    {
+        LogRing[Index] = Ordered[Ordered.Num() - Keep + Index];
+    }
+    LogHead = Keep % NewRetention;
+    LogRetention = NewRetention;
+    bLogNeedsRebuild = true;
+}
+
+bool SBlueprintMcpServerPanel::PassesFilter(const FMcpLogItem& Item) const
+{
+    switch (Item.Entry.Severity)
+    {
+    case EMcpLogSeverity::Error:
+        return bShowErrors;
+    case EMcpLogSeverity::Warning:
+        return bShowWarnings;
+    default:
+        return bShowInfo;
     }
 }
 
-void SBlueprintMcpServerPanel::OnServerLog(const FString& Message)
+void SBlueprintMcpServerPanel::OnToggleSeverity(ECheckBoxState State, EMcpLogSeverity Severity)
 {
-    AppendLog(Message);
+    const bool bChecked = State == ECheckBoxState::Checked;
+    switch (Severity)
+    {
+    case EMcpLogSeverity::Error:
+        bShowErrors = bChecked;
+        break;
+    case EMcpLogSeverity::Warning:
+        bShowWarnings = bChecked;
+        break;
+    default:
+        bShowInfo = bChecked;
+        break;
+    }
+    bLogNeedsRebuild = true;
 }
 
-void SBlueprintMcpServerPanel::AppendLog(const FString& Message)
+FReply SBlueprintMcpServerPanel::OnClearLog()
 {
-    LogLines.Add(Message);
-    const int32 MaxLines = 200;
-    if (LogLines.Num() > MaxLines)
+    for (TSharedPtr<FMcpLogItem>& Item : LogRing)
     {
-        LogLines.RemoveAt(0, LogLines.Num() - MaxLines);
+        Item.Reset();
     }
+    LogHead = 0;
+    bLogNeedsRebuild = true;
+    return FReply::Handled();
+}
 
-    if (LogTextBox.IsValid())
+TSharedRef<ITableRow> SBlueprintMcpServerPanel::OnGenerateLogRow(TSharedPtr<FMcpLogItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    FSlateColor Color = FSlateColor::UseForeground();
+    if (Item->Entry.Severity == EMcpLogSeverity::Error)
     {
-        FString Combined = FString::Join(LogLines, TEXT("\n"));
-        LogTextBox->SetText(FText::FromString(Combined));
-        LogTextBox->ScrollTo(FTextLocation(MAX_int32));
+        Color = FSlateColor(FLinearColor::Red);
     }
+    else if (Item->Entry.Severity == EMcpLogSeverity::Warning)
+    {
+        Color = FSlateColor(FLinearColor::Yellow);
+    }
+
+    TSharedRef<SHorizontalBox> Row = SNew(SHorizontalBox)
+        + SHorizontalBox::Slot()
+        .AutoWidth()
+        .Padding(0,0,8,0)
+        [
+            SNew(STextBlock)
+            .Text(FText::FromString(Item->Entry.Time.ToString(TEXT("%H:%M:%S.%s"))))
+            .ColorAndOpacity(FSlateColor::UseSubduedForeground())
+        ];
+
+    if (Item->bCollapsible)
+    {
+        Row->AddSlot()
+        .AutoWidth()
+        .VAlign(VAlign_Top)
+        .Padding(0,0,4,0)
+        [
+            SNew(SButton)
+            .ButtonStyle(FAppStyle::Get(), "SimpleButton")
+            .Text_Lambda([Item]() { return Item->bExpanded ? LOCTEXT("Collapse", "-") : LOCTEXT("Expand", "+"); })
+            .OnClicked_Lambda([Item]()
+            {
+                Item->bExpanded = !Item->bExpanded;
+                return FReply::Handled();
+            })
+        ];
+    }
+
+    Row->AddSlot()
+    .FillWidth(1.0f)
+    [
+        SNew(STextBlock)
+        .ColorAndOpacity(Color)
+        .AutoWrapText(true)
+        .Text_Lambda([Item, FullText = FText::FromString(Item->Entry.Message), SummaryText = FText::FromString(Item->Summary)]()
+        {
+            return Item->bCollapsible && !Item->bExpanded ? SummaryText : FullText;
+        })
+    ];
+
+    return SNew(STableRow<TSharedPtr<FMcpLogItem>>, OwnerTable)
+    [
+        Row
+    ];
 }
 
 FReply SBlueprintMcpServerPanel::OnToggleServer()
@@ -203,11 +542,18 @@ FReply SBlueprintMcpServerPanel::OnToggleServer()
         }
     }
 
+    uint16 WebSocketPortValue = 0;
+    if (WebSocketPortTextBox.IsValid())
+    {
+        WebSocketPortValue = (uint16)FCString::Atoi(*WebSocketPortTextBox->GetText().ToString());
+    }
+    Server->SetWebSocketPort(WebSocketPortValue);
+
     FString Error;
     if (!Server->Start(PortValue, Error))
     {
         LastError = Error;
-        AppendLog(Error);
+        AppendLog(Error, EMcpLogSeverity::Error);
         return FReply::Handled();
     }
 
@@ -238,7 +584,7 @@ FReply SBlueprintMcpServerPanel::OnExportJson()
     if (!FMcpBlueprintInspector::BuildBlueprintJson(Path, JsonObj, Error))
     {
         LastError = Error;
-        AppendLog(Error);
+        AppendLog(Error, EMcpLogSeverity::Error);
         return FReply::Handled();
     }
 
@@ -256,11 +602,41 @@ FText SBlueprintMcpServerPanel::GetStatusText() const
     TSharedPtr<FMcpServer> Server = McpServerWeak.Pin();
     if (Server.IsValid() && Server->IsRunning())
     {
+        if (Server->IsWarmingUp(FString()))
+        {
+            return FText::FromString(FString::Printf(TEXT("Running on 127.0.0.1:%d - %s"), Server->GetPort(), *Server->GetWarmupStatus()));
+        }
+        if (Server->GetWebSocketPort() != 0)
+        {
+            return FText::FromString(FString::Printf(TEXT("Running on 127.0.0.1:%d (WebSocket %d)"), Server->GetPort(), Server->GetWebSocketPort()));
+        }
         return FText::FromString(FString::Printf(TEXT("Running on 127.0.0.1:%d"), Server->GetPort()));
     }
     return LOCTEXT("Stopped", "Stopped");
 }
 
+FText SBlueprintMcpServerPanel::GetQueueText() const
+{
+    TSharedPtr<FMcpServer> Server = McpServerWeak.Pin();
+    if (!Server.IsValid())
+    {
+        return FText::GetEmpty();
+    }
+
+    const FMcpAdmissionController& Admission = Server->GetAdmission();
+    FString Text = TEXT("Queues:");
+    for (int32 Index = 0; Index < (int32)EMcpLane::Num; ++Index)
+    {
+        const FMcpLaneStats Stats = Admission.GetLaneStats((EMcpLane)Index);
+        Text += FString::Printf(TEXT("  %s %d running / %d queued"), FMcpAdmissionController::GetLaneName((EMcpLane)Index), Stats.Running, Stats.Queued);
+        if (Stats.Rejected > 0)
+        {
+            Text += FString::Printf(TEXT(" (%llu rejected)"), Stats.Rejected);
+        }
+    }
+    return FText::FromString(Text);
+}
+
 FText SBlueprintMcpServerPanel::GetErrorText() const
 {
     return LastError.IsEmpty() ? FText::GetEmpty() : FText::FromString(LastError);
@@ -20,9 +20,13 @@
 #include "KismetCompilerModule.h"
 #include "Engine/SimpleConstructionScript.h"
 #include "Engine/SCS_Node.h"
+#include "McpTrace.h"
+#include "ScopedTransaction.h"
 
 FMcpCreationResult FMcpBlueprintMutator::CreateBlueprint(const FString& PackagePath, UClass* ParentClass)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::CreateBlueprint");
+
     FMcpCreationResult Result;
     if (PackagePath.IsEmpty())
     {
@@ -66,6 +70,8 @@ FMcpCreationResult FMcpBlueprintMutator::CreateBlueprint(const FString& PackageP
 
 bool FMcpBlueprintMutator::AddVariable(UBlueprint* Blueprint, const FName& VarName, const FEdGraphPinType& PinType, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::AddVariable");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
@@ -85,12 +91,14 @@ bool FMcpBlueprintMutator::AddVariable(UBlueprint* Blueprint, const FName& VarNa
         return false;
     }
 
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    MarkStructurallyModified(Blueprint);
     return true;
 }
 
 bool FMcpBlueprintMutator::AddFunctionGraph(UBlueprint* Blueprint, const FName& FunctionName, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::AddFunctionGraph");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
@@ -117,12 +125,14 @@ bool FMcpBlueprintMutator::AddFunctionGraph(UBlueprint* Blueprint, const FName&
     }
 
     FBlueprintEditorUtils::AddFunctionGraph<UFunction>(Blueprint, NewGraph, /*bIsUserCreated=*/true, nullptr);
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    MarkStructurallyModified(Blueprint);
     return true;
 }
 
 bool FMcpBlueprintMutator::AddCallFunctionNode(UBlueprint* Blueprint, const FName& GraphName, UFunction* TargetFunction, const FVector2D& Position, FString& OutError, FGuid& OutNodeGuid)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::AddCallFunctionNode");
+
     if (!Blueprint || !TargetFunction)
     {
         OutError = TEXT("Blueprint or Function is null.");
@@ -147,12 +157,14 @@ bool FMcpBlueprintMutator::AddCallFunctionNode(UBlueprint* Blueprint, const FNam
     Graph->AddNode(Node, /*bFromUI=*/true, /*bSelectNewNode=*/false);
     OutNodeGuid = Node->NodeGuid;
 
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    MarkStructurallyModified(Blueprint);
     return true;
 }
 
 bool FMcpBlueprintMutator::AddEventNode(UBlueprint* Blueprint, const FName& GraphName, const FName& EventName, const FVector2D& Position, FString& OutError, FGuid& OutNodeGuid)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::AddEventNode");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
@@ -190,12 +202,14 @@ bool FMcpBlueprintMutator::AddEventNode(UBlueprint* Blueprint, const FName& Grap
     Graph->AddNode(Node, true, false);
     OutNodeGuid = Node->NodeGuid;
 
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    MarkStructurallyModified(Blueprint);
     return true;
 }
 
 bool FMcpBlueprintMutator::AddInputActionEvent(UBlueprint* Blueprint, const FName& GraphName, const FString& InputActionPath, const FName& TriggerEventName, const FVector2D& Position, FString& OutError, FGuid& OutNodeGuid)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::AddInputActionEvent");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
@@ -231,12 +245,14 @@ bool FMcpBlueprintMutator::AddInputActionEvent(UBlueprint* Blueprint, const FNam
     Graph->AddNode(Node, true, false);
     OutNodeGuid = Node->NodeGuid;
 
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    MarkStructurallyModified(Blueprint);
     return true;
 }
 
 bool FMcpBlueprintMutator::AddComponent(UBlueprint* Blueprint, UClass* ComponentClass, const FName& ComponentName, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::AddComponent");
+
     if (!Blueprint || !ComponentClass)
     {
         OutError = TEXT("Blueprint or ComponentClass is null.");
@@ -258,12 +274,14 @@ bool FMcpBlueprintMutator::AddComponent(UBlueprint* Blueprint, UClass* Component
     }
 
     SCS->AddNode(NewNode);
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    MarkStructurallyModified(Blueprint);
     return true;
 }
 
 bool FMcpBlueprintMutator::SetPinDefault(UBlueprint* Blueprint, const FName& GraphName, const FGuid& NodeGuid, const FString& PinName, const FString& LiteralValue, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::SetPinDefault");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
@@ -303,7 +321,7 @@ bool FMcpBlueprintMutator::SetPinDefault(UBlueprint* Blueprint, const FName& Gra
             }
             Pin->DefaultValue = LiteralValue;
             Pin->AutogeneratedDefaultValue = LiteralValue;
-            FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+            MarkStructurallyModified(Blueprint);
             return true;
         }
     }
@@ -314,6 +332,8 @@ bool FMcpBlueprintMutator::SetPinDefault(UBlueprint* Blueprint, const FName& Gra
 
 bool FMcpBlueprintMutator::ConnectPins(UBlueprint* Blueprint, const FName& GraphName, const FGuid& FromNode, const FString& FromPin, const FGuid& ToNode, const FString& ToPin, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::ConnectPins");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
@@ -381,19 +401,24 @@ bool FMcpBlueprintMutator::ConnectPins(UBlueprint* Blueprint, const FName& Graph
 
     FromPinPtr->MakeLinkTo(ToPinPtr);
 
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    MarkStructurallyModified(Blueprint);
     return true;
 }
 
 bool FMcpBlueprintMutator::Compile(UBlueprint* Blueprint, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::Compile");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
         return false;
     }
 
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    {
+        MCP_TRACE_SCOPE("Mcp::CompileBlueprint");
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    }
     if (Blueprint->Status == EBlueprintStatus::BS_Error)
     {
         OutError = TEXT("Compile failed.");
@@ -404,6 +429,8 @@ bool FMcpBlueprintMutator::Compile(UBlueprint* Blueprint, FString& OutError)
 
 bool FMcpBlueprintMutator::SaveBlueprint(UBlueprint* Blueprint, FString& OutError)
 {
+    MCP_TRACE_SCOPE("Mcp::Mutator::SaveBlueprint");
+
     if (!Blueprint)
     {
         OutError = TEXT("Blueprint is null.");
@@ -421,7 +448,12 @@ bool FMcpBlueprintMutator::SaveBlueprint(UBlueprint* Blueprint, FString& OutErro
     FSavePackageArgs SaveArgs;
     SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
     SaveArgs.Error = GError;
-    if (!UPackage::SavePackage(Package, Blueprint, *PackageFilename, SaveArgs))
+    bool bSaved = false;
+    {
+        MCP_TRACE_SCOPE("Mcp::SavePackage");
+        bSaved = UPackage::SavePackage(Package, Blueprint, *PackageFilename, SaveArgs);
+    }
+    if (!bSaved)
     {
         OutError = TEXT("Failed to save package.");
         return false;
@@ -430,6 +462,372 @@ bool FMcpBlueprintMutator::SaveBlueprint(UBlueprint* Blueprint, FString& OutErro
     return true;
 }
 
+bool FMcpBlueprintMutator::ApplyGraph(UBlueprint* Blueprint, const FName& GraphName, const FMcpGraphSpec& Spec, FMcpGraphApplyResult& OutResult, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Mutator::ApplyGraph");
+
+    if (!Blueprint)
+    {
+        OutError = TEXT("Blueprint is null.");
+        return false;
+    }
+
+    UEdGraph* Graph = FindGraph(Blueprint, GraphName);
+    if (!Graph)
+    {
+        OutError = TEXT("Graph not found.");
+        return false;
+    }
+
+    // Resolve every client id to the GUID its node has (or will have) before touching the graph.
+    TMap<FGuid, const FMcpGraphNodeSpec*> SpecsByGuid;
+    for (const FMcpGraphNodeSpec& NodeSpec : Spec.Nodes)
+    {
+        if (NodeSpec.Id.IsEmpty())
+        {
+            OutError = TEXT("Every node needs an 'id'.");
+            return false;
+        }
+
+        if (OutResult.NodeGuids.Contains(NodeSpec.Id))
+        {
+            OutError = FString::Printf(TEXT("Duplicate node id '%s'."), *NodeSpec.Id);
+            return false;
+        }
+
+        FGuid NodeGuid = NodeSpec.ExistingGuid;
+        if (NodeGuid.IsValid())
+        {
+            if (!FindNode(Graph, NodeGuid))
+            {
+                OutError = FString::Printf(TEXT("Node '%s' references a node that is not in the graph."), *NodeSpec.Id);
+                return false;
+            }
+        }
+        else if (NodeSpec.Function || !NodeSpec.EventName.IsNone())
+        {
+            NodeGuid = FGuid::NewDeterministicGuid(FString::Printf(TEXT("%s|%s|%s|%s"),
+                *Blueprint->GetPathName(), *GraphName.ToString(), *Spec.ClientId, *NodeSpec.Id));
+
+            // Events are unique per graph; adopt an existing one instead of creating a duplicate.
+            if (!NodeSpec.Function && !FindNode(Graph, NodeGuid))
+            {
+                for (UEdGraphNode* Node : Graph->Nodes)
+                {
+                    const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
+                    if (EventNode && EventNode->EventReference.GetMemberName() == NodeSpec.EventName)
+                    {
+                        NodeGuid = EventNode->NodeGuid;
+                        break;
+                    }
+                }
+            }
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Node '%s' needs 'node_guid', 'function_path' or 'event_name'."), *NodeSpec.Id);
+            return false;
+        }
+
+        if (SpecsByGuid.Contains(NodeGuid))
+        {
+            OutError = FString::Printf(TEXT("Node '%s' refers to the same node as another id."), *NodeSpec.Id);
+            return false;
+        }
+
+        OutResult.NodeGuids.Add(NodeSpec.Id, NodeGuid);
+        SpecsByGuid.Add(NodeGuid, &NodeSpec);
+    }
+
+    for (const FMcpGraphLinkSpec& Link : Spec.Links)
+    {
+        if (!OutResult.NodeGuids.Contains(Link.FromId) || !OutResult.NodeGuids.Contains(Link.ToId))
+        {
+            OutError = FString::Printf(TEXT("Link %s -> %s references an unknown node id."), *Link.FromId, *Link.ToId);
+            return false;
+        }
+    }
+
+    auto MatchesSpec = [](UEdGraphNode* Node, const FMcpGraphNodeSpec& NodeSpec)
+    {
+        if (NodeSpec.ExistingGuid.IsValid())
+        {
+            return true;
+        }
+        if (NodeSpec.Function)
+        {
+            const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
+            return CallNode && CallNode->GetTargetFunction() == NodeSpec.Function;
+        }
+        const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
+        return EventNode && EventNode->EventReference.GetMemberName() == NodeSpec.EventName;
+    };
+
+    // Plan without touching the graph: listed nodes that are missing, or whose kind no longer matches,
+    // get a replacement built with its pins but not yet added, so links and defaults can be checked
+    // against real pins. Nothing below the checks can fail on a missing pin or an incompatible link.
+    TArray<UEdGraphNode*> Removals;
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (!Node)
+        {
+            continue;
+        }
+
+        const FMcpGraphNodeSpec* const* NodeSpec = SpecsByGuid.Find(Node->NodeGuid);
+        if (NodeSpec ? !MatchesSpec(Node, **NodeSpec) : (Spec.bRemoveUnlisted && Node->CanUserDeleteNode()))
+        {
+            Removals.Add(Node);
+        }
+    }
+
+    TMap<FString, UEdGraphNode*> TargetNodes;
+    TArray<UEdGraphNode*> NewNodes;
+    for (const FMcpGraphNodeSpec& NodeSpec : Spec.Nodes)
+    {
+        const FGuid& NodeGuid = OutResult.NodeGuids.FindChecked(NodeSpec.Id);
+        UEdGraphNode* Node = FindNode(Graph, NodeGuid);
+        if (!Node || Removals.Contains(Node))
+        {
+            if (NodeSpec.Function)
+            {
+                UK2Node_CallFunction* CallNode = NewObject<UK2Node_CallFunction>(Graph);
+                CallNode->SetFromFunction(NodeSpec.Function);
+                Node = CallNode;
+            }
+            else
+            {
+                UK2Node_Event* EventNode = NewObject<UK2Node_Event>(Graph);
+                EventNode->EventReference.SetExternalMember(NodeSpec.EventName, Blueprint->GeneratedClass ? Blueprint->GeneratedClass : Blueprint->SkeletonGeneratedClass);
+                EventNode->CustomFunctionName = NodeSpec.EventName;
+                Node = EventNode;
+            }
+
+            Node->NodeGuid = NodeGuid;
+            Node->SetFlags(RF_Transactional);
+            Node->AllocateDefaultPins();
+            Node->NodePosX = (int32)NodeSpec.Position.X;
+            Node->NodePosY = (int32)NodeSpec.Position.Y;
+            NewNodes.Add(Node);
+        }
+        TargetNodes.Add(NodeSpec.Id, Node);
+    }
+
+    auto Fail = [&NewNodes, &OutResult]()
+    {
+        for (UEdGraphNode* Node : NewNodes)
+        {
+            Node->MarkAsGarbage();
+        }
+        OutResult.Edits.Reset();
+        return false;
+    };
+
+    // Resolve desired links to pins, normalised to output -> input, and check every default's pin and value.
+    const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+    TMap<FString, TPair<UEdGraphPin*, UEdGraphPin*>> DesiredLinks;
+    // Pins that hold a single link (data inputs, exec outputs), with the desired link that claims each.
+    TMap<const UEdGraphPin*, FString> SingleLinkPins;
+    auto MakeLinkKey = [](const UEdGraphPin* Output, const UEdGraphPin* Input)
+    {
+        return FString::Printf(TEXT("%s:%s->%s:%s"),
+            *Output->GetOwningNode()->NodeGuid.ToString(), *Output->PinName.ToString(),
+            *Input->GetOwningNode()->NodeGuid.ToString(), *Input->PinName.ToString());
+    };
+
+    for (const FMcpGraphLinkSpec& Link : Spec.Links)
+    {
+        UEdGraphPin* FromPin = FindPin(TargetNodes[Link.FromId], Link.FromPin);
+        UEdGraphPin* ToPin = FindPin(TargetNodes[Link.ToId], Link.ToPin);
+        if (!FromPin || !ToPin)
+        {
+            OutError = FString::Printf(TEXT("Pin not found for link %s.%s -> %s.%s."), *Link.FromId, *Link.FromPin, *Link.ToId, *Link.ToPin);
+            return Fail();
+        }
+
+        if (FromPin->Direction == EGPD_Input)
+        {
+            Swap(FromPin, ToPin);
+        }
+
+        const FPinConnectionResponse Response = Schema->CanCreateConnection(FromPin, ToPin);
+        if (Response.Response == CONNECT_RESPONSE_DISALLOW)
+        {
+            OutError = FString::Printf(TEXT("Cannot connect %s.%s -> %s.%s: %s"), *Link.FromId, *Link.FromPin, *Link.ToId, *Link.ToPin, *Response.Message.ToString());
+            return Fail();
+        }
+
+        const FString Key = MakeLinkKey(FromPin, ToPin);
+        if (DesiredLinks.Contains(Key))
+        {
+            continue;
+        }
+
+        const bool bSingleOutput = Response.Response == CONNECT_RESPONSE_BREAK_OTHERS_A || Response.Response == CONNECT_RESPONSE_BREAK_OTHERS_AB;
+        const bool bSingleInput = Response.Response == CONNECT_RESPONSE_BREAK_OTHERS_B || Response.Response == CONNECT_RESPONSE_BREAK_OTHERS_AB;
+        for (const UEdGraphPin* SinglePin : { bSingleOutput ? FromPin : nullptr, bSingleInput ? ToPin : nullptr })
+        {
+            if (!SinglePin)
+            {
+                continue;
+            }
+            if (const FString* Claimed = SingleLinkPins.Find(SinglePin))
+            {
+                OutError = FString::Printf(TEXT("Links %s and %s both use pin '%s', which takes a single link."), **Claimed, *Key, *SinglePin->PinName.ToString());
+                return Fail();
+            }
+            SingleLinkPins.Add(SinglePin, Key);
+        }
+        DesiredLinks.Add(Key, TPair<UEdGraphPin*, UEdGraphPin*>(FromPin, ToPin));
+    }
+
+    for (const FMcpGraphNodeSpec& NodeSpec : Spec.Nodes)
+    {
+        for (const TPair<FString, FString>& Default : NodeSpec.Defaults)
+        {
+            const UEdGraphPin* Pin = FindPin(TargetNodes[NodeSpec.Id], Default.Key);
+            if (!Pin)
+            {
+                OutError = FString::Printf(TEXT("Pin '%s' not found on node '%s'."), *Default.Key, *NodeSpec.Id);
+                return Fail();
+            }
+
+            FString DefaultValue;
+            TObjectPtr<UObject> DefaultObject = nullptr;
+            FText DefaultText;
+            Schema->GetPinDefaultValuesFromString(Pin->PinType, Pin->GetOwningNode(), Default.Value, DefaultValue, DefaultObject, DefaultText);
+            const FString DefaultError = Schema->IsPinDefaultValid(Pin, DefaultValue, DefaultObject, DefaultText);
+            if (!DefaultError.IsEmpty())
+            {
+                OutError = FString::Printf(TEXT("Default '%s' is not valid for pin '%s' on node '%s': %s"), *Default.Value, *Default.Key, *NodeSpec.Id, *DefaultError);
+                return Fail();
+            }
+        }
+    }
+
+    FScopedTransaction Transaction(NSLOCTEXT("BlueprintMCP", "ApplyGraph", "Apply Graph"));
+    Graph->Modify();
+
+    bool bChanged = false;
+    auto AddEdit = [&OutResult, &bChanged](const TCHAR* Op, const FString& Target, const FString& Detail)
+    {
+        OutResult.Edits.Add({ Op, Target, Detail });
+        bChanged = true;
+    };
+
+    // Removals: unlisted user-deletable nodes, and listed nodes whose kind no longer matches.
+    for (UEdGraphNode* Node : Removals)
+    {
+        const FMcpGraphNodeSpec* const* NodeSpec = SpecsByGuid.Find(Node->NodeGuid);
+        const FString Target = NodeSpec ? (*NodeSpec)->Id : Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens);
+        AddEdit(TEXT("remove_node"), Target, Node->GetClass()->GetName());
+        FBlueprintEditorUtils::RemoveNode(Blueprint, Node, /*bDontRecompile=*/true);
+    }
+
+    // Creations and moves.
+    for (const FMcpGraphNodeSpec& NodeSpec : Spec.Nodes)
+    {
+        UEdGraphNode* Node = TargetNodes[NodeSpec.Id];
+        if (NewNodes.Contains(Node))
+        {
+            Graph->AddNode(Node, /*bFromUI=*/true, /*bSelectNewNode=*/false);
+            AddEdit(TEXT("add_node"), NodeSpec.Id, NodeSpec.Function ? NodeSpec.Function->GetPathName() : NodeSpec.EventName.ToString());
+        }
+        else if (NodeSpec.bHasPosition && (Node->NodePosX != (int32)NodeSpec.Position.X || Node->NodePosY != (int32)NodeSpec.Position.Y))
+        {
+            Node->Modify();
+            Node->NodePosX = (int32)NodeSpec.Position.X;
+            Node->NodePosY = (int32)NodeSpec.Position.Y;
+            AddEdit(TEXT("move_node"), NodeSpec.Id, FString::Printf(TEXT("%d,%d"), Node->NodePosX, Node->NodePosY));
+        }
+    }
+
+    // Links between listed nodes that the spec does not mention are broken.
+    for (const TPair<FString, UEdGraphNode*>& Pair : TargetNodes)
+    {
+        for (UEdGraphPin* Pin : Pair.Value->Pins)
+        {
+            if (!Pin || Pin->Direction != EGPD_Output)
+            {
+                continue;
+            }
+
+            const TArray<UEdGraphPin*> Linked = Pin->LinkedTo;
+            for (UEdGraphPin* Other : Linked)
+            {
+                if (!Other || !SpecsByGuid.Contains(Other->GetOwningNode()->NodeGuid))
+                {
+                    continue;
+                }
+
+                const FString Key = MakeLinkKey(Pin, Other);
+                if (!DesiredLinks.Contains(Key))
+                {
+                    Pin->BreakLinkTo(Other);
+                    AddEdit(TEXT("unlink"), Key, FString());
+                }
+            }
+        }
+    }
+
+    for (const TPair<FString, TPair<UEdGraphPin*, UEdGraphPin*>>& Pair : DesiredLinks)
+    {
+        UEdGraphPin* Output = Pair.Value.Key;
+        UEdGraphPin* Input = Pair.Value.Value;
+        if (Output->LinkedTo.Contains(Input))
+        {
+            continue;
+        }
+
+        // CanCreateConnection passed above, so this only breaks links the new one replaces; those
+        // are reported too, since they may lead to nodes the spec does not list.
+        const TArray<UEdGraphPin*> OutputLinks = Output->LinkedTo;
+        const TArray<UEdGraphPin*> InputLinks = Input->LinkedTo;
+        Schema->TryCreateConnection(Output, Input);
+        AddEdit(TEXT("link"), Pair.Key, FString());
+
+        for (UEdGraphPin* Other : OutputLinks)
+        {
+            if (!Output->LinkedTo.Contains(Other))
+            {
+                AddEdit(TEXT("unlink"), MakeLinkKey(Output, Other), FString::Printf(TEXT("replaced by %s"), *Pair.Key));
+            }
+        }
+        for (UEdGraphPin* Other : InputLinks)
+        {
+            if (!Input->LinkedTo.Contains(Other))
+            {
+                AddEdit(TEXT("unlink"), MakeLinkKey(Other, Input), FString::Printf(TEXT("replaced by %s"), *Pair.Key));
+            }
+        }
+    }
+
+    for (const FMcpGraphNodeSpec& NodeSpec : Spec.Nodes)
+    {
+        for (const TPair<FString, FString>& Default : NodeSpec.Defaults)
+        {
+            UEdGraphPin* Pin = FindPin(TargetNodes[NodeSpec.Id], Default.Key);
+            if (Pin->LinkedTo.Num() > 0 || Pin->DefaultValue == Default.Value)
+            {
+                continue;
+            }
+
+            Schema->TrySetDefaultValue(*Pin, Default.Value);
+            AddEdit(TEXT("set_default"), FString::Printf(TEXT("%s.%s"), *NodeSpec.Id, *Default.Key), Default.Value);
+        }
+    }
+
+    if (bChanged)
+    {
+        MarkStructurallyModified(Blueprint);
+    }
+    else
+    {
+        Transaction.Cancel();
+    }
+    return true;
+}
+
 UEdGraph* FMcpBlueprintMutator::FindGraph(UBlueprint* Blueprint, const FName& GraphName)
 {
     if (!Blueprint)
@@ -463,3 +861,43 @@ UEdGraph* FMcpBlueprintMutator::FindGraph(UBlueprint* Blueprint, const FName& Gr
 
     return nullptr;
 }
+
+void FMcpBlueprintMutator::MarkStructurallyModified(UBlueprint* Blueprint)
+{
+    MCP_TRACE_SCOPE("Mcp::MarkBlueprintAsStructurallyModified");
+    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+}
+
+UEdGraphNode* FMcpBlueprintMutator::FindNode(UEdGraph* Graph, const FGuid& NodeGuid)
+{
+    if (!Graph)
+    {
+        return nullptr;
+    }
+
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (Node && Node->NodeGuid == NodeGuid)
+        {
+            return Node;
+        }
+    }
+    return nullptr;
+}
+
+UEdGraphPin* FMcpBlueprintMutator::FindPin(UEdGraphNode* Node, const FString& PinName)
+{
+    if (!Node)
+    {
+        return nullptr;
+    }
+
+    for (UEdGraphPin* Pin : Node->Pins)
+    {
+        if (Pin && Pin->PinName.ToString() == PinName)
+        {
+            return Pin;
+        }
+    }
+    return nullptr;
+}
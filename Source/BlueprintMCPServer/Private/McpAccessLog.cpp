@@ -0,0 +1,279 @@
+#include "McpAccessLog.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Json.h"
+#include "McpTrace.h"
+#include "Misc/Paths.h"
+
+namespace McpAccessLog
+{
+    static constexpr int32 MaxPendingRecords = 65536;
+    static constexpr uint32 FlushIntervalMs = 500;
+    static const TCHAR* BaseName = TEXT("access");
+
+    static float ReadSampleRate = 1.0f;
+    static FAutoConsoleVariableRef CVarReadSampleRate(
+        TEXT("Mcp.AccessLog.ReadSampleRate"),
+        ReadSampleRate,
+        TEXT("Fraction (0-1) of successful read requests written to the MCP access log. Errors and writes are always logged."));
+
+    static int32 MaxFileSizeMB = 64;
+    static FAutoConsoleVariableRef CVarMaxFileSizeMB(
+        TEXT("Mcp.AccessLog.MaxFileSizeMB"),
+        MaxFileSizeMB,
+        TEXT("Size at which the MCP access log is rotated."));
+
+    static int32 MaxFiles = 5;
+    static FAutoConsoleVariableRef CVarMaxFiles(
+        TEXT("Mcp.AccessLog.MaxFiles"),
+        MaxFiles,
+        TEXT("Number of rotated MCP access log files to keep."));
+
+    static FString GetRotatedPath(const FString& Directory, int32 Index)
+    {
+        return Index == 0
+            ? Directory / FString::Printf(TEXT("%s.jsonl"), BaseName)
+            : Directory / FString::Printf(TEXT("%s.%d.jsonl"), BaseName, Index);
+    }
+
+    static double ToMs(double Seconds)
+    {
+        return FMath::RoundToDouble(Seconds * 1000000.0) / 1000.0;
+    }
+}
+
+FMcpAccessLog::FMcpAccessLog()
+    : Directory(FPaths::ProjectLogDir() / TEXT("BlueprintMCP"))
+{
+    FilePath = McpAccessLog::GetRotatedPath(Directory, 0);
+}
+
+FMcpAccessLog::~FMcpAccessLog()
+{
+    Shutdown();
+}
+
+bool FMcpAccessLog::Start(FString& OutError)
+{
+    if (Thread)
+    {
+        return true;
+    }
+
+    IFileManager::Get().MakeDirectory(*Directory, /*Tree=*/true);
+    if (!OpenFile())
+    {
+        OutError = FString::Printf(TEXT("Failed to open access log '%s'."), *FilePath);
+        return false;
+    }
+
+    bStopping = false;
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("McpAccessLogWriter"), 0, TPri_BelowNormal);
+    if (!Thread)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+        FileHandle.Reset();
+        OutError = TEXT("Failed to create access log writer thread.");
+        return false;
+    }
+
+    bAccepting = true;
+    return true;
+}
+
+void FMcpAccessLog::Shutdown()
+{
+    bAccepting = false;
+
+    if (Thread)
+    {
+        // Kill calls Stop() and waits for Run() to drain what is left.
+        Thread->Kill(/*bShouldWait=*/true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    FileHandle.Reset();
+}
+
+int32 FMcpAccessLog::ShouldRecord(bool bReadAction, bool bSuccess)
+{
+    if (!bAccepting.load(std::memory_order_relaxed))
+    {
+        return 0;
+    }
+
+    if (!bReadAction || !bSuccess || McpAccessLog::ReadSampleRate >= 1.0f)
+    {
+        return 1;
+    }
+
+    if (McpAccessLog::ReadSampleRate <= 0.0f)
+    {
+        return 0;
+    }
+
+    const int32 Interval = FMath::Max(1, FMath::RoundToInt(1.0f / McpAccessLog::ReadSampleRate));
+    return ReadCounter.fetch_add(1, std::memory_order_relaxed) % Interval == 0 ? Interval : 0;
+}
+
+void FMcpAccessLog::Record(FMcpAccessRecord&& AccessRecord)
+{
+    if (!bAccepting.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    if (PendingCount.fetch_add(1, std::memory_order_relaxed) >= McpAccessLog::MaxPendingRecords)
+    {
+        PendingCount.fetch_sub(1, std::memory_order_relaxed);
+        DroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Pending.Enqueue(MoveTemp(AccessRecord));
+}
+
+void FMcpAccessLog::Stop()
+{
+    bStopping = true;
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+uint32 FMcpAccessLog::Run()
+{
+    while (!bStopping)
+    {
+        WakeEvent->Wait(McpAccessLog::FlushIntervalMs);
+        WritePending();
+    }
+
+    WritePending();
+    return 0;
+}
+
+void FMcpAccessLog::WritePending()
+{
+    MCP_TRACE_SCOPE("Mcp::AccessLog::Write");
+
+    const int32 Dropped = DroppedCount.exchange(0, std::memory_order_relaxed);
+    if (Dropped > 0)
+    {
+        WriteRaw(FString::Printf(TEXT("{\"ts\":\"%s\",\"dropped\":%d}"), *FDateTime::UtcNow().ToIso8601(), Dropped));
+    }
+
+    int32 NumWritten = 0;
+    FMcpAccessRecord AccessRecord;
+    while (Pending.Dequeue(AccessRecord))
+    {
+        WriteRaw(FormatRecord(AccessRecord));
+        ++NumWritten;
+    }
+    PendingCount.fetch_sub(NumWritten, std::memory_order_relaxed);
+
+    if (FileHandle && (NumWritten > 0 || Dropped > 0))
+    {
+        FileHandle->Flush();
+    }
+}
+
+void FMcpAccessLog::WriteRaw(const FString& Line)
+{
+    RotateIfNeeded();
+    if (!FileHandle)
+    {
+        return;
+    }
+
+    const FTCHARToUTF8 Utf8(*(Line + TEXT("\n")));
+    FileHandle->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    FileSize += Utf8.Length();
+}
+
+bool FMcpAccessLog::OpenFile()
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    FileHandle.Reset(PlatformFile.OpenWrite(*FilePath, /*bAppend=*/true, /*bAllowRead=*/true));
+    FileSize = FileHandle ? FileHandle->Size() : 0;
+    return FileHandle.IsValid();
+}
+
+void FMcpAccessLog::RotateIfNeeded()
+{
+    if (FileHandle && FileSize < (int64)McpAccessLog::MaxFileSizeMB * 1024 * 1024)
+    {
+        return;
+    }
+
+    FileHandle.Reset();
+
+    IFileManager& FileManager = IFileManager::Get();
+    const int32 KeepFiles = FMath::Max(1, McpAccessLog::MaxFiles);
+    FileManager.Delete(*McpAccessLog::GetRotatedPath(Directory, KeepFiles - 1), false, false, true);
+    for (int32 Index = KeepFiles - 2; Index >= 0; --Index)
+    {
+        const FString From = McpAccessLog::GetRotatedPath(Directory, Index);
+        if (FileManager.FileExists(*From))
+        {
+            FileManager.Move(*McpAccessLog::GetRotatedPath(Directory, Index + 1), *From, /*Replace=*/true);
+        }
+    }
+
+    OpenFile();
+}
+
+FString FMcpAccessLog::FormatRecord(const FMcpAccessRecord& AccessRecord)
+{
+    const FMcpRequestTiming& Timing = AccessRecord.Timing;
+
+    FString Line;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("ts"), AccessRecord.Timestamp.ToIso8601());
+    Writer->WriteValue(TEXT("transport"), AccessRecord.Transport);
+    Writer->WriteValue(TEXT("client"), AccessRecord.Client);
+    Writer->WriteValue(TEXT("action"), AccessRecord.Action);
+    if (!AccessRecord.AssetPath.IsEmpty())
+    {
+        Writer->WriteValue(TEXT("asset_path"), AccessRecord.AssetPath);
+    }
+    Writer->WriteValue(TEXT("status"), AccessRecord.bSuccess ? TEXT("ok") : TEXT("error"));
+    if (!AccessRecord.bSuccess)
+    {
+        Writer->WriteValue(TEXT("error"), AccessRecord.Error);
+    }
+    if (AccessRecord.SampleInterval > 1)
+    {
+        Writer->WriteValue(TEXT("sample_interval"), AccessRecord.SampleInterval);
+    }
+
+    Writer->WriteObjectStart(TEXT("latency_ms"));
+    Writer->WriteValue(TEXT("queue_wait"), McpAccessLog::ToMs(Timing.QueueWaitSeconds));
+    Writer->WriteValue(TEXT("game_thread"), McpAccessLog::ToMs(Timing.GameThreadSeconds));
+    Writer->WriteValue(TEXT("serialization"), McpAccessLog::ToMs(Timing.SerializationSeconds));
+    Writer->WriteValue(TEXT("total"), McpAccessLog::ToMs(Timing.TotalSeconds));
+    Writer->WriteObjectEnd();
+
+    Writer->WriteValue(TEXT("request_bytes"), Timing.RequestBytes);
+    Writer->WriteValue(TEXT("response_bytes"), Timing.ResponseBytes);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return Line;
+}
@@ -0,0 +1,214 @@
+#include "McpAdmissionController.h"
+
+#include "Async/Async.h"
+#include "Json.h"
+#include "McpTrace.h"
+
+namespace McpAdmission
+{
+    // Weight of the newest sample in the per-lane latency average used for Retry-After.
+    static constexpr double LatencySmoothing = 0.2;
+}
+
+FMcpAdmissionController::FMcpAdmissionController()
+{
+    Lanes[(int32)EMcpLane::CheapRead].Config = { 4, 256 };
+    Lanes[(int32)EMcpLane::HeavyRead].Config = { 2, 32 };
+    Lanes[(int32)EMcpLane::Write].Config = { 1, 16 };
+}
+
+EMcpLane FMcpAdmissionController::Classify(const FString& Action)
+{
+    if (Action == TEXT("list_blueprints")
+        || Action == TEXT("get_references")
+        || Action == TEXT("get_server_stats")
+        || Action == TEXT("list_templates")
+        || Action == TEXT("get_export_status")
+        || Action == TEXT("get_refactor_status")
+        || Action == TEXT("shutdown"))
+    {
+        return EMcpLane::CheapRead;
+    }
+
+    if (Action == TEXT("get_blueprint_structure")
+        || Action == TEXT("resolve_symbols")
+        || Action == TEXT("impact_analysis")
+        || Action == TEXT("diff_blueprints")
+        || Action == TEXT("query_graph")
+        || Action == TEXT("get_graph_topology"))
+    {
+        return EMcpLane::HeavyRead;
+    }
+
+    return EMcpLane::Write;
+}
+
+const TCHAR* FMcpAdmissionController::GetLaneName(EMcpLane Lane)
+{
+    switch (Lane)
+    {
+    case EMcpLane::CheapRead: return TEXT("cheap_read");
+    case EMcpLane::HeavyRead: return TEXT("heavy_read");
+    case EMcpLane::Write: return TEXT("write");
+    default: return TEXT("unknown");
+    }
+}
+
+bool FMcpAdmissionController::Submit(EMcpLane LaneIndex, const FString& Client, TFunction<void()>&& Run, TFunction<void()>&& Cancel, int32& OutRetryAfterSeconds)
+{
+    {
+        FScopeLock Lock(&Mutex);
+        FLane& Lane = Lanes[(int32)LaneIndex];
+        if (Lane.Queued >= Lane.Config.MaxQueued)
+        {
+            ++Lane.Rejected;
+            const double Drain = (Lane.Queued / (double)FMath::Max(1, Lane.Config.MaxConcurrent)) * FMath::Max(Lane.AverageSeconds, 0.01);
+            OutRetryAfterSeconds = FMath::Clamp(FMath::CeilToInt(Drain), 1, 60);
+            return false;
+        }
+
+        TArray<FWorkItem>* ClientQueue = Lane.PerClient.Find(Client);
+        if (!ClientQueue)
+        {
+            Lane.Clients.Add(Client);
+            ClientQueue = &Lane.PerClient.Add(Client);
+        }
+        ClientQueue->Add({ MoveTemp(Run), MoveTemp(Cancel) });
+        ++Lane.Queued;
+    }
+
+    Pump(LaneIndex);
+    return true;
+}
+
+void FMcpAdmissionController::CancelQueued()
+{
+    TArray<FWorkItem> Cancelled;
+    {
+        FScopeLock Lock(&Mutex);
+        for (FLane& Lane : Lanes)
+        {
+            for (TPair<FString, TArray<FWorkItem>>& Pair : Lane.PerClient)
+            {
+                Cancelled.Append(MoveTemp(Pair.Value));
+            }
+            Lane.PerClient.Reset();
+            Lane.Clients.Reset();
+            Lane.NextClient = 0;
+            Lane.Queued = 0;
+        }
+    }
+
+    for (FWorkItem& Item : Cancelled)
+    {
+        if (Item.Cancel)
+        {
+            Item.Cancel();
+        }
+    }
+}
+
+bool FMcpAdmissionController::PopNext(FLane& Lane, FWorkItem& OutItem)
+{
+    while (Lane.Clients.Num() > 0)
+    {
+        Lane.NextClient %= Lane.Clients.Num();
+        const FString Client = Lane.Clients[Lane.NextClient];
+        TArray<FWorkItem>& ClientQueue = Lane.PerClient.FindChecked(Client);
+        if (ClientQueue.Num() == 0)
+        {
+            Lane.PerClient.Remove(Client);
+            Lane.Clients.RemoveAt(Lane.NextClient);
+            continue;
+        }
+
+        OutItem = MoveTemp(ClientQueue[0]);
+        ClientQueue.RemoveAt(0);
+        if (ClientQueue.Num() == 0)
+        {
+            Lane.PerClient.Remove(Client);
+            Lane.Clients.RemoveAt(Lane.NextClient);
+        }
+        else
+        {
+            ++Lane.NextClient;
+        }
+
+        --Lane.Queued;
+        return true;
+    }
+    return false;
+}
+
+void FMcpAdmissionController::Pump(EMcpLane LaneIndex)
+{
+    TArray<FWorkItem> ToRun;
+    {
+        FScopeLock Lock(&Mutex);
+        FLane& Lane = Lanes[(int32)LaneIndex];
+        FWorkItem Item;
+        while (Lane.Running < Lane.Config.MaxConcurrent && PopNext(Lane, Item))
+        {
+            ++Lane.Running;
+            ToRun.Add(MoveTemp(Item));
+        }
+    }
+
+    TSharedRef<FMcpAdmissionController, ESPMode::ThreadSafe> Self = AsShared();
+    for (FWorkItem& Item : ToRun)
+    {
+        Async(EAsyncExecution::ThreadPool, [Self, LaneIndex, Run = MoveTemp(Item.Run)]()
+        {
+            MCP_TRACE_SCOPE("Mcp::Admission::Run");
+            const double Start = FPlatformTime::Seconds();
+            Run();
+            Self->OnFinished(LaneIndex, FPlatformTime::Seconds() - Start);
+        });
+    }
+}
+
+void FMcpAdmissionController::OnFinished(EMcpLane LaneIndex, double Seconds)
+{
+    {
+        FScopeLock Lock(&Mutex);
+        FLane& Lane = Lanes[(int32)LaneIndex];
+        --Lane.Running;
+        ++Lane.Completed;
+        Lane.AverageSeconds = Lane.Completed == 1
+            ? Seconds
+            : FMath::Lerp(Lane.AverageSeconds, Seconds, McpAdmission::LatencySmoothing);
+    }
+
+    Pump(LaneIndex);
+}
+
+FMcpLaneStats FMcpAdmissionController::GetLaneStats(EMcpLane LaneIndex) const
+{
+    FScopeLock Lock(&Mutex);
+    const FLane& Lane = Lanes[(int32)LaneIndex];
+
+    FMcpLaneStats Stats;
+    Stats.Running = Lane.Running;
+    Stats.Queued = Lane.Queued;
+    Stats.Completed = Lane.Completed;
+    Stats.Rejected = Lane.Rejected;
+    return Stats;
+}
+
+TSharedRef<FJsonObject> FMcpAdmissionController::BuildStatsJson() const
+{
+    TSharedRef<FJsonObject> LanesObj = MakeShared<FJsonObject>();
+    for (int32 Index = 0; Index < (int32)EMcpLane::Num; ++Index)
+    {
+        const FMcpLaneStats Stats = GetLaneStats((EMcpLane)Index);
+        TSharedRef<FJsonObject> LaneObj = MakeShared<FJsonObject>();
+        LaneObj->SetNumberField(TEXT("running"), Stats.Running);
+        LaneObj->SetNumberField(TEXT("queued"), Stats.Queued);
+        LaneObj->SetNumberField(TEXT("max_concurrent"), Lanes[Index].Config.MaxConcurrent);
+        LaneObj->SetNumberField(TEXT("max_queued"), Lanes[Index].Config.MaxQueued);
+        LaneObj->SetNumberField(TEXT("completed"), (double)Stats.Completed);
+        LaneObj->SetNumberField(TEXT("rejected"), (double)Stats.Rejected);
+        LanesObj->SetObjectField(GetLaneName((EMcpLane)Index), LaneObj);
+    }
+    return LanesObj;
+}
@@ -0,0 +1,510 @@
+#include "McpBenchmark.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintInspector.h"
+#include "BlueprintMutator.h"
+#include "Components/SceneComponent.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "GameFramework/Actor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "Json.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "McpServer.h"
+#include "McpServerMetrics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace McpBenchmark
+{
+    static const TCHAR* PackageRoot = TEXT("/Temp/McpBenchmark");
+
+    static UFunction* GetBenchFunction()
+    {
+        return UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt));
+    }
+
+    static FName GetGraphName(int32 GraphIndex)
+    {
+        return FName(*FString::Printf(TEXT("BenchGraph_%d"), GraphIndex));
+    }
+
+    static void GetGraphNodeGuids(UBlueprint* Blueprint, const FName& GraphName, TArray<FGuid>& OutGuids)
+    {
+        for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+        {
+            if (Graph && Graph->GetFName() == GraphName)
+            {
+                for (UEdGraphNode* Node : Graph->Nodes)
+                {
+                    if (Cast<UK2Node_CallFunction>(Node))
+                    {
+                        OutGuids.Add(Node->NodeGuid);
+                    }
+                }
+            }
+        }
+    }
+
+    // New Actor Blueprints come with ghost event nodes, and AddEventNode returns an existing node as is.
+    static void RemoveEventNodes(UBlueprint* Blueprint, UEdGraph* Graph, const FName& EventName)
+    {
+        TArray<UEdGraphNode*> Matches;
+        for (UEdGraphNode* Node : Graph->Nodes)
+        {
+            const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
+            if (EventNode && EventNode->EventReference.GetMemberName() == EventName)
+            {
+                Matches.Add(Node);
+            }
+        }
+
+        for (UEdGraphNode* Node : Matches)
+        {
+            FBlueprintEditorUtils::RemoveNode(Blueprint, Node, /*bDontRecompile=*/true);
+        }
+    }
+
+    static void BreakLink(UBlueprint* Blueprint, const FName& GraphName, const FGuid& FromNode, const FString& FromPin, const FGuid& ToNode, const FString& ToPin)
+    {
+        UEdGraph* Graph = FMcpBlueprintMutator::FindGraph(Blueprint, GraphName);
+        UEdGraphPin* From = Graph ? FMcpBlueprintMutator::FindPin(FMcpBlueprintMutator::FindNode(Graph, FromNode), FromPin) : nullptr;
+        UEdGraphPin* To = Graph ? FMcpBlueprintMutator::FindPin(FMcpBlueprintMutator::FindNode(Graph, ToNode), ToPin) : nullptr;
+        if (From && To)
+        {
+            From->BreakLinkTo(To);
+        }
+    }
+
+    static void RunFromConsole(const TArray<FString>& Args)
+    {
+        FMcpBenchmarkConfig Config;
+        for (const FString& Arg : Args)
+        {
+            FParse::Value(*Arg, TEXT("graphs="), Config.NumGraphs);
+            FParse::Value(*Arg, TEXT("nodes="), Config.NodesPerGraph);
+            FParse::Value(*Arg, TEXT("links="), Config.LinksPerNode);
+            FParse::Value(*Arg, TEXT("iterations="), Config.Iterations);
+            FParse::Value(*Arg, TEXT("threshold="), Config.RegressionThreshold);
+            FParse::Value(*Arg, TEXT("out="), Config.OutputCsv);
+            FParse::Value(*Arg, TEXT("baseline="), Config.BaselineCsv);
+        }
+
+        if (Config.OutputCsv.IsEmpty())
+        {
+            Config.OutputCsv = FPaths::ProjectSavedDir() / TEXT("BlueprintMCP/Benchmarks") / FString::Printf(TEXT("bench-%s.csv"), *FDateTime::Now().ToString());
+        }
+
+        TArray<FMcpBenchmarkResult> Results;
+        FString Error;
+        if (!FMcpBenchmark::Run(Config, Results, Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[MCP] Benchmark failed: %s"), *Error);
+            return;
+        }
+
+        for (const FMcpBenchmarkResult& Result : Results)
+        {
+            if (Result.bFailed)
+            {
+                UE_LOG(LogTemp, Error, TEXT("[MCP] %-40s FAILED: %s"), *Result.Case, *Result.Error);
+                continue;
+            }
+            UE_LOG(LogTemp, Display, TEXT("[MCP] %-40s median %8.3f ms  p99 %8.3f ms  allocs %8.1f"), *Result.Case, Result.MedianMs, Result.P99Ms, Result.MeanAllocs);
+        }
+
+        if (!FMcpBenchmark::WriteCsv(Config, Results, Config.OutputCsv, Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[MCP] %s"), *Error);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Display, TEXT("[MCP] Benchmark results written to %s"), *Config.OutputCsv);
+        }
+
+        if (!Config.BaselineCsv.IsEmpty())
+        {
+            TArray<FString> Regressions;
+            if (!FMcpBenchmark::CompareWithBaseline(Config, Results, Regressions, Error))
+            {
+                UE_LOG(LogTemp, Error, TEXT("[MCP] %s"), *Error);
+            }
+            else if (Regressions.Num() > 0)
+            {
+                for (const FString& Regression : Regressions)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("[MCP] Regression: %s"), *Regression);
+                }
+            }
+            else
+            {
+                UE_LOG(LogTemp, Display, TEXT("[MCP] No regressions against %s"), *Config.BaselineCsv);
+            }
+        }
+    }
+
+    static FAutoConsoleCommand BenchmarkCommand(
+        TEXT("Mcp.Benchmark"),
+        TEXT("Runs the Blueprint MCP benchmark suite. Args: graphs=N nodes=M links=K iterations=I out=<csv> baseline=<csv> threshold=0.1"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunFromConsole));
+}
+
+bool FMcpBenchmark::Run(const FMcpBenchmarkConfig& Config, TArray<FMcpBenchmarkResult>& OutResults, FString& OutError)
+{
+    check(IsInGameThread());
+
+    UBlueprint* Blueprint = GenerateSyntheticBlueprint(Config, OutError);
+    if (!Blueprint)
+    {
+        return false;
+    }
+
+    const FString AssetPath = Blueprint->GetPathName();
+    const int32 Iterations = FMath::Max(1, Config.Iterations);
+    const FName FirstGraph = McpBenchmark::GetGraphName(0);
+
+    TArray<FGuid> NodeGuids;
+    McpBenchmark::GetGraphNodeGuids(Blueprint, FirstGraph, NodeGuids);
+
+    OutResults.Add(Measure(TEXT("inspector.build_blueprint_json"), Iterations, [&](int32, FString& Error)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        return FMcpBlueprintInspector::BuildBlueprintJson(AssetPath, Json, Error);
+    }));
+
+    OutResults.Add(Measure(TEXT("inspector.list_blueprints"), Iterations, [&](int32, FString& Error)
+    {
+        TArray<FString> Blueprints;
+        return FMcpBlueprintInspector::ListBlueprints({ McpBenchmark::PackageRoot }, Blueprints, Error);
+    }));
+
+    OutResults.Add(Measure(TEXT("inspector.get_references"), Iterations, [&](int32, FString& Error)
+    {
+        TSharedPtr<FJsonObject> Json;
+        return FMcpBlueprintInspector::GetReferences(AssetPath, Json, Error);
+    }));
+
+    TSharedRef<FMcpServer> Server = MakeShared<FMcpServer>();
+    Server->SetAllowWrites(true);
+
+    auto MeasureDispatch = [&](const FString& Action, TFunction<TSharedRef<FJsonObject>(int32)> MakePayload)
+    {
+        OutResults.Add(Measure(FString::Printf(TEXT("dispatch.%s"), *Action), Iterations, [&](int32 Iteration, FString& Error)
+        {
+            FMcpRequestTiming Timing;
+            Timing.Transport = TEXT("benchmark");
+            FString Response;
+            return Server->ExecuteAction(Action, MakePayload(Iteration), Response, Error, Timing);
+        }));
+    };
+
+    MeasureDispatch(TEXT("list_blueprints"), [](int32)
+    {
+        TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
+        Payload->SetArrayField(TEXT("paths"), { MakeShared<FJsonValueString>(McpBenchmark::PackageRoot) });
+        return Payload;
+    });
+
+    MeasureDispatch(TEXT("get_blueprint_structure"), [&AssetPath](int32)
+    {
+        TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
+        Payload->SetStringField(TEXT("asset_path"), AssetPath);
+        return Payload;
+    });
+
+    MeasureDispatch(TEXT("get_references"), [&AssetPath](int32)
+    {
+        TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
+        Payload->SetStringField(TEXT("asset_path"), AssetPath);
+        return Payload;
+    });
+
+    if (NodeGuids.Num() > 0)
+    {
+        MeasureDispatch(TEXT("set_pin_default"), [&](int32 Iteration)
+        {
+            TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
+            Payload->SetStringField(TEXT("asset_path"), AssetPath);
+            Payload->SetStringField(TEXT("graph"), FirstGraph.ToString());
+            Payload->SetStringField(TEXT("node_guid"), NodeGuids[Iteration % NodeGuids.Num()].ToString(EGuidFormats::DigitsWithHyphens));
+            Payload->SetStringField(TEXT("pin_name"), TEXT("B"));
+            Payload->SetStringField(TEXT("value"), FString::FromInt(Iteration));
+            return Payload;
+        });
+    }
+
+    FEdGraphPinType IntPinType;
+    IntPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+
+    OutResults.Add(Measure(TEXT("mutator.add_variable"), Iterations, [&](int32 Iteration, FString& Error)
+    {
+        return FMcpBlueprintMutator::AddVariable(Blueprint, FName(*FString::Printf(TEXT("BenchVar_%d"), Iteration)), IntPinType, Error);
+    }));
+
+    OutResults.Add(Measure(TEXT("mutator.add_function_graph"), Iterations, [&](int32 Iteration, FString& Error)
+    {
+        return FMcpBlueprintMutator::AddFunctionGraph(Blueprint, FName(*FString::Printf(TEXT("BenchFunc_%d"), Iteration)), Error);
+    }));
+
+    UFunction* BenchFunction = McpBenchmark::GetBenchFunction();
+    OutResults.Add(Measure(TEXT("mutator.add_call_function_node"), Iterations, [&](int32 Iteration, FString& Error)
+    {
+        FGuid NodeGuid;
+        return FMcpBlueprintMutator::AddCallFunctionNode(Blueprint, FirstGraph, BenchFunction, FVector2D(Iteration * 32.0f, -400.0f), Error, NodeGuid);
+    }));
+
+    if (Blueprint->UbergraphPages.Num() > 0 && Blueprint->UbergraphPages[0])
+    {
+        // Every iteration creates the event; the node is removed again outside the timing.
+        UEdGraph* EventGraph = Blueprint->UbergraphPages[0];
+        const FName EventName(TEXT("ReceiveTick"));
+        McpBenchmark::RemoveEventNodes(Blueprint, EventGraph, EventName);
+        OutResults.Add(Measure(TEXT("mutator.add_event_node"), Iterations, [&](int32, FString& Error)
+        {
+            FGuid NodeGuid;
+            return FMcpBlueprintMutator::AddEventNode(Blueprint, EventGraph->GetFName(), EventName, FVector2D::ZeroVector, Error, NodeGuid);
+        },
+        [&](int32)
+        {
+            McpBenchmark::RemoveEventNodes(Blueprint, EventGraph, EventName);
+        }));
+    }
+
+    OutResults.Add(Measure(TEXT("mutator.add_component"), Iterations, [&](int32 Iteration, FString& Error)
+    {
+        return FMcpBlueprintMutator::AddComponent(Blueprint, USceneComponent::StaticClass(), FName(*FString::Printf(TEXT("BenchComp_%d"), Iteration)), Error);
+    }));
+
+    if (NodeGuids.Num() > 0)
+    {
+        OutResults.Add(Measure(TEXT("mutator.set_pin_default"), Iterations, [&](int32 Iteration, FString& Error)
+        {
+            return FMcpBlueprintMutator::SetPinDefault(Blueprint, FirstGraph, NodeGuids[Iteration % NodeGuids.Num()], TEXT("A"), FString::FromInt(Iteration), Error);
+        }));
+    }
+
+    // Two spare nodes in the populated graph, so every iteration makes the same fresh link instead of
+    // stacking links onto generated pins; the link is broken again outside the timing.
+    FGuid LinkFrom;
+    FGuid LinkTo;
+    if (!FMcpBlueprintMutator::AddCallFunctionNode(Blueprint, FirstGraph, BenchFunction, FVector2D(0.0f, -800.0f), OutError, LinkFrom)
+        || !FMcpBlueprintMutator::AddCallFunctionNode(Blueprint, FirstGraph, BenchFunction, FVector2D(300.0f, -800.0f), OutError, LinkTo))
+    {
+        DiscardSyntheticBlueprint(Blueprint);
+        return false;
+    }
+
+    OutResults.Add(Measure(TEXT("mutator.connect_pins"), Iterations, [&](int32, FString& Error)
+    {
+        return FMcpBlueprintMutator::ConnectPins(Blueprint, FirstGraph, LinkFrom, TEXT("ReturnValue"), LinkTo, TEXT("B"), Error);
+    },
+    [&](int32)
+    {
+        McpBenchmark::BreakLink(Blueprint, FirstGraph, LinkFrom, TEXT("ReturnValue"), LinkTo, TEXT("B"));
+    }));
+
+    OutResults.Add(Measure(TEXT("mutator.compile"), FMath::Max(1, Iterations / 4), [&](int32, FString& Error)
+    {
+        return FMcpBlueprintMutator::Compile(Blueprint, Error);
+    }));
+
+    DiscardSyntheticBlueprint(Blueprint);
+    return true;
+}
+
+UBlueprint* FMcpBenchmark::GenerateSyntheticBlueprint(const FMcpBenchmarkConfig& Config, FString& OutError)
+{
+    const FString PackagePath = FString::Printf(TEXT("%s/BP_McpBench_%dx%dx%d_%lld"),
+        McpBenchmark::PackageRoot, Config.NumGraphs, Config.NodesPerGraph, Config.LinksPerNode, FDateTime::UtcNow().GetTicks());
+
+    const FMcpCreationResult Created = FMcpBlueprintMutator::CreateBlueprint(PackagePath, AActor::StaticClass());
+    if (!Created.bSuccess)
+    {
+        OutError = Created.Error;
+        return nullptr;
+    }
+
+    UBlueprint* Blueprint = FindObject<UBlueprint>(nullptr, *Created.AssetPath);
+    UFunction* BenchFunction = McpBenchmark::GetBenchFunction();
+    if (!Blueprint || !BenchFunction)
+    {
+        OutError = TEXT("Failed to prepare synthetic Blueprint.");
+        return nullptr;
+    }
+
+    for (int32 GraphIndex = 0; GraphIndex < Config.NumGraphs; ++GraphIndex)
+    {
+        const FName GraphName = McpBenchmark::GetGraphName(GraphIndex);
+        if (!FMcpBlueprintMutator::AddFunctionGraph(Blueprint, GraphName, OutError))
+        {
+            DiscardSyntheticBlueprint(Blueprint);
+            return nullptr;
+        }
+
+        TArray<FGuid> Guids;
+        Guids.Reserve(Config.NodesPerGraph);
+        for (int32 NodeIndex = 0; NodeIndex < Config.NodesPerGraph; ++NodeIndex)
+        {
+            FGuid NodeGuid;
+            const FVector2D Position((NodeIndex % 10) * 300.0f, (NodeIndex / 10) * 200.0f);
+            if (!FMcpBlueprintMutator::AddCallFunctionNode(Blueprint, GraphName, BenchFunction, Position, OutError, NodeGuid))
+            {
+                DiscardSyntheticBlueprint(Blueprint);
+                return nullptr;
+            }
+            Guids.Add(NodeGuid);
+        }
+
+        // Each node feeds the next K nodes, alternating between their two inputs.
+        for (int32 NodeIndex = 0; NodeIndex < Guids.Num(); ++NodeIndex)
+        {
+            for (int32 Link = 1; Link <= Config.LinksPerNode && NodeIndex + Link < Guids.Num(); ++Link)
+            {
+                const TCHAR* TargetPin = (Link % 2) ? TEXT("A") : TEXT("B");
+                if (!FMcpBlueprintMutator::ConnectPins(Blueprint, GraphName, Guids[NodeIndex], TEXT("ReturnValue"), Guids[NodeIndex + Link], TargetPin, OutError))
+                {
+                    DiscardSyntheticBlueprint(Blueprint);
+                    return nullptr;
+                }
+            }
+        }
+    }
+
+    return Blueprint;
+}
+
+void FMcpBenchmark::DiscardSyntheticBlueprint(UBlueprint* Blueprint)
+{
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    FAssetRegistryModule::AssetDeleted(Blueprint);
+    Blueprint->ClearFlags(RF_Standalone | RF_Public);
+    Blueprint->MarkAsGarbage();
+}
+
+FMcpBenchmarkResult FMcpBenchmark::Measure(const FString& Case, int32 Iterations, TFunctionRef<bool(int32, FString&)> Body, const TFunction<void(int32)>& Teardown)
+{
+    FMcpBenchmarkResult Result;
+    Result.Case = Case;
+
+    TArray<double> Times;
+    Times.Reserve(Iterations);
+    uint64 TotalAllocs = 0;
+
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        FString Error;
+        const uint64 AllocsBefore = GetAllocationCount();
+        const double Start = FPlatformTime::Seconds();
+        const bool bOk = Body(Iteration, Error);
+        const double ElapsedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+        const uint64 Allocs = GetAllocationCount() - AllocsBefore;
+
+        if (Teardown)
+        {
+            Teardown(Iteration);
+        }
+
+        // Error paths are usually much cheaper than the real work, so a failing case is reported, not timed.
+        if (!bOk)
+        {
+            Result.bFailed = true;
+            Result.Error = FString::Printf(TEXT("iteration %d: %s"), Iteration, *Error);
+            Result.Iterations = Iteration;
+            return Result;
+        }
+
+        Times.Add(ElapsedMs);
+        TotalAllocs += Allocs;
+    }
+
+    Times.Sort();
+
+    Result.Iterations = Iterations;
+    Result.MedianMs = Times[Times.Num() / 2];
+    Result.P99Ms = Times[FMath::Clamp(FMath::CeilToInt(Times.Num() * 0.99) - 1, 0, Times.Num() - 1)];
+    Result.MeanAllocs = (double)TotalAllocs / (double)Iterations;
+    return Result;
+}
+
+uint64 FMcpBenchmark::GetAllocationCount()
+{
+#if !UE_BUILD_SHIPPING
+    return FMalloc::TotalMallocCalls.load(std::memory_order_relaxed) + FMalloc::TotalReallocCalls.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+FString FMcpBenchmark::MakeSizeKey(const FMcpBenchmarkConfig& Config)
+{
+    return FString::Printf(TEXT("%dx%dx%d"), Config.NumGraphs, Config.NodesPerGraph, Config.LinksPerNode);
+}
+
+bool FMcpBenchmark::WriteCsv(const FMcpBenchmarkConfig& Config, const TArray<FMcpBenchmarkResult>& Results, const FString& Path, FString& OutError)
+{
+    FString Csv = TEXT("case,size,iterations,median_ms,p99_ms,mean_allocs,status\n");
+    const FString SizeKey = MakeSizeKey(Config);
+    for (const FMcpBenchmarkResult& Result : Results)
+    {
+        Csv += FString::Printf(TEXT("%s,%s,%d,%.4f,%.4f,%.1f,%s\n"), *Result.Case, *SizeKey, Result.Iterations, Result.MedianMs, Result.P99Ms, Result.MeanAllocs,
+            Result.bFailed ? TEXT("failed") : TEXT("ok"));
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *Path))
+    {
+        OutError = FString::Printf(TEXT("Failed to write '%s'."), *Path);
+        return false;
+    }
+    return true;
+}
+
+bool FMcpBenchmark::CompareWithBaseline(const FMcpBenchmarkConfig& Config, const TArray<FMcpBenchmarkResult>& Results, TArray<FString>& OutRegressions, FString& OutError)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *Config.BaselineCsv))
+    {
+        OutError = FString::Printf(TEXT("Failed to read baseline '%s'."), *Config.BaselineCsv);
+        return false;
+    }
+
+    TMap<FString, double> BaselineMedians;
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        TArray<FString> Columns;
+        Lines[LineIndex].ParseIntoArray(Columns, TEXT(","), false);
+        // Baselines without a status column predate failure tracking; failed rows have no usable timing.
+        const bool bFailedRow = Columns.Num() >= 7 && Columns[6] == TEXT("failed");
+        if (Columns.Num() >= 4 && !bFailedRow)
+        {
+            BaselineMedians.Add(Columns[0] + TEXT("@") + Columns[1], FCString::Atod(*Columns[3]));
+        }
+    }
+
+    const FString SizeKey = MakeSizeKey(Config);
+    for (const FMcpBenchmarkResult& Result : Results)
+    {
+        if (Result.bFailed)
+        {
+            OutRegressions.Add(FString::Printf(TEXT("%s (%s): failed, %s"), *Result.Case, *SizeKey, *Result.Error));
+            continue;
+        }
+
+        const double* Baseline = BaselineMedians.Find(Result.Case + TEXT("@") + SizeKey);
+        if (Baseline && *Baseline > 0.0 && Result.MedianMs > *Baseline * (1.0 + Config.RegressionThreshold))
+        {
+            OutRegressions.Add(FString::Printf(TEXT("%s (%s): median %.3f ms vs baseline %.3f ms (+%.1f%%)"),
+                *Result.Case, *SizeKey, Result.MedianMs, *Baseline, (Result.MedianMs / *Baseline - 1.0) * 100.0));
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,136 @@
+#include "McpBlueprintCache.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "McpTrace.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+
+FMcpBlueprintCache::FMcpBlueprintCache(int32 InCapacity)
+    : Capacity(FMath::Max(1, InCapacity))
+{
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FMcpBlueprintCache::PurgeStale);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMcpBlueprintCache::OnAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMcpBlueprintCache::OnAssetRenamed);
+
+    FMcpServerMetrics::Get().RegisterCache(TEXT("blueprints"), &Counters);
+}
+
+FMcpBlueprintCache::~FMcpBlueprintCache()
+{
+    FMcpServerMetrics::Get().UnregisterCache(&Counters);
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        AssetRegistryModule->Get().OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistryModule->Get().OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+}
+
+FString FMcpBlueprintCache::NormalizePath(const FString& AssetPath)
+{
+    // Accepts "Blueprint'/Game/X/BP.BP'", "/Game/X/BP.BP" and the package form "/Game/X/BP".
+    FString ObjectPath = FPackageName::ExportTextPathToObjectPath(AssetPath.TrimStartAndEnd());
+    if (!ObjectPath.Contains(TEXT(".")))
+    {
+        ObjectPath = ObjectPath + TEXT(".") + FPackageName::GetShortName(ObjectPath);
+    }
+    return ObjectPath;
+}
+
+UBlueprint* FMcpBlueprintCache::Load(const FString& AssetPath)
+{
+    const FString Key = NormalizePath(AssetPath);
+    if (FEntry* Entry = Entries.Find(Key))
+    {
+        if (UBlueprint* Blueprint = Entry->Blueprint.Get())
+        {
+            Entry->LastUse = ++UseCounter;
+            Counters.Record(true);
+            return Blueprint;
+        }
+        Entries.Remove(Key);
+    }
+
+    Counters.Record(false);
+
+    UBlueprint* Blueprint = nullptr;
+    {
+        MCP_TRACE_SCOPE("Mcp::LoadObject");
+        Blueprint = LoadObject<UBlueprint>(nullptr, *Key);
+    }
+    if (!Blueprint)
+    {
+        return nullptr;
+    }
+
+    if (Entries.Num() >= Capacity)
+    {
+        EvictOldest();
+    }
+
+    FEntry& Entry = Entries.Add(Key);
+    Entry.Blueprint = Blueprint;
+    Entry.LastUse = ++UseCounter;
+    return Blueprint;
+}
+
+void FMcpBlueprintCache::Remove(const FString& AssetPath)
+{
+    Entries.Remove(NormalizePath(AssetPath));
+}
+
+void FMcpBlueprintCache::Empty()
+{
+    Entries.Empty();
+}
+
+void FMcpBlueprintCache::EvictOldest()
+{
+    // Capacity is small, so a linear scan is cheaper than maintaining a separate recency list.
+    const FString* OldestKey = nullptr;
+    uint64 OldestUse = MAX_uint64;
+    for (const TPair<FString, FEntry>& Pair : Entries)
+    {
+        if (!Pair.Value.Blueprint.IsValid())
+        {
+            OldestKey = &Pair.Key;
+            break;
+        }
+        if (Pair.Value.LastUse < OldestUse)
+        {
+            OldestUse = Pair.Value.LastUse;
+            OldestKey = &Pair.Key;
+        }
+    }
+
+    if (OldestKey)
+    {
+        const FString Key = *OldestKey;
+        Entries.Remove(Key);
+    }
+}
+
+void FMcpBlueprintCache::PurgeStale()
+{
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().Blueprint.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FMcpBlueprintCache::OnAssetRemoved(const FAssetData& AssetData)
+{
+    Entries.Remove(AssetData.GetObjectPathString());
+}
+
+void FMcpBlueprintCache::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    Entries.Remove(NormalizePath(OldObjectPath));
+}
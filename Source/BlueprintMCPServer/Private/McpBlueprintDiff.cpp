@@ -0,0 +1,771 @@
+#include "McpBlueprintDiff.h"
+
+#include "BlueprintInspector.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "HAL/FileManager.h"
+#include "Json.h"
+#include "McpNodeTitleCache.h"
+#include "McpTrace.h"
+#include "Misc/PackageName.h"
+#include "Misc/PackagePath.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace McpBlueprintDiff
+{
+    struct FPairing
+    {
+        TArray<TPair<int32, int32>> Matched;
+        TArray<int32> Removed;
+        TArray<int32> Added;
+    };
+
+    // Pairs base and target items by id; the rest by key, preferring the nearest candidate when several
+    // share a key. Missing or duplicated ids go straight to the key pass.
+    static FPairing Pair(const TArray<FGuid>& BaseIds, const TArray<FString>& BaseKeys, const TArray<FGuid>& TargetIds, const TArray<FString>& TargetKeys,
+        TFunction<double(int32, int32)> Distance = nullptr)
+    {
+        FPairing Result;
+        TArray<bool> TargetUsed;
+        TargetUsed.SetNumZeroed(TargetIds.Num());
+
+        TMap<FGuid, int32> TargetById;
+        for (int32 Index = 0; Index < TargetIds.Num(); ++Index)
+        {
+            if (TargetIds[Index].IsValid())
+            {
+                if (int32* Existing = TargetById.Find(TargetIds[Index]))
+                {
+                    *Existing = INDEX_NONE;
+                }
+                else
+                {
+                    TargetById.Add(TargetIds[Index], Index);
+                }
+            }
+        }
+
+        TArray<int32> Unmatched;
+        for (int32 Index = 0; Index < BaseIds.Num(); ++Index)
+        {
+            const int32* TargetIndex = BaseIds[Index].IsValid() ? TargetById.Find(BaseIds[Index]) : nullptr;
+            if (TargetIndex && *TargetIndex != INDEX_NONE && !TargetUsed[*TargetIndex])
+            {
+                TargetUsed[*TargetIndex] = true;
+                Result.Matched.Emplace(Index, *TargetIndex);
+            }
+            else
+            {
+                Unmatched.Add(Index);
+            }
+        }
+
+        TMultiMap<FString, int32> TargetByKey;
+        for (int32 Index = 0; Index < TargetKeys.Num(); ++Index)
+        {
+            if (!TargetUsed[Index])
+            {
+                TargetByKey.Add(TargetKeys[Index], Index);
+            }
+        }
+
+        TArray<int32> Candidates;
+        for (const int32 BaseIndex : Unmatched)
+        {
+            Candidates.Reset();
+            TargetByKey.MultiFind(BaseKeys[BaseIndex], Candidates);
+
+            int32 Best = INDEX_NONE;
+            double BestDistance = TNumericLimits<double>::Max();
+            for (const int32 Candidate : Candidates)
+            {
+                if (TargetUsed[Candidate])
+                {
+                    continue;
+                }
+                const double CandidateDistance = Distance ? Distance(BaseIndex, Candidate) : (double)Candidate;
+                if (CandidateDistance < BestDistance)
+                {
+                    Best = Candidate;
+                    BestDistance = CandidateDistance;
+                }
+            }
+
+            if (Best != INDEX_NONE)
+            {
+                TargetUsed[Best] = true;
+                Result.Matched.Emplace(BaseIndex, Best);
+            }
+            else
+            {
+                Result.Removed.Add(BaseIndex);
+            }
+        }
+
+        for (int32 Index = 0; Index < TargetUsed.Num(); ++Index)
+        {
+            if (!TargetUsed[Index])
+            {
+                Result.Added.Add(Index);
+            }
+        }
+        return Result;
+    }
+
+    struct FSection
+    {
+        TArray<TSharedPtr<FJsonValue>> Added;
+        TArray<TSharedPtr<FJsonValue>> Removed;
+        TArray<TSharedPtr<FJsonValue>> Changed;
+
+        bool IsEmpty() const { return Added.Num() == 0 && Removed.Num() == 0 && Changed.Num() == 0; }
+
+        void Write(FJsonObject& ResultObj, FJsonObject& SummaryObj, const TCHAR* Name) const
+        {
+            TSharedRef<FJsonObject> SectionObj = MakeShared<FJsonObject>();
+            SectionObj->SetArrayField(TEXT("added"), Added);
+            SectionObj->SetArrayField(TEXT("removed"), Removed);
+            SectionObj->SetArrayField(TEXT("changed"), Changed);
+            ResultObj.SetObjectField(Name, SectionObj);
+            WriteCounts(SummaryObj, Name, Added.Num(), Removed.Num(), Changed.Num());
+        }
+
+        static void WriteCounts(FJsonObject& SummaryObj, const TCHAR* Name, int32 NumAdded, int32 NumRemoved, int32 NumChanged)
+        {
+            TSharedRef<FJsonObject> CountsObj = MakeShared<FJsonObject>();
+            CountsObj->SetNumberField(TEXT("added"), NumAdded);
+            CountsObj->SetNumberField(TEXT("removed"), NumRemoved);
+            if (NumChanged >= 0)
+            {
+                CountsObj->SetNumberField(TEXT("changed"), NumChanged);
+            }
+            SummaryObj.SetObjectField(Name, CountsObj);
+        }
+    };
+
+    struct FGraphCounts
+    {
+        int32 NodesAdded = 0;
+        int32 NodesRemoved = 0;
+        int32 NodesChanged = 0;
+        int32 LinksAdded = 0;
+        int32 LinksRemoved = 0;
+    };
+
+    static void AddChange(FJsonObject& ChangesObj, const TCHAR* Field, const FString& Old, const FString& New)
+    {
+        if (!Old.Equals(New, ESearchCase::CaseSensitive))
+        {
+            TSharedRef<FJsonObject> ChangeObj = MakeShared<FJsonObject>();
+            ChangeObj->SetStringField(TEXT("old"), Old);
+            ChangeObj->SetStringField(TEXT("new"), New);
+            ChangesObj.SetObjectField(Field, ChangeObj);
+        }
+    }
+
+    static FString GuidString(const FGuid& Guid)
+    {
+        return Guid.ToString(EGuidFormats::DigitsWithHyphens);
+    }
+
+    static FString DescribePinDefault(const UEdGraphPin* Pin)
+    {
+        if (Pin->DefaultObject)
+        {
+            return Pin->DefaultObject->GetPathName();
+        }
+        if (!Pin->DefaultTextValue.IsEmpty())
+        {
+            return Pin->DefaultTextValue.ToString();
+        }
+        return Pin->DefaultValue;
+    }
+
+    static FString GetPinKey(const UEdGraphPin* Pin)
+    {
+        return (Pin->Direction == EGPD_Output ? TEXT(">") : TEXT("<")) + Pin->PinName.ToString();
+    }
+
+    // Class plus pin layout: distinguishes e.g. two call-function nodes targeting different functions.
+    static FString GetNodeSignature(const UEdGraphNode* Node)
+    {
+        FString Signature = Node->GetClass()->GetName();
+        for (const UEdGraphPin* Pin : Node->Pins)
+        {
+            if (Pin)
+            {
+                Signature += TEXT("|") + GetPinKey(Pin);
+            }
+        }
+        return Signature;
+    }
+
+    static TSharedRef<FJsonObject> DescribeNode(const UEdGraphNode* Node)
+    {
+        TSharedRef<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+        NodeObj->SetStringField(TEXT("guid"), GuidString(Node->NodeGuid));
+        NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
+        NodeObj->SetStringField(TEXT("title"), FMcpNodeTitleCache::Get().GetTitle(Node));
+        return NodeObj;
+    }
+
+    static TSharedRef<FJsonObject> DescribeVariable(const FBPVariableDescription& Variable)
+    {
+        TSharedRef<FJsonObject> VariableObj = MakeShared<FJsonObject>();
+        VariableObj->SetStringField(TEXT("name"), Variable.VarName.ToString());
+        VariableObj->SetStringField(TEXT("type"), FMcpBlueprintInspector::DescribePinType(Variable.VarType));
+        if (!Variable.DefaultValue.IsEmpty())
+        {
+            VariableObj->SetStringField(TEXT("default"), Variable.DefaultValue);
+        }
+        return VariableObj;
+    }
+
+    static FSection DiffVariables(const UBlueprint* Base, const UBlueprint* Target)
+    {
+        TArray<FGuid> BaseIds;
+        TArray<FString> BaseKeys;
+        for (const FBPVariableDescription& Variable : Base->NewVariables)
+        {
+            BaseIds.Add(Variable.VarGuid);
+            BaseKeys.Add(Variable.VarName.ToString());
+        }
+
+        TArray<FGuid> TargetIds;
+        TArray<FString> TargetKeys;
+        for (const FBPVariableDescription& Variable : Target->NewVariables)
+        {
+            TargetIds.Add(Variable.VarGuid);
+            TargetKeys.Add(Variable.VarName.ToString());
+        }
+
+        FSection Section;
+        const FPairing Pairing = Pair(BaseIds, BaseKeys, TargetIds, TargetKeys);
+        for (const TPair<int32, int32>& Match : Pairing.Matched)
+        {
+            const FBPVariableDescription& Old = Base->NewVariables[Match.Key];
+            const FBPVariableDescription& New = Target->NewVariables[Match.Value];
+
+            TSharedRef<FJsonObject> ChangesObj = MakeShared<FJsonObject>();
+            AddChange(*ChangesObj, TEXT("name"), Old.VarName.ToString(), New.VarName.ToString());
+            AddChange(*ChangesObj, TEXT("type"), FMcpBlueprintInspector::DescribePinType(Old.VarType), FMcpBlueprintInspector::DescribePinType(New.VarType));
+            AddChange(*ChangesObj, TEXT("default"), Old.DefaultValue, New.DefaultValue);
+            AddChange(*ChangesObj, TEXT("category"), Old.Category.ToString(), New.Category.ToString());
+            AddChange(*ChangesObj, TEXT("flags"), FString::Printf(TEXT("0x%llx"), Old.PropertyFlags), FString::Printf(TEXT("0x%llx"), New.PropertyFlags));
+            if (ChangesObj->Values.Num() > 0)
+            {
+                TSharedRef<FJsonObject> VariableObj = MakeShared<FJsonObject>();
+                VariableObj->SetStringField(TEXT("name"), New.VarName.ToString());
+                VariableObj->SetObjectField(TEXT("changes"), ChangesObj);
+                Section.Changed.Add(MakeShared<FJsonValueObject>(VariableObj));
+            }
+        }
+        for (const int32 Index : Pairing.Removed)
+        {
+            Section.Removed.Add(MakeShared<FJsonValueObject>(DescribeVariable(Base->NewVariables[Index])));
+        }
+        for (const int32 Index : Pairing.Added)
+        {
+            Section.Added.Add(MakeShared<FJsonValueObject>(DescribeVariable(Target->NewVariables[Index])));
+        }
+        return Section;
+    }
+
+    static TArray<USCS_Node*> GetComponentNodes(const UBlueprint* Blueprint)
+    {
+        return Blueprint->SimpleConstructionScript ? Blueprint->SimpleConstructionScript->GetAllNodes() : TArray<USCS_Node*>();
+    }
+
+    static FString GetComponentParent(const UBlueprint* Blueprint, USCS_Node* Node)
+    {
+        if (const USCS_Node* Parent = Blueprint->SimpleConstructionScript->FindParentNode(Node))
+        {
+            return Parent->GetVariableName().ToString();
+        }
+        return Node->ParentComponentOrVariableName.ToString();
+    }
+
+    static TSharedRef<FJsonObject> DescribeComponent(const USCS_Node* Node)
+    {
+        TSharedRef<FJsonObject> ComponentObj = MakeShared<FJsonObject>();
+        ComponentObj->SetStringField(TEXT("name"), Node->GetVariableName().ToString());
+        ComponentObj->SetStringField(TEXT("class"), Node->ComponentClass ? Node->ComponentClass->GetName() : FString());
+        return ComponentObj;
+    }
+
+    static FSection DiffComponents(const UBlueprint* Base, const UBlueprint* Target)
+    {
+        const TArray<USCS_Node*> BaseNodes = GetComponentNodes(Base);
+        const TArray<USCS_Node*> TargetNodes = GetComponentNodes(Target);
+
+        TArray<FGuid> BaseIds;
+        TArray<FString> BaseKeys;
+        for (const USCS_Node* Node : BaseNodes)
+        {
+            BaseIds.Add(Node->VariableGuid);
+            BaseKeys.Add(Node->GetVariableName().ToString());
+        }
+
+        TArray<FGuid> TargetIds;
+        TArray<FString> TargetKeys;
+        for (const USCS_Node* Node : TargetNodes)
+        {
+            TargetIds.Add(Node->VariableGuid);
+            TargetKeys.Add(Node->GetVariableName().ToString());
+        }
+
+        FSection Section;
+        const FPairing Pairing = Pair(BaseIds, BaseKeys, TargetIds, TargetKeys);
+        for (const TPair<int32, int32>& Match : Pairing.Matched)
+        {
+            USCS_Node* Old = BaseNodes[Match.Key];
+            USCS_Node* New = TargetNodes[Match.Value];
+
+            TSharedRef<FJsonObject> ChangesObj = MakeShared<FJsonObject>();
+            AddChange(*ChangesObj, TEXT("name"), Old->GetVariableName().ToString(), New->GetVariableName().ToString());
+            AddChange(*ChangesObj, TEXT("class"), Old->ComponentClass ? Old->ComponentClass->GetName() : FString(), New->ComponentClass ? New->ComponentClass->GetName() : FString());
+            AddChange(*ChangesObj, TEXT("parent"), GetComponentParent(Base, Old), GetComponentParent(Target, New));
+            AddChange(*ChangesObj, TEXT("attach_socket"), Old->AttachToName.ToString(), New->AttachToName.ToString());
+            if (ChangesObj->Values.Num() > 0)
+            {
+                TSharedRef<FJsonObject> ComponentObj = DescribeComponent(New);
+                ComponentObj->SetObjectField(TEXT("changes"), ChangesObj);
+                Section.Changed.Add(MakeShared<FJsonValueObject>(ComponentObj));
+            }
+        }
+        for (const int32 Index : Pairing.Removed)
+        {
+            Section.Removed.Add(MakeShared<FJsonValueObject>(DescribeComponent(BaseNodes[Index])));
+        }
+        for (const int32 Index : Pairing.Added)
+        {
+            Section.Added.Add(MakeShared<FJsonValueObject>(DescribeComponent(TargetNodes[Index])));
+        }
+        return Section;
+    }
+
+    static TSharedPtr<FJsonObject> DiffPins(const UEdGraphNode* Base, const UEdGraphNode* Target)
+    {
+        TArray<const UEdGraphPin*> BasePins;
+        TArray<FGuid> BaseIds;
+        TArray<FString> BaseKeys;
+        for (const UEdGraphPin* Pin : Base->Pins)
+        {
+            if (Pin)
+            {
+                BasePins.Add(Pin);
+                BaseIds.Add(Pin->PinId);
+                BaseKeys.Add(GetPinKey(Pin));
+            }
+        }
+
+        TArray<const UEdGraphPin*> TargetPins;
+        TArray<FGuid> TargetIds;
+        TArray<FString> TargetKeys;
+        for (const UEdGraphPin* Pin : Target->Pins)
+        {
+            if (Pin)
+            {
+                TargetPins.Add(Pin);
+                TargetIds.Add(Pin->PinId);
+                TargetKeys.Add(GetPinKey(Pin));
+            }
+        }
+
+        FSection Section;
+        const FPairing Pairing = Pair(BaseIds, BaseKeys, TargetIds, TargetKeys);
+        for (const TPair<int32, int32>& Match : Pairing.Matched)
+        {
+            const UEdGraphPin* Old = BasePins[Match.Key];
+            const UEdGraphPin* New = TargetPins[Match.Value];
+
+            TSharedRef<FJsonObject> ChangesObj = MakeShared<FJsonObject>();
+            AddChange(*ChangesObj, TEXT("name"), Old->PinName.ToString(), New->PinName.ToString());
+            AddChange(*ChangesObj, TEXT("type"), FMcpBlueprintInspector::DescribePinType(Old->PinType), FMcpBlueprintInspector::DescribePinType(New->PinType));
+            AddChange(*ChangesObj, TEXT("default"), DescribePinDefault(Old), DescribePinDefault(New));
+            if (ChangesObj->Values.Num() > 0)
+            {
+                TSharedRef<FJsonObject> PinObj = MakeShared<FJsonObject>();
+                PinObj->SetStringField(TEXT("name"), New->PinName.ToString());
+                PinObj->SetObjectField(TEXT("changes"), ChangesObj);
+                Section.Changed.Add(MakeShared<FJsonValueObject>(PinObj));
+            }
+        }
+        for (const int32 Index : Pairing.Removed)
+        {
+            Section.Removed.Add(MakeShared<FJsonValueString>(BasePins[Index]->PinName.ToString()));
+        }
+        for (const int32 Index : Pairing.Added)
+        {
+            Section.Added.Add(MakeShared<FJsonValueString>(TargetPins[Index]->PinName.ToString()));
+        }
+
+        if (Section.IsEmpty())
+        {
+            return nullptr;
+        }
+
+        TSharedRef<FJsonObject> PinsObj = MakeShared<FJsonObject>();
+        PinsObj->SetArrayField(TEXT("added"), Section.Added);
+        PinsObj->SetArrayField(TEXT("removed"), Section.Removed);
+        PinsObj->SetArrayField(TEXT("changed"), Section.Changed);
+        return PinsObj;
+    }
+
+    // Links keyed by "from node, from pin, to node, to pin", each recorded once from its output pin.
+    static void CollectLinks(const TArray<UEdGraphNode*>& Nodes, const TMap<const UEdGraphNode*, FString>& NodeKeys, TMap<FString, TSharedPtr<FJsonValue>>& OutLinks)
+    {
+        for (const UEdGraphNode* Node : Nodes)
+        {
+            for (const UEdGraphPin* Pin : Node->Pins)
+            {
+                if (!Pin || Pin->Direction != EGPD_Output)
+                {
+                    continue;
+                }
+
+                for (const UEdGraphPin* Linked : Pin->LinkedTo)
+                {
+                    const FString* ToKey = Linked ? NodeKeys.Find(Linked->GetOwningNodeUnchecked()) : nullptr;
+                    if (!ToKey)
+                    {
+                        continue;
+                    }
+
+                    const FString& FromKey = NodeKeys.FindChecked(Node);
+                    TSharedRef<FJsonObject> LinkObj = MakeShared<FJsonObject>();
+                    LinkObj->SetStringField(TEXT("from_node"), FromKey);
+                    LinkObj->SetStringField(TEXT("from_pin"), Pin->PinName.ToString());
+                    LinkObj->SetStringField(TEXT("to_node"), *ToKey);
+                    LinkObj->SetStringField(TEXT("to_pin"), Linked->PinName.ToString());
+                    OutLinks.Add(FString::Join(TArray<FString>{ FromKey, Pin->PinName.ToString(), *ToKey, Linked->PinName.ToString() }, TEXT("\n")),
+                        MakeShared<FJsonValueObject>(LinkObj));
+                }
+            }
+        }
+    }
+
+    static TSharedPtr<FJsonObject> DiffGraph(const UEdGraph* Base, const UEdGraph* Target, FGraphCounts& Counts)
+    {
+        TArray<UEdGraphNode*> BaseNodes;
+        TArray<FGuid> BaseIds;
+        TArray<FString> BaseKeys;
+        for (UEdGraphNode* Node : Base->Nodes)
+        {
+            if (Node)
+            {
+                BaseNodes.Add(Node);
+                BaseIds.Add(Node->NodeGuid);
+                BaseKeys.Add(GetNodeSignature(Node));
+            }
+        }
+
+        TArray<UEdGraphNode*> TargetNodes;
+        TArray<FGuid> TargetIds;
+        TArray<FString> TargetKeys;
+        for (UEdGraphNode* Node : Target->Nodes)
+        {
+            if (Node)
+            {
+                TargetNodes.Add(Node);
+                TargetIds.Add(Node->NodeGuid);
+                TargetKeys.Add(GetNodeSignature(Node));
+            }
+        }
+
+        const FPairing Pairing = Pair(BaseIds, BaseKeys, TargetIds, TargetKeys, [&BaseNodes, &TargetNodes](int32 BaseIndex, int32 TargetIndex)
+        {
+            const double DeltaX = BaseNodes[BaseIndex]->NodePosX - TargetNodes[TargetIndex]->NodePosX;
+            const double DeltaY = BaseNodes[BaseIndex]->NodePosY - TargetNodes[TargetIndex]->NodePosY;
+            return DeltaX * DeltaX + DeltaY * DeltaY;
+        });
+
+        // Matched base nodes take their target's GUID so links on both sides compare equal.
+        TMap<const UEdGraphNode*, FString> NodeKeys;
+        for (const UEdGraphNode* Node : TargetNodes)
+        {
+            NodeKeys.Add(Node, GuidString(Node->NodeGuid));
+        }
+        for (const TPair<int32, int32>& Match : Pairing.Matched)
+        {
+            NodeKeys.Add(BaseNodes[Match.Key], GuidString(TargetNodes[Match.Value]->NodeGuid));
+        }
+        for (const int32 Index : Pairing.Removed)
+        {
+            NodeKeys.Add(BaseNodes[Index], GuidString(BaseNodes[Index]->NodeGuid));
+        }
+
+        FSection Nodes;
+        for (const TPair<int32, int32>& Match : Pairing.Matched)
+        {
+            const UEdGraphNode* Old = BaseNodes[Match.Key];
+            const UEdGraphNode* New = TargetNodes[Match.Value];
+
+            TSharedRef<FJsonObject> ChangesObj = MakeShared<FJsonObject>();
+            AddChange(*ChangesObj, TEXT("guid"), GuidString(Old->NodeGuid), GuidString(New->NodeGuid));
+            AddChange(*ChangesObj, TEXT("position"), FString::Printf(TEXT("%d,%d"), Old->NodePosX, Old->NodePosY), FString::Printf(TEXT("%d,%d"), New->NodePosX, New->NodePosY));
+            AddChange(*ChangesObj, TEXT("comment"), Old->NodeComment, New->NodeComment);
+            const TSharedPtr<FJsonObject> PinsObj = DiffPins(Old, New);
+            if (ChangesObj->Values.Num() > 0 || PinsObj.IsValid())
+            {
+                TSharedRef<FJsonObject> NodeObj = DescribeNode(New);
+                NodeObj->SetStringField(TEXT("matched_by"), Old->NodeGuid == New->NodeGuid ? TEXT("guid") : TEXT("heuristic"));
+                NodeObj->SetObjectField(TEXT("changes"), ChangesObj);
+                if (PinsObj.IsValid())
+                {
+                    NodeObj->SetObjectField(TEXT("pins"), PinsObj);
+                }
+                Nodes.Changed.Add(MakeShared<FJsonValueObject>(NodeObj));
+            }
+        }
+        for (const int32 Index : Pairing.Removed)
+        {
+            Nodes.Removed.Add(MakeShared<FJsonValueObject>(DescribeNode(BaseNodes[Index])));
+        }
+        for (const int32 Index : Pairing.Added)
+        {
+            Nodes.Added.Add(MakeShared<FJsonValueObject>(DescribeNode(TargetNodes[Index])));
+        }
+
+        TMap<FString, TSharedPtr<FJsonValue>> BaseLinks;
+        TMap<FString, TSharedPtr<FJsonValue>> TargetLinks;
+        CollectLinks(BaseNodes, NodeKeys, BaseLinks);
+        CollectLinks(TargetNodes, NodeKeys, TargetLinks);
+
+        TArray<TSharedPtr<FJsonValue>> LinksAdded;
+        TArray<TSharedPtr<FJsonValue>> LinksRemoved;
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Link : TargetLinks)
+        {
+            if (!BaseLinks.Contains(Link.Key))
+            {
+                LinksAdded.Add(Link.Value);
+            }
+        }
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Link : BaseLinks)
+        {
+            if (!TargetLinks.Contains(Link.Key))
+            {
+                LinksRemoved.Add(Link.Value);
+            }
+        }
+
+        const FString OldName = Base->GetName();
+        const FString NewName = Target->GetName();
+        if (Nodes.IsEmpty() && LinksAdded.Num() == 0 && LinksRemoved.Num() == 0 && OldName == NewName)
+        {
+            return nullptr;
+        }
+
+        Counts.NodesAdded += Nodes.Added.Num();
+        Counts.NodesRemoved += Nodes.Removed.Num();
+        Counts.NodesChanged += Nodes.Changed.Num();
+        Counts.LinksAdded += LinksAdded.Num();
+        Counts.LinksRemoved += LinksRemoved.Num();
+
+        TSharedRef<FJsonObject> GraphObj = MakeShared<FJsonObject>();
+        GraphObj->SetStringField(TEXT("name"), NewName);
+        if (OldName != NewName)
+        {
+            GraphObj->SetStringField(TEXT("old_name"), OldName);
+        }
+
+        TSharedRef<FJsonObject> NodesObj = MakeShared<FJsonObject>();
+        NodesObj->SetArrayField(TEXT("added"), Nodes.Added);
+        NodesObj->SetArrayField(TEXT("removed"), Nodes.Removed);
+        NodesObj->SetArrayField(TEXT("changed"), Nodes.Changed);
+        GraphObj->SetObjectField(TEXT("nodes"), NodesObj);
+
+        TSharedRef<FJsonObject> LinksObj = MakeShared<FJsonObject>();
+        LinksObj->SetArrayField(TEXT("added"), LinksAdded);
+        LinksObj->SetArrayField(TEXT("removed"), LinksRemoved);
+        GraphObj->SetObjectField(TEXT("links"), LinksObj);
+        return GraphObj;
+    }
+
+    static TSharedRef<FJsonObject> DescribeGraph(const UEdGraph* Graph)
+    {
+        TSharedRef<FJsonObject> GraphObj = MakeShared<FJsonObject>();
+        GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+        GraphObj->SetNumberField(TEXT("nodes"), Graph->Nodes.Num());
+        return GraphObj;
+    }
+
+    static FSection DiffGraphs(const UBlueprint* Base, const UBlueprint* Target, FGraphCounts& Counts)
+    {
+        TArray<UEdGraph*> BaseGraphs;
+        Base->GetAllGraphs(BaseGraphs);
+        TArray<UEdGraph*> TargetGraphs;
+        Target->GetAllGraphs(TargetGraphs);
+
+        TArray<FGuid> BaseIds;
+        TArray<FString> BaseKeys;
+        for (const UEdGraph* Graph : BaseGraphs)
+        {
+            BaseIds.Add(Graph->GraphGuid);
+            BaseKeys.Add(Graph->GetName());
+        }
+
+        TArray<FGuid> TargetIds;
+        TArray<FString> TargetKeys;
+        for (const UEdGraph* Graph : TargetGraphs)
+        {
+            TargetIds.Add(Graph->GraphGuid);
+            TargetKeys.Add(Graph->GetName());
+        }
+
+        FSection Section;
+        const FPairing Pairing = Pair(BaseIds, BaseKeys, TargetIds, TargetKeys);
+        for (const TPair<int32, int32>& Match : Pairing.Matched)
+        {
+            if (const TSharedPtr<FJsonObject> GraphObj = DiffGraph(BaseGraphs[Match.Key], TargetGraphs[Match.Value], Counts))
+            {
+                Section.Changed.Add(MakeShared<FJsonValueObject>(GraphObj));
+            }
+        }
+        for (const int32 Index : Pairing.Removed)
+        {
+            Section.Removed.Add(MakeShared<FJsonValueObject>(DescribeGraph(BaseGraphs[Index])));
+            Counts.NodesRemoved += BaseGraphs[Index]->Nodes.Num();
+        }
+        for (const int32 Index : Pairing.Added)
+        {
+            Section.Added.Add(MakeShared<FJsonValueObject>(DescribeGraph(TargetGraphs[Index])));
+            Counts.NodesAdded += TargetGraphs[Index]->Nodes.Num();
+        }
+        return Section;
+    }
+}
+
+FMcpBlueprintDiff::FMcpBlueprintDiff()
+{
+    FMcpServerMetrics::Get().RegisterCache(TEXT("saved_revisions"), &Counters);
+}
+
+FMcpBlueprintDiff::~FMcpBlueprintDiff()
+{
+    FMcpServerMetrics::Get().UnregisterCache(&Counters);
+    for (TPair<FString, FSavedRevision>& Pair : SavedRevisions)
+    {
+        Release(Pair.Value);
+    }
+}
+
+TSharedRef<FJsonObject> FMcpBlueprintDiff::Diff(const UBlueprint* Base, const UBlueprint* Target)
+{
+    using namespace McpBlueprintDiff;
+    MCP_TRACE_SCOPE("Mcp::Diff");
+
+    TSharedRef<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    TSharedRef<FJsonObject> SummaryObj = MakeShared<FJsonObject>();
+
+    const FString OldParent = Base->ParentClass ? Base->ParentClass->GetPathName() : FString();
+    const FString NewParent = Target->ParentClass ? Target->ParentClass->GetPathName() : FString();
+    AddChange(*ResultObj, TEXT("parent_class"), OldParent, NewParent);
+
+    const FSection Variables = DiffVariables(Base, Target);
+    const FSection Components = DiffComponents(Base, Target);
+    FGraphCounts Counts;
+    const FSection Graphs = DiffGraphs(Base, Target, Counts);
+
+    Variables.Write(*ResultObj, *SummaryObj, TEXT("variables"));
+    Components.Write(*ResultObj, *SummaryObj, TEXT("components"));
+    Graphs.Write(*ResultObj, *SummaryObj, TEXT("graphs"));
+    FSection::WriteCounts(*SummaryObj, TEXT("nodes"), Counts.NodesAdded, Counts.NodesRemoved, Counts.NodesChanged);
+    FSection::WriteCounts(*SummaryObj, TEXT("links"), Counts.LinksAdded, Counts.LinksRemoved, INDEX_NONE);
+
+    ResultObj->SetBoolField(TEXT("identical"), OldParent == NewParent && Variables.IsEmpty() && Components.IsEmpty() && Graphs.IsEmpty());
+    ResultObj->SetObjectField(TEXT("summary"), SummaryObj);
+    return ResultObj;
+}
+
+UBlueprint* FMcpBlueprintDiff::LoadSavedRevision(const UBlueprint* Blueprint, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Diff::LoadSavedRevision");
+
+    const FString PackageName = Blueprint->GetOutermost()->GetName();
+    FString Filename;
+    if (!FPackageName::DoesPackageExist(PackageName, &Filename))
+    {
+        OutError = FString::Printf(TEXT("'%s' has no saved package to compare against."), *PackageName);
+        return nullptr;
+    }
+
+    const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*Filename);
+    if (FSavedRevision* Revision = SavedRevisions.Find(PackageName))
+    {
+        if (Revision->Blueprint && Revision->Timestamp == Timestamp)
+        {
+            Counters.Record(true);
+            return Revision->Blueprint;
+        }
+        Release(*Revision);
+        SavedRevisions.Remove(PackageName);
+    }
+    Counters.Record(false);
+
+    if (SavedRevisions.Num() >= MaxSavedRevisions)
+    {
+        auto Oldest = SavedRevisions.CreateIterator();
+        Release(Oldest.Value());
+        Oldest.RemoveCurrent();
+    }
+
+    // The asset is already loaded under its own name, so load a copy of the file as a separate package.
+    const FString TempFilename = FPaths::CreateTempFilename(*FPaths::DiffDir(), *(FPackageName::GetShortName(PackageName) + TEXT("-Mcp-")), *FPaths::GetExtension(Filename, /*bIncludeDot=*/true));
+    if (IFileManager::Get().Copy(*TempFilename, *Filename) != COPY_OK)
+    {
+        OutError = FString::Printf(TEXT("Could not copy '%s' for diffing."), *Filename);
+        return nullptr;
+    }
+
+    UPackage* Package = nullptr;
+    {
+        MCP_TRACE_SCOPE("Mcp::Diff::LoadPackage");
+        Package = LoadPackage(nullptr, FPackagePath::FromLocalPath(TempFilename), LOAD_ForDiff | LOAD_DisableCompileOnLoad);
+    }
+    UBlueprint* Saved = Package ? FindObject<UBlueprint>(Package, *Blueprint->GetName()) : nullptr;
+    if (Package)
+    {
+        ResetLoaders(Package);
+    }
+    IFileManager::Get().Delete(*TempFilename, /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+
+    if (!Saved)
+    {
+        OutError = FString::Printf(TEXT("Could not load the saved revision of '%s'."), *PackageName);
+        return nullptr;
+    }
+
+    FSavedRevision& Revision = SavedRevisions.Add(PackageName);
+    Revision.Blueprint = Saved;
+    Revision.Timestamp = Timestamp;
+    return Saved;
+}
+
+void FMcpBlueprintDiff::Release(FSavedRevision& Revision)
+{
+    // Loaded assets are RF_Standalone; clear it so the next GC can collect the diff package.
+    if (Revision.Blueprint)
+    {
+        ForEachObjectWithPackage(Revision.Blueprint->GetOutermost(), [](UObject* Object)
+        {
+            Object->ClearFlags(RF_Standalone);
+            return true;
+        });
+    }
+    Revision.Blueprint = nullptr;
+}
+
+void FMcpBlueprintDiff::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (TPair<FString, FSavedRevision>& Pair : SavedRevisions)
+    {
+        Collector.AddReferencedObject(Pair.Value.Blueprint);
+    }
+}
@@ -0,0 +1,919 @@
+#include "McpBulkRefactor.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintCompilationManager.h"
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/Engine.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "GameFramework/Actor.h"
+#include "Json.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_Variable.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "McpTimeSlicer.h"
+#include "McpTrace.h"
+#include "Misc/PackageName.h"
+#include "ScopedTransaction.h"
+#include "UObject/Package.h"
+
+namespace McpBulkRefactor
+{
+    // Finished jobs kept for get_refactor_status.
+    static constexpr int32 MaxFinishedJobs = 8;
+
+    static const TCHAR* OpNames[] = { TEXT("replace_function_call"), TEXT("rename_variable"), TEXT("retarget_class"), TEXT("replace_component_class") };
+
+    static FString NodeGuidString(const UEdGraphNode* Node)
+    {
+        return Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens);
+    }
+
+    static bool HasUserDefault(const UEdGraphPin* Pin)
+    {
+        return Pin->Direction == EGPD_Input && !Pin->DoesDefaultValueMatchAutogenerated();
+    }
+
+    static bool IsUnderRoots(const FString& PackageName, const TArray<FString>& Roots)
+    {
+        if (Roots.Num() == 0)
+        {
+            return true;
+        }
+        for (const FString& Root : Roots)
+        {
+            if (PackageName == Root || PackageName.StartsWith(Root.EndsWith(TEXT("/")) ? Root : Root + TEXT("/")))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+FMcpBulkRefactor::~FMcpBulkRefactor()
+{
+    CancelAll();
+}
+
+bool FMcpBulkRefactor::ParseOp(const FString& Name, EMcpRefactorOp& OutOp)
+{
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(McpBulkRefactor::OpNames); ++Index)
+    {
+        if (Name == McpBulkRefactor::OpNames[Index])
+        {
+            OutOp = (EMcpRefactorOp)Index;
+            return true;
+        }
+    }
+    return false;
+}
+
+const TCHAR* FMcpBulkRefactor::GetOpName(EMcpRefactorOp Op)
+{
+    return McpBulkRefactor::OpNames[(int32)Op];
+}
+
+bool FMcpBulkRefactor::Start(const FMcpRefactorSpec& InSpec, int32& OutJobId, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Refactor::Start");
+
+    if (const FJob* Active = GetActiveJob())
+    {
+        OutError = FString::Printf(TEXT("Bulk refactor job %d is still running."), Active->Id);
+        return false;
+    }
+
+    TUniquePtr<FJob> Job = MakeUnique<FJob>();
+    Job->Spec = InSpec;
+    const FMcpRefactorSpec& Spec = Job->Spec;
+
+    switch (Spec.Op)
+    {
+    case EMcpRefactorOp::ReplaceFunctionCall:
+        if (!Spec.FromFunction || !Spec.ToFunction || Spec.FromFunction == Spec.ToFunction)
+        {
+            OutError = TEXT("replace_function_call needs two different functions.");
+            return false;
+        }
+        break;
+
+    case EMcpRefactorOp::RenameVariable:
+        if (!Spec.Owner || !Spec.Owner->GeneratedClass || Spec.FromVariable.IsNone() || Spec.ToVariable.IsNone())
+        {
+            OutError = TEXT("rename_variable needs a compiled Blueprint and both variable names.");
+            return false;
+        }
+        if (FBlueprintEditorUtils::FindNewVariableIndex(Spec.Owner, Spec.FromVariable) == INDEX_NONE)
+        {
+            OutError = FString::Printf(TEXT("'%s' has no member variable '%s'."), *Spec.Owner->GetPathName(), *Spec.FromVariable.ToString());
+            return false;
+        }
+        if (FBlueprintEditorUtils::FindNewVariableIndex(Spec.Owner, Spec.ToVariable) != INDEX_NONE)
+        {
+            OutError = FString::Printf(TEXT("'%s' already has a variable named '%s'."), *Spec.Owner->GetPathName(), *Spec.ToVariable.ToString());
+            return false;
+        }
+        break;
+
+    case EMcpRefactorOp::RetargetClass:
+    case EMcpRefactorOp::ReplaceComponentClass:
+        if (!Spec.FromClass || !Spec.ToClass || Spec.FromClass == Spec.ToClass)
+        {
+            OutError = TEXT("Retargeting needs two different classes.");
+            return false;
+        }
+        if (Spec.Op == EMcpRefactorOp::ReplaceComponentClass
+            && (!Spec.FromClass->IsChildOf(UActorComponent::StaticClass()) || !Spec.ToClass->IsChildOf(UActorComponent::StaticClass())
+                || Spec.ToClass->HasAnyClassFlags(CLASS_Abstract)))
+        {
+            OutError = TEXT("replace_component_class needs two component classes and a non-abstract replacement.");
+            return false;
+        }
+        break;
+    }
+
+    if (!FindCandidates(*Job, OutError))
+    {
+        return false;
+    }
+
+    if (Spec.Op == EMcpRefactorOp::ReplaceFunctionCall)
+    {
+        Job->ProbeNode = CreateProbeNode(Spec.ToFunction);
+        if (!Job->ProbeNode)
+        {
+            OutError = TEXT("Failed to create the scratch Blueprint for replace_function_call.");
+            return false;
+        }
+    }
+
+    Job->Id = NextJobId++;
+    Job->StartTime = FPlatformTime::Seconds();
+    OutJobId = ActiveJobId = Job->Id;
+
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Bulk refactor %d (%s%s) over %d Blueprints."),
+        Job->Id, GetOpName(Spec.Op), Spec.bDryRun ? TEXT(", dry run") : TEXT(""), Job->Candidates.Num());
+    Jobs.Add(MoveTemp(Job));
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMcpBulkRefactor::Tick));
+    return true;
+}
+
+bool FMcpBulkRefactor::FindCandidates(FJob& Job, FString& OutError) const
+{
+    MCP_TRACE_SCOPE("Mcp::Refactor::FindCandidates");
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        OutError = TEXT("The asset registry is still scanning; retry once it has finished.");
+        return false;
+    }
+
+    const FMcpRefactorSpec& Spec = Job.Spec;
+    const UObject* Target = nullptr;
+    switch (Spec.Op)
+    {
+    case EMcpRefactorOp::ReplaceFunctionCall: Target = Spec.FromFunction; break;
+    case EMcpRefactorOp::RenameVariable: Target = Spec.Owner; break;
+    default: Target = Spec.FromClass; break;
+    }
+
+    TArray<FAssetData> AssetDatas;
+    const FName TargetPackage = Target->GetOutermost()->GetFName();
+    if (FPackageName::IsScriptPackage(TargetPackage.ToString()))
+    {
+        // Native targets are referenced through their module's script package, which is far too
+        // coarse to be useful, so every Blueprint under the roots is a candidate.
+        FARFilter Filter;
+        Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+        Filter.bRecursiveClasses = true;
+        for (const FString& Root : Spec.Roots)
+        {
+            Filter.PackagePaths.Emplace(*Root);
+        }
+        if (Filter.PackagePaths.Num() == 0)
+        {
+            Filter.PackagePaths.Add(TEXT("/Game"));
+        }
+        Filter.bRecursivePaths = true;
+        AssetRegistry.GetAssets(Filter, AssetDatas);
+    }
+    else
+    {
+        TArray<FName> Packages;
+        AssetRegistry.GetReferencers(TargetPackage, Packages, UE::AssetRegistry::EDependencyCategory::Package);
+        Packages.AddUnique(TargetPackage);
+        for (const FName& Package : Packages)
+        {
+            if (McpBulkRefactor::IsUnderRoots(Package.ToString(), Spec.Roots))
+            {
+                AssetRegistry.GetAssetsByPackageName(Package, AssetDatas);
+            }
+        }
+    }
+
+    for (const FAssetData& Data : AssetDatas)
+    {
+        if (Data.IsInstanceOf(UBlueprint::StaticClass()))
+        {
+            Job.Candidates.AddUnique(Data.GetObjectPathString());
+        }
+    }
+    return true;
+}
+
+bool FMcpBulkRefactor::Cancel(int32 JobId, FString& OutError)
+{
+    FJob* Job = GetActiveJob();
+    if (!Job || Job->Id != JobId)
+    {
+        OutError = FindJob(JobId) ? FString::Printf(TEXT("Job %d is not running."), JobId) : FString::Printf(TEXT("Unknown job %d."), JobId);
+        return false;
+    }
+
+    Job->bCancelRequested = true;
+    return true;
+}
+
+void FMcpBulkRefactor::CancelAll()
+{
+    FJob* Job = GetActiveJob();
+    if (!Job)
+    {
+        return;
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    Job->bCancelRequested = true;
+    if (Job->Phase <= EPhase::Compile)
+    {
+        CompileEdited(*Job);
+    }
+    Finish(*Job, EStatus::Cancelled);
+}
+
+bool FMcpBulkRefactor::Tick(float DeltaTime)
+{
+    MCP_TRACE_SCOPE("Mcp::Refactor::Tick");
+
+    FJob* Job = GetActiveJob();
+    if (!Job)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    // At least one Blueprint per tick, then as many as fit the slicer's frame budget.
+    const double Deadline = FPlatformTime::Seconds() + FMcpTimeSlicer::GetFrameBudgetSeconds();
+    switch (Job->Phase)
+    {
+    case EPhase::Edit:
+        while (!Job->bCancelRequested && Job->NextCandidate < Job->Candidates.Num())
+        {
+            ProcessBlueprint(*Job, Job->Candidates[Job->NextCandidate++]);
+            if (FPlatformTime::Seconds() >= Deadline)
+            {
+                break;
+            }
+        }
+        if (Job->bCancelRequested || Job->NextCandidate >= Job->Candidates.Num())
+        {
+            Job->Phase = EPhase::Compile;
+        }
+        return true;
+
+    case EPhase::Compile:
+        CompileEdited(*Job);
+        Job->Phase = Job->Spec.bSave && !Job->Spec.bDryRun && !Job->bCancelRequested ? EPhase::Save : EPhase::Done;
+        return true;
+
+    case EPhase::Save:
+        while (!Job->bCancelRequested && Job->NextSave < Job->Results.Num())
+        {
+            FBlueprintResult& Result = Job->Results[Job->NextSave++];
+            if (!Result.bCompiled || !Result.Error.IsEmpty())
+            {
+                continue;
+            }
+            FString SaveError;
+            Result.bSaved = FMcpBlueprintMutator::SaveBlueprint(Result.Blueprint, SaveError);
+            if (!Result.bSaved)
+            {
+                Result.Error = SaveError;
+                ++Job->NumFailed;
+            }
+            if (FPlatformTime::Seconds() >= Deadline)
+            {
+                break;
+            }
+        }
+        if (Job->bCancelRequested || Job->NextSave >= Job->Results.Num())
+        {
+            Job->Phase = EPhase::Done;
+        }
+        return true;
+
+    default:
+        break;
+    }
+
+    TickerHandle.Reset();
+    Finish(*Job, Job->bCancelRequested ? EStatus::Cancelled : EStatus::Finished);
+    return false;
+}
+
+void FMcpBulkRefactor::ProcessBlueprint(FJob& Job, const FString& AssetPath)
+{
+    MCP_TRACE_SCOPE("Mcp::Refactor::Blueprint");
+
+    UBlueprint* Blueprint = nullptr;
+    {
+        MCP_TRACE_SCOPE("Mcp::LoadObject");
+        Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+    }
+
+    FBlueprintResult Result;
+    Result.AssetPath = AssetPath;
+    if (!Blueprint)
+    {
+        Result.Error = TEXT("Failed to load Blueprint");
+    }
+    else if (Plan(Job, Blueprint, /*bApply=*/false, Result.Edits, Result.Error) && Result.Edits.Num() > 0 && !Job.Spec.bDryRun)
+    {
+        // The plan above checked everything it can, but the apply pass still checks each step; a
+        // Blueprint it fails on is rolled back and never compiled or saved.
+        const int32 UndoQueueBefore = GEditor && GEditor->Trans ? GEditor->Trans->GetQueueLength() : INDEX_NONE;
+        bool bApplied = false;
+        {
+            FScopedTransaction Transaction(NSLOCTEXT("BlueprintMCP", "BulkRefactor", "Bulk Refactor"));
+            Blueprint->Modify();
+
+            TArray<FMcpGraphEdit> Applied;
+            bApplied = Plan(Job, Blueprint, /*bApply=*/true, Applied, Result.Error);
+            FMcpBlueprintMutator::MarkStructurallyModified(Blueprint);
+        }
+
+        // Only undo when this transaction was actually recorded, so nothing older is reverted.
+        if (!bApplied && UndoQueueBefore != INDEX_NONE && GEditor->Trans->GetQueueLength() > UndoQueueBefore)
+        {
+            GEditor->UndoTransaction(/*bCanRedo=*/false);
+        }
+        else if (!bApplied)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[MCP] Bulk refactor %d could not roll back '%s'; it is left edited but will not be compiled or saved: %s"),
+                Job.Id, *AssetPath, *Result.Error);
+        }
+
+        Result.Blueprint = Blueprint;
+        Result.bApplied = bApplied;
+    }
+
+    if (!Result.Error.IsEmpty())
+    {
+        ++Job.NumFailed;
+    }
+    else if (Result.Edits.Num() == 0)
+    {
+        return;
+    }
+    else
+    {
+        Job.NumEdits += Result.Edits.Num();
+    }
+    Job.Results.Add(MoveTemp(Result));
+}
+
+bool FMcpBulkRefactor::Plan(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const
+{
+    switch (Job.Spec.Op)
+    {
+    case EMcpRefactorOp::ReplaceFunctionCall: return PlanReplaceFunctionCall(Job, Blueprint, bApply, OutEdits, OutError);
+    case EMcpRefactorOp::RenameVariable: return PlanRenameVariable(Job, Blueprint, bApply, OutEdits, OutError);
+    case EMcpRefactorOp::RetargetClass: return PlanRetargetClass(Job, Blueprint, bApply, OutEdits, OutError);
+    case EMcpRefactorOp::ReplaceComponentClass: return PlanReplaceComponentClass(Job, Blueprint, bApply, OutEdits, OutError);
+    }
+    return false;
+}
+
+bool FMcpBulkRefactor::PlanReplaceFunctionCall(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const
+{
+    const FMcpRefactorSpec& Spec = Job.Spec;
+    const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+    const UClass* FromOwner = Spec.FromFunction->GetOwnerClass()->GetAuthoritativeClass();
+    const FString Change = FString::Printf(TEXT("%s -> %s"), *Spec.FromFunction->GetName(), *Spec.ToFunction->GetName());
+
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+    for (UEdGraph* Graph : Graphs)
+    {
+        TArray<UK2Node_CallFunction*> Nodes;
+        Graph->GetNodesOfClass(Nodes);
+        for (UK2Node_CallFunction* Node : Nodes)
+        {
+            const UFunction* Function = Node->FunctionReference.GetMemberName() == Spec.FromFunction->GetFName() ? Node->GetTargetFunction() : nullptr;
+            if (!Function || Function->GetOwnerClass()->GetAuthoritativeClass() != FromOwner)
+            {
+                continue;
+            }
+
+            const FString NodeGuid = McpBulkRefactor::NodeGuidString(Node);
+            OutEdits.Add({ TEXT("replace_call"), NodeGuid, FString::Printf(TEXT("%s: %s"), *Graph->GetName(), *Change) });
+
+            if (!bApply)
+            {
+                TArray<TPair<UEdGraphPin*, UEdGraphPin*>> PinMoves;
+                if (!MatchCallPins(Job, Node, Job.ProbeNode, PinMoves, &OutEdits, OutError))
+                {
+                    OutError = FString::Printf(TEXT("Node %s in graph '%s': %s"), *NodeGuid, *Graph->GetName(), *OutError);
+                    return false;
+                }
+                continue;
+            }
+
+            // The real node's pins can differ from the probe's with the graph's context, so they are matched again.
+            UK2Node_CallFunction* NewNode = NewObject<UK2Node_CallFunction>(Graph);
+            NewNode->SetFromFunction(Spec.ToFunction);
+            NewNode->AllocateDefaultPins();
+
+            TArray<TPair<UEdGraphPin*, UEdGraphPin*>> PinMoves;
+            if (!MatchCallPins(Job, Node, NewNode, PinMoves, nullptr, OutError))
+            {
+                NewNode->MarkAsGarbage();
+                OutError = FString::Printf(TEXT("Node %s in graph '%s': %s"), *NodeGuid, *Graph->GetName(), *OutError);
+                return false;
+            }
+
+            Graph->Modify();
+            NewNode->CreateNewGuid();
+            NewNode->SetFlags(RF_Transactional);
+            NewNode->NodePosX = Node->NodePosX;
+            NewNode->NodePosY = Node->NodePosY;
+            Graph->AddNode(NewNode, /*bFromUI=*/false, /*bSelectNewNode=*/false);
+
+            for (const TPair<UEdGraphPin*, UEdGraphPin*>& Move : PinMoves)
+            {
+                UEdGraphPin* Pin = Move.Key;
+                UEdGraphPin* NewPin = Move.Value;
+                if (Pin->LinkedTo.Num() == 0)
+                {
+                    NewPin->DefaultValue = Pin->DefaultValue;
+                    NewPin->DefaultObject = Pin->DefaultObject;
+                    NewPin->DefaultTextValue = Pin->DefaultTextValue;
+                    continue;
+                }
+
+                // MovePinLinks breaks every link first and only remakes the ones it can, so anything short of a clean move lost a wire.
+                const FPinConnectionResponse Response = Schema->MovePinLinks(*Pin, *NewPin);
+                if (!Response.CanSafeConnect())
+                {
+                    OutError = FString::Printf(TEXT("Node %s in graph '%s': links of pin '%s' could not be moved: %s"),
+                        *NodeGuid, *Graph->GetName(), *Pin->PinName.ToString(), *Response.Message.ToString());
+                    return false;
+                }
+            }
+
+            FBlueprintEditorUtils::RemoveNode(Blueprint, Node, /*bDontRecompile=*/true);
+        }
+    }
+    return true;
+}
+
+bool FMcpBulkRefactor::MatchCallPins(const FJob& Job, UEdGraphNode* Node, UK2Node_CallFunction* Replacement, TArray<TPair<UEdGraphPin*, UEdGraphPin*>>& OutMoves, TArray<FMcpGraphEdit>* OutEdits, FString& OutError) const
+{
+    const FMcpRefactorSpec& Spec = Job.Spec;
+    const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+    const FString NodeGuid = McpBulkRefactor::NodeGuidString(Node);
+
+    // Every connected pin needs a counterpart that accepts all of its links; defaults without one are dropped and reported.
+    for (UEdGraphPin* Pin : Node->Pins)
+    {
+        if (!Pin || (Pin->LinkedTo.Num() == 0 && !McpBulkRefactor::HasUserDefault(Pin)))
+        {
+            continue;
+        }
+
+        const FName* Mapped = Spec.PinMap.Find(Pin->PinName);
+        const FName NewName = Mapped ? *Mapped : Pin->PinName;
+        UEdGraphPin* NewPin = Replacement->FindPin(NewName, Pin->Direction);
+        if (!NewPin)
+        {
+            if (Pin->LinkedTo.Num() > 0)
+            {
+                OutError = FString::Printf(TEXT("pin '%s' is connected but %s has no matching pin; map it with 'pin_map'."),
+                    *Pin->PinName.ToString(), *Spec.ToFunction->GetName());
+                return false;
+            }
+            if (OutEdits)
+            {
+                OutEdits->Add({ TEXT("drop_default"), NodeGuid, Pin->PinName.ToString() });
+            }
+            continue;
+        }
+
+        for (UEdGraphPin* Linked : Pin->LinkedTo)
+        {
+            // Linked is still wired to the old pin here; replacing exactly that link is what the move does.
+            const FPinConnectionResponse Response = Schema->CanCreateConnection(NewPin, Linked);
+            if (Response.Response != CONNECT_RESPONSE_MAKE
+                && Response.Response != CONNECT_RESPONSE_BREAK_OTHERS_A
+                && Response.Response != CONNECT_RESPONSE_BREAK_OTHERS_B
+                && Response.Response != CONNECT_RESPONSE_BREAK_OTHERS_AB)
+            {
+                OutError = FString::Printf(TEXT("pin '%s' cannot keep its link to '%s': %s"),
+                    *NewName.ToString(), *Linked->PinName.ToString(), *Response.Message.ToString());
+                return false;
+            }
+        }
+
+        if (Pin->LinkedTo.Num() == 0)
+        {
+            const FString DefaultError = Schema->IsPinDefaultValid(NewPin, Pin->DefaultValue, Pin->DefaultObject, Pin->DefaultTextValue);
+            if (!DefaultError.IsEmpty())
+            {
+                OutError = FString::Printf(TEXT("default of pin '%s' is not valid for '%s': %s"), *Pin->PinName.ToString(), *NewName.ToString(), *DefaultError);
+                return false;
+            }
+        }
+
+        if (OutEdits && NewName != Pin->PinName)
+        {
+            OutEdits->Add({ TEXT("remap_pin"), NodeGuid, FString::Printf(TEXT("%s -> %s"), *Pin->PinName.ToString(), *NewName.ToString()) });
+        }
+        OutMoves.Emplace(Pin, NewPin);
+    }
+    return true;
+}
+
+UK2Node_CallFunction* FMcpBulkRefactor::CreateProbeNode(UFunction* Function)
+{
+    UBlueprint* Scratch = FKismetEditorUtilities::CreateBlueprint(
+        AActor::StaticClass(),
+        GetTransientPackage(),
+        MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("McpRefactorScratch")),
+        BPTYPE_Normal,
+        UBlueprint::StaticClass(),
+        UBlueprintGeneratedClass::StaticClass());
+    if (!Scratch || Scratch->UbergraphPages.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    UK2Node_CallFunction* Probe = NewObject<UK2Node_CallFunction>(Scratch->UbergraphPages[0]);
+    Probe->SetFromFunction(Function);
+    Probe->AllocateDefaultPins();
+    return Probe;
+}
+
+void FMcpBulkRefactor::DiscardProbeNode(FJob& Job)
+{
+    if (!Job.ProbeNode)
+    {
+        return;
+    }
+
+    if (UBlueprint* Scratch = Job.ProbeNode->GetTypedOuter<UBlueprint>())
+    {
+        Scratch->ClearFlags(RF_Standalone | RF_Public);
+        Scratch->MarkAsGarbage();
+    }
+    Job.ProbeNode = nullptr;
+}
+
+bool FMcpBulkRefactor::PlanRenameVariable(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const
+{
+    const FMcpRefactorSpec& Spec = Job.Spec;
+    const UClass* OwnerClass = Spec.Owner->GeneratedClass->GetAuthoritativeClass();
+    const bool bIsOwner = Blueprint == Spec.Owner;
+    const FString Change = FString::Printf(TEXT("%s -> %s"), *Spec.FromVariable.ToString(), *Spec.ToVariable.ToString());
+
+    if (bIsOwner)
+    {
+        if (FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, Spec.FromVariable) == INDEX_NONE)
+        {
+            OutError = FString::Printf(TEXT("Variable '%s' no longer exists."), *Spec.FromVariable.ToString());
+            return false;
+        }
+        OutEdits.Add({ TEXT("rename_variable"), Spec.FromVariable.ToString(), Change });
+    }
+
+    // Getters and setters, including ones reading the variable through another object.
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+    for (UEdGraph* Graph : Graphs)
+    {
+        TArray<UK2Node_Variable*> Nodes;
+        Graph->GetNodesOfClass(Nodes);
+        for (const UK2Node_Variable* Node : Nodes)
+        {
+            if (Node->GetVarName() != Spec.FromVariable)
+            {
+                continue;
+            }
+            const UClass* Scope = Node->VariableReference.GetMemberParentClass(Node->GetBlueprintClassFromNode());
+            if (Scope && Scope->GetAuthoritativeClass()->IsChildOf(OwnerClass))
+            {
+                OutEdits.Add({ TEXT("rename_reference"), McpBulkRefactor::NodeGuidString(Node), FString::Printf(TEXT("%s: %s"), *Graph->GetName(), *Change) });
+            }
+        }
+    }
+
+    if (bApply)
+    {
+        if (bIsOwner)
+        {
+            FBlueprintEditorUtils::RenameMemberVariable(Blueprint, Spec.FromVariable, Spec.ToVariable);
+        }
+        else if (OutEdits.Num() > 0)
+        {
+            FBlueprintEditorUtils::RenameVariableReferences(Blueprint, Spec.Owner->GeneratedClass, Spec.FromVariable, Spec.ToVariable);
+        }
+    }
+    return true;
+}
+
+bool FMcpBulkRefactor::PlanRetargetClass(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const
+{
+    const FMcpRefactorSpec& Spec = Job.Spec;
+    const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+    const FString Change = FString::Printf(TEXT("%s -> %s"), *Spec.FromClass->GetName(), *Spec.ToClass->GetName());
+
+    if (Spec.bReparent && Blueprint->ParentClass == Spec.FromClass)
+    {
+        if (Blueprint->GeneratedClass && Spec.ToClass->IsChildOf(Blueprint->GeneratedClass))
+        {
+            OutError = FString::Printf(TEXT("Cannot reparent to '%s', which derives from the Blueprint itself."), *Spec.ToClass->GetName());
+            return false;
+        }
+        OutEdits.Add({ TEXT("reparent"), Blueprint->GetName(), Change });
+        if (bApply)
+        {
+            Blueprint->ParentClass = Spec.ToClass;
+        }
+    }
+
+    TArray<FName> Variables;
+    for (const FBPVariableDescription& Variable : Blueprint->NewVariables)
+    {
+        if (Variable.VarType.PinSubCategoryObject == Spec.FromClass)
+        {
+            Variables.Add(Variable.VarName);
+            OutEdits.Add({ TEXT("change_variable_type"), Variable.VarName.ToString(), Change });
+        }
+    }
+    if (bApply)
+    {
+        for (const FName& VarName : Variables)
+        {
+            FEdGraphPinType NewType = Blueprint->NewVariables[FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, VarName)].VarType;
+            NewType.PinSubCategoryObject = Spec.ToClass;
+            FBlueprintEditorUtils::ChangeMemberVariableType(Blueprint, VarName, NewType);
+        }
+    }
+
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+    for (UEdGraph* Graph : Graphs)
+    {
+        TArray<UEdGraphNode*> Nodes(Graph->Nodes);
+        for (UEdGraphNode* Node : Nodes)
+        {
+            if (!Node)
+            {
+                continue;
+            }
+
+            UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node);
+            if (CastNode && CastNode->TargetType == Spec.FromClass)
+            {
+                OutEdits.Add({ TEXT("retarget_cast"), McpBulkRefactor::NodeGuidString(Node), FString::Printf(TEXT("%s: %s"), *Graph->GetName(), *Change) });
+                if (bApply)
+                {
+                    CastNode->Modify();
+                    CastNode->TargetType = Spec.ToClass;
+                    CastNode->ReconstructNode();
+                }
+            }
+
+            // Class pins such as SpawnActor's and literal class defaults.
+            for (UEdGraphPin* Pin : Node->Pins)
+            {
+                if (Pin && Pin->Direction == EGPD_Input && Pin->LinkedTo.Num() == 0 && Pin->DefaultObject == Spec.FromClass)
+                {
+                    OutEdits.Add({ TEXT("set_pin_default"), McpBulkRefactor::NodeGuidString(Node), FString::Printf(TEXT("%s.%s: %s"), *Graph->GetName(), *Pin->PinName.ToString(), *Change) });
+                    if (bApply)
+                    {
+                        Schema->TrySetDefaultObject(*Pin, Spec.ToClass);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool FMcpBulkRefactor::PlanReplaceComponentClass(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const
+{
+    const FMcpRefactorSpec& Spec = Job.Spec;
+    USimpleConstructionScript* SCS = Blueprint->SimpleConstructionScript;
+    if (!SCS)
+    {
+        return true;
+    }
+
+    const FString Change = FString::Printf(TEXT("%s -> %s"), *Spec.FromClass->GetName(), *Spec.ToClass->GetName());
+    for (USCS_Node* Node : SCS->GetAllNodes())
+    {
+        if (!Node || Node->ComponentClass != Spec.FromClass)
+        {
+            continue;
+        }
+        if (Node->GetChildNodes().Num() > 0 && !Spec.ToClass->IsChildOf(USceneComponent::StaticClass()))
+        {
+            OutError = FString::Printf(TEXT("Component '%s' has children, so '%s' must be a scene component."), *Node->GetVariableName().ToString(), *Spec.ToClass->GetName());
+            return false;
+        }
+        OutEdits.Add({ TEXT("replace_component"), Node->GetVariableName().ToString(), Change });
+
+        if (!bApply)
+        {
+            continue;
+        }
+
+        // The new template takes over the old one's name and every property the two classes share.
+        SCS->Modify();
+        Node->Modify();
+        UActorComponent* OldTemplate = Node->ComponentTemplate;
+        UObject* Outer = OldTemplate ? OldTemplate->GetOuter() : Blueprint->GeneratedClass.Get();
+        const FName TemplateName = OldTemplate ? OldTemplate->GetFName() : NAME_None;
+        if (OldTemplate)
+        {
+            OldTemplate->Modify();
+            OldTemplate->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors);
+        }
+
+        UActorComponent* NewTemplate = NewObject<UActorComponent>(Outer, Spec.ToClass, TemplateName, RF_ArchetypeObject | RF_Public | RF_Transactional);
+        if (OldTemplate)
+        {
+            UEngine::CopyPropertiesForUnrelatedObjects(OldTemplate, NewTemplate);
+        }
+        Node->ComponentClass = Spec.ToClass;
+        Node->ComponentTemplate = NewTemplate;
+    }
+    return true;
+}
+
+void FMcpBulkRefactor::CompileEdited(FJob& Job)
+{
+    MCP_TRACE_SCOPE("Mcp::Refactor::Compile");
+
+    // One queue flush compiles every edited Blueprint in dependency order and reinstances once.
+    bool bQueued = false;
+    for (const FBlueprintResult& Result : Job.Results)
+    {
+        if (Result.bApplied)
+        {
+            FBlueprintCompilationManager::QueueForCompilation(Result.Blueprint);
+            bQueued = true;
+        }
+    }
+    if (!bQueued)
+    {
+        return;
+    }
+    FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+
+    for (FBlueprintResult& Result : Job.Results)
+    {
+        if (!Result.bApplied)
+        {
+            continue;
+        }
+        Result.bCompiled = Result.Blueprint->Status != EBlueprintStatus::BS_Error;
+        if (!Result.bCompiled && Result.Error.IsEmpty())
+        {
+            Result.Error = TEXT("Compile failed.");
+            ++Job.NumFailed;
+        }
+    }
+}
+
+void FMcpBulkRefactor::Finish(FJob& Job, EStatus InStatus)
+{
+    Job.Status = InStatus;
+    Job.Phase = EPhase::Done;
+    Job.EndTime = FPlatformTime::Seconds();
+    for (FBlueprintResult& Result : Job.Results)
+    {
+        Result.Blueprint = nullptr;
+    }
+    DiscardProbeNode(Job);
+    ActiveJobId = INDEX_NONE;
+
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Bulk refactor %d %s after %.2fs: %d edits in %d Blueprints, %d failed."),
+        Job.Id, InStatus == EStatus::Finished ? TEXT("finished") : TEXT("cancelled"), Job.EndTime - Job.StartTime, Job.NumEdits, Job.Results.Num(), Job.NumFailed);
+
+    if (Jobs.Num() > McpBulkRefactor::MaxFinishedJobs)
+    {
+        Jobs.RemoveAt(0, Jobs.Num() - McpBulkRefactor::MaxFinishedJobs);
+    }
+}
+
+const FMcpBulkRefactor::FJob* FMcpBulkRefactor::FindJob(int32 JobId) const
+{
+    const TUniquePtr<FJob>* Found = Jobs.FindByPredicate([JobId](const TUniquePtr<FJob>& Job) { return Job->Id == JobId; });
+    return Found ? Found->Get() : nullptr;
+}
+
+FMcpBulkRefactor::FJob* FMcpBulkRefactor::GetActiveJob()
+{
+    return ActiveJobId != INDEX_NONE ? const_cast<FJob*>(FindJob(ActiveJobId)) : nullptr;
+}
+
+void FMcpBulkRefactor::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (TUniquePtr<FJob>& Job : Jobs)
+    {
+        FMcpRefactorSpec& Spec = Job->Spec;
+        Collector.AddReferencedObject(Spec.FromFunction);
+        Collector.AddReferencedObject(Spec.ToFunction);
+        Collector.AddReferencedObject(Spec.Owner);
+        Collector.AddReferencedObject(Spec.FromClass);
+        Collector.AddReferencedObject(Spec.ToClass);
+        Collector.AddReferencedObject(Job->ProbeNode);
+        for (FBlueprintResult& Result : Job->Results)
+        {
+            Collector.AddReferencedObject(Result.Blueprint);
+        }
+    }
+}
+
+TSharedPtr<FJsonObject> FMcpBulkRefactor::BuildJobJson(int32 JobId) const
+{
+    static const TCHAR* StatusNames[] = { TEXT("running"), TEXT("finished"), TEXT("cancelled") };
+    static const TCHAR* PhaseNames[] = { TEXT("edit"), TEXT("compile"), TEXT("save"), TEXT("done") };
+
+    const FJob* Job = FindJob(JobId);
+    if (!Job)
+    {
+        return nullptr;
+    }
+
+    TSharedRef<FJsonObject> JobObj = MakeShared<FJsonObject>();
+    JobObj->SetNumberField(TEXT("job_id"), Job->Id);
+    JobObj->SetStringField(TEXT("op"), GetOpName(Job->Spec.Op));
+    JobObj->SetStringField(TEXT("status"), Job->Status == EStatus::Running && Job->bCancelRequested ? TEXT("cancelling") : StatusNames[(int32)Job->Status]);
+    JobObj->SetStringField(TEXT("phase"), PhaseNames[(int32)Job->Phase]);
+    JobObj->SetBoolField(TEXT("dry_run"), Job->Spec.bDryRun);
+    JobObj->SetNumberField(TEXT("candidates"), Job->Candidates.Num());
+    JobObj->SetNumberField(TEXT("scanned"), Job->NextCandidate);
+    JobObj->SetNumberField(TEXT("edit_count"), Job->NumEdits);
+    JobObj->SetNumberField(TEXT("failed"), Job->NumFailed);
+    JobObj->SetNumberField(TEXT("elapsed_s"), (Job->Status == EStatus::Running ? FPlatformTime::Seconds() : Job->EndTime) - Job->StartTime);
+
+    TArray<TSharedPtr<FJsonValue>> BlueprintArray;
+    for (const FBlueprintResult& Result : Job->Results)
+    {
+        TSharedRef<FJsonObject> BlueprintObj = MakeShared<FJsonObject>();
+        BlueprintObj->SetStringField(TEXT("asset_path"), Result.AssetPath);
+        if (!Job->Spec.bDryRun)
+        {
+            BlueprintObj->SetBoolField(TEXT("applied"), Result.bApplied);
+            BlueprintObj->SetBoolField(TEXT("compiled"), Result.bCompiled);
+            if (Job->Spec.bSave)
+            {
+                BlueprintObj->SetBoolField(TEXT("saved"), Result.bSaved);
+            }
+        }
+        if (!Result.Error.IsEmpty())
+        {
+            BlueprintObj->SetStringField(TEXT("error"), Result.Error);
+        }
+
+        TArray<TSharedPtr<FJsonValue>> EditArray;
+        for (const FMcpGraphEdit& Edit : Result.Edits)
+        {
+            TSharedRef<FJsonObject> EditObj = MakeShared<FJsonObject>();
+            EditObj->SetStringField(TEXT("op"), Edit.Op);
+            EditObj->SetStringField(TEXT("target"), Edit.Target);
+            if (!Edit.Detail.IsEmpty())
+            {
+                EditObj->SetStringField(TEXT("detail"), Edit.Detail);
+            }
+            EditArray.Add(MakeShared<FJsonValueObject>(EditObj));
+        }
+        BlueprintObj->SetArrayField(TEXT("edits"), EditArray);
+        BlueprintArray.Add(MakeShared<FJsonValueObject>(BlueprintObj));
+    }
+    JobObj->SetArrayField(TEXT("blueprints"), BlueprintArray);
+    return JobObj;
+}
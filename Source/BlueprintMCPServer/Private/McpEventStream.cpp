@@ -0,0 +1,499 @@
+#include "McpEventStream.h"
+
+#include "Algo/Reverse.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintInspector.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HttpServerResponse.h"
+#include "Json.h"
+#include "McpTrace.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace McpEventStream
+{
+    static constexpr double CoalesceWindowSeconds = 0.25;
+    static constexpr double MaxCoalesceDelaySeconds = 1.0;
+    static constexpr double DefaultTimeoutSeconds = 25.0;
+    static constexpr double MaxTimeoutSeconds = 60.0;
+    static constexpr int32 MaxHistory = 1024;
+    static constexpr int32 RetryMilliseconds = 250;
+
+    struct FEventTypeName
+    {
+        EMcpEventType Type;
+        const TCHAR* Name;
+    };
+
+    static const FEventTypeName EventTypeNames[] =
+    {
+        { EMcpEventType::BlueprintCompiled, TEXT("blueprint_compiled") },
+        { EMcpEventType::BlueprintChanged, TEXT("blueprint_changed") },
+        { EMcpEventType::BlueprintSaved, TEXT("blueprint_saved") },
+        { EMcpEventType::AssetAdded, TEXT("asset_added") },
+        { EMcpEventType::AssetRemoved, TEXT("asset_removed") },
+        { EMcpEventType::AssetRenamed, TEXT("asset_renamed") },
+        { EMcpEventType::JobCompleted, TEXT("job_completed") },
+    };
+
+    static void SplitList(const FString& Value, TArray<FString>& OutItems)
+    {
+        Value.ParseIntoArray(OutItems, TEXT(","), true);
+        for (FString& Item : OutItems)
+        {
+            Item.TrimStartAndEndInline();
+        }
+    }
+
+    static FString ToPackageName(const FString& AssetPath)
+    {
+        int32 DotIndex = INDEX_NONE;
+        return AssetPath.FindChar(TEXT('.'), DotIndex) ? AssetPath.Left(DotIndex) : AssetPath;
+    }
+}
+
+FMcpEventStream::FMcpEventStream()
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FMcpEventStream::Tick), 0.05f);
+
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMcpEventStream::OnObjectModified);
+    PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FMcpEventStream::OnPackageSaved);
+
+    if (GEditor)
+    {
+        GEditor->OnBlueprintPreCompile().AddRaw(this, &FMcpEventStream::OnBlueprintPreCompile);
+        GEditor->OnBlueprintCompiled().AddRaw(this, &FMcpEventStream::OnBlueprintCompiled);
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.OnAssetAdded().AddRaw(this, &FMcpEventStream::OnAssetAdded);
+    AssetRegistry.OnAssetRemoved().AddRaw(this, &FMcpEventStream::OnAssetRemoved);
+    AssetRegistry.OnAssetRenamed().AddRaw(this, &FMcpEventStream::OnAssetRenamed);
+}
+
+FMcpEventStream::~FMcpEventStream()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+
+    if (GEditor)
+    {
+        GEditor->OnBlueprintPreCompile().RemoveAll(this);
+        GEditor->OnBlueprintCompiled().RemoveAll(this);
+    }
+
+    if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        AssetRegistry.OnAssetAdded().RemoveAll(this);
+        AssetRegistry.OnAssetRemoved().RemoveAll(this);
+        AssetRegistry.OnAssetRenamed().RemoveAll(this);
+    }
+
+    TArray<FSubscription> Remaining;
+    {
+        FScopeLock Lock(&Mutex);
+        Remaining = MoveTemp(Subscriptions);
+    }
+
+    const TArray<const FMcpEvent*> NoEvents;
+    for (const FSubscription& Subscription : Remaining)
+    {
+        CompleteSubscription(Subscription, NoEvents);
+    }
+}
+
+void FMcpEventStream::Publish(EMcpEventType Type, const FString& AssetPath, const FString& Detail, const FString& OldPath)
+{
+    if (AssetPath.IsEmpty() && Type != EMcpEventType::JobCompleted)
+    {
+        return;
+    }
+    if (Type != EMcpEventType::JobCompleted && FMcpBlueprintInspector::IsScratchPath(AssetPath))
+    {
+        return;
+    }
+
+    MCP_LLM_SCOPE();
+    const double Now = FPlatformTime::Seconds();
+    FScopeLock Lock(&Mutex);
+
+    // Job completions are discrete results, not state changes, so they skip coalescing.
+    if (Type == EMcpEventType::JobCompleted)
+    {
+        FMcpEvent& Event = History.AddDefaulted_GetRef();
+        Event.Id = NextEventId++;
+        Event.Types = Type;
+        Event.AssetPath = AssetPath;
+        Event.Detail = Detail;
+        Event.FirstTime = Now;
+        Event.LastTime = Now;
+        return;
+    }
+
+    FMcpEvent* Existing = Pending.Find(AssetPath);
+    if (!Existing)
+    {
+        Existing = &Pending.Add(AssetPath);
+        Existing->AssetPath = AssetPath;
+        Existing->FirstTime = Now;
+    }
+
+    Existing->Types |= Type;
+    Existing->LastTime = Now;
+    if (!Detail.IsEmpty())
+    {
+        Existing->Detail = Detail;
+    }
+    if (!OldPath.IsEmpty())
+    {
+        Existing->OldPath = OldPath;
+    }
+}
+
+bool FMcpEventStream::HandleSubscribe(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+    FSubscription Subscription;
+    Subscription.OnComplete = OnComplete;
+
+    if (const FString* Paths = Request.QueryParams.Find(TEXT("paths")))
+    {
+        McpEventStream::SplitList(*Paths, Subscription.Paths);
+    }
+    if (const FString* Roots = Request.QueryParams.Find(TEXT("roots")))
+    {
+        McpEventStream::SplitList(*Roots, Subscription.Roots);
+        for (FString& Root : Subscription.Roots)
+        {
+            if (!Root.EndsWith(TEXT("/")))
+            {
+                Root += TEXT("/");
+            }
+        }
+    }
+    if (const FString* Types = Request.QueryParams.Find(TEXT("types")))
+    {
+        Subscription.Types = ParseEventTypes(*Types);
+        if (Subscription.Types == EMcpEventType::None)
+        {
+            TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("Unknown event types"), TEXT("text/plain"));
+            Response->Code = EHttpServerResponseCodes::BadRequest;
+            OnComplete(MoveTemp(Response));
+            return true;
+        }
+    }
+
+    double Timeout = McpEventStream::DefaultTimeoutSeconds;
+    if (const FString* TimeoutParam = Request.QueryParams.Find(TEXT("timeout")))
+    {
+        Timeout = FMath::Clamp(FCString::Atod(**TimeoutParam), 0.0, McpEventStream::MaxTimeoutSeconds);
+    }
+    Subscription.Deadline = FPlatformTime::Seconds() + Timeout;
+
+    // EventSource resends the last id it saw as a header on reconnect; plain clients can pass it as a query param.
+    FString LastEventId;
+    if (const TArray<FString>* Header = Request.Headers.Find(TEXT("Last-Event-ID")))
+    {
+        if (Header->Num() > 0)
+        {
+            LastEventId = (*Header)[0];
+        }
+    }
+    if (const FString* LastIdParam = Request.QueryParams.Find(TEXT("last_event_id")))
+    {
+        LastEventId = *LastIdParam;
+    }
+
+    FScopeLock Lock(&Mutex);
+    Subscription.LastEventId = LastEventId.IsEmpty() ? NextEventId - 1 : FCString::Strtoui64(*LastEventId, nullptr, 10);
+    if (Subscription.LastEventId >= NextEventId)
+    {
+        // Ids restart with the editor; everything still retained is new to this client.
+        Subscription.ResetReason = TEXT("server_restarted");
+        Subscription.LastEventId = TrimmedThroughId;
+    }
+    else if (Subscription.LastEventId < TrimmedThroughId)
+    {
+        Subscription.ResetReason = TEXT("history_trimmed");
+    }
+
+    TArray<const FMcpEvent*> Matching;
+    if (CollectMatching(Subscription, Matching) || Subscription.ResetReason || Timeout <= 0.0)
+    {
+        CompleteSubscription(Subscription, Matching);
+        return true;
+    }
+
+    Subscriptions.Add(MoveTemp(Subscription));
+    return true;
+}
+
+EMcpEventType FMcpEventStream::ParseEventTypes(const FString& CommaSeparated)
+{
+    TArray<FString> Names;
+    McpEventStream::SplitList(CommaSeparated, Names);
+
+    EMcpEventType Result = EMcpEventType::None;
+    for (const FString& Name : Names)
+    {
+        for (const McpEventStream::FEventTypeName& Entry : McpEventStream::EventTypeNames)
+        {
+            if (Name == Entry.Name)
+            {
+                Result |= Entry.Type;
+            }
+        }
+    }
+    return Result;
+}
+
+void FMcpEventStream::DescribeEventTypes(EMcpEventType Types, TArray<FString>& OutNames)
+{
+    for (const McpEventStream::FEventTypeName& Entry : McpEventStream::EventTypeNames)
+    {
+        if (EnumHasAnyFlags(Types, Entry.Type))
+        {
+            OutNames.Add(Entry.Name);
+        }
+    }
+}
+
+bool FMcpEventStream::Tick(float DeltaTime)
+{
+    MCP_LLM_SCOPE();
+    MCP_TRACE_SCOPE("Mcp::EventStream::Tick");
+
+    const double Now = FPlatformTime::Seconds();
+
+    TArray<TPair<FSubscription, TArray<const FMcpEvent*>>> Ready;
+    {
+        FScopeLock Lock(&Mutex);
+        FlushPending(Now);
+
+        for (int32 Index = Subscriptions.Num() - 1; Index >= 0; --Index)
+        {
+            TArray<const FMcpEvent*> Matching;
+            if (CollectMatching(Subscriptions[Index], Matching) || Now >= Subscriptions[Index].Deadline)
+            {
+                Ready.Emplace(MoveTemp(Subscriptions[Index]), MoveTemp(Matching));
+                Subscriptions.RemoveAtSwap(Index);
+            }
+        }
+
+        for (const TPair<FSubscription, TArray<const FMcpEvent*>>& Entry : Ready)
+        {
+            CompleteSubscription(Entry.Key, Entry.Value);
+        }
+
+        // Trim only after completing subscriptions so the event pointers above stay valid.
+        if (History.Num() > McpEventStream::MaxHistory)
+        {
+            const int32 NumTrimmed = History.Num() - McpEventStream::MaxHistory;
+            TrimmedThroughId = History[NumTrimmed - 1].Id;
+            History.RemoveAt(0, NumTrimmed);
+        }
+    }
+
+    return true;
+}
+
+void FMcpEventStream::FlushPending(double Now)
+{
+    for (auto It = Pending.CreateIterator(); It; ++It)
+    {
+        FMcpEvent& Event = It.Value();
+        const bool bQuiet = Now - Event.LastTime >= McpEventStream::CoalesceWindowSeconds;
+        const bool bOverdue = Now - Event.FirstTime >= McpEventStream::MaxCoalesceDelaySeconds;
+        if (bQuiet || bOverdue)
+        {
+            Event.Id = NextEventId++;
+            History.Add(MoveTemp(Event));
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool FMcpEventStream::CollectMatching(const FSubscription& Subscription, TArray<const FMcpEvent*>& OutEvents) const
+{
+    for (int32 Index = History.Num() - 1; Index >= 0; --Index)
+    {
+        const FMcpEvent& Event = History[Index];
+        if (Event.Id <= Subscription.LastEventId)
+        {
+            break;
+        }
+        if (MatchesFilter(Subscription, Event))
+        {
+            OutEvents.Add(&Event);
+        }
+    }
+
+    Algo::Reverse(OutEvents);
+    return OutEvents.Num() > 0;
+}
+
+void FMcpEventStream::CompleteSubscription(const FSubscription& Subscription, const TArray<const FMcpEvent*>& Events) const
+{
+    FString Body = FString::Printf(TEXT("retry: %d\n\n"), McpEventStream::RetryMilliseconds);
+
+    // No id on the reset record: the events after it (or the id-only record) move the cursor.
+    if (Subscription.ResetReason)
+    {
+        Body += FString::Printf(TEXT("event: reset\ndata: {\"reason\":\"%s\",\"oldest_id\":%llu}\n\n"), Subscription.ResetReason, TrimmedThroughId + 1);
+    }
+
+    for (const FMcpEvent* Event : Events)
+    {
+        TSharedRef<FJsonObject> EventObj = MakeShared<FJsonObject>();
+        EventObj->SetNumberField(TEXT("id"), (double)Event->Id);
+        EventObj->SetStringField(TEXT("asset"), Event->AssetPath);
+
+        TArray<FString> TypeNames;
+        DescribeEventTypes(Event->Types, TypeNames);
+        TArray<TSharedPtr<FJsonValue>> TypeValues;
+        for (const FString& TypeName : TypeNames)
+        {
+            TypeValues.Add(MakeShared<FJsonValueString>(TypeName));
+        }
+        EventObj->SetArrayField(TEXT("types"), TypeValues);
+
+        if (!Event->OldPath.IsEmpty())
+        {
+            EventObj->SetStringField(TEXT("old_path"), Event->OldPath);
+        }
+        if (!Event->Detail.IsEmpty())
+        {
+            EventObj->SetStringField(TEXT("detail"), Event->Detail);
+        }
+
+        FString Data;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Data);
+        FJsonSerializer::Serialize(EventObj, Writer);
+
+        Body += FString::Printf(TEXT("id: %llu\nevent: mcp\ndata: %s\n\n"), Event->Id, *Data);
+    }
+
+    // An id-only record advances the client's cursor without dispatching an event.
+    if (Events.Num() == 0)
+    {
+        Body += FString::Printf(TEXT("id: %llu\n\n"), FMath::Max(Subscription.LastEventId, NextEventId - 1));
+    }
+
+    TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Body, TEXT("text/event-stream"));
+    Response->Headers.Add(TEXT("Cache-Control"), { TEXT("no-cache") });
+    Response->Code = EHttpServerResponseCodes::Ok;
+    Subscription.OnComplete(MoveTemp(Response));
+}
+
+bool FMcpEventStream::MatchesFilter(const FSubscription& Subscription, const FMcpEvent& Event)
+{
+    if (!EnumHasAnyFlags(Subscription.Types, Event.Types))
+    {
+        return false;
+    }
+
+    if (Subscription.Paths.Num() == 0 && Subscription.Roots.Num() == 0)
+    {
+        return true;
+    }
+
+    const FString PackageName = McpEventStream::ToPackageName(Event.AssetPath);
+    for (const FString& Path : Subscription.Paths)
+    {
+        if (Path == Event.AssetPath || Path == PackageName || (!Event.OldPath.IsEmpty() && Path == Event.OldPath))
+        {
+            return true;
+        }
+    }
+
+    for (const FString& Root : Subscription.Roots)
+    {
+        if (Event.AssetPath.StartsWith(Root))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FMcpEventStream::OnObjectModified(UObject* Object)
+{
+    if (!Object)
+    {
+        return;
+    }
+
+    UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+    if (!Blueprint)
+    {
+        Blueprint = Object->GetTypedOuter<UBlueprint>();
+    }
+
+    if (Blueprint && !FMcpBlueprintInspector::IsScratchObject(Blueprint))
+    {
+        Publish(EMcpEventType::BlueprintChanged, Blueprint->GetPathName());
+    }
+}
+
+void FMcpEventStream::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+    if (Blueprint && !FMcpBlueprintInspector::IsScratchObject(Blueprint))
+    {
+        FScopeLock Lock(&Mutex);
+        CompilingBlueprints.Add(Blueprint->GetPathName());
+    }
+}
+
+void FMcpEventStream::OnBlueprintCompiled()
+{
+    TSet<FString> Compiled;
+    {
+        FScopeLock Lock(&Mutex);
+        Compiled = MoveTemp(CompilingBlueprints);
+    }
+
+    for (const FString& AssetPath : Compiled)
+    {
+        Publish(EMcpEventType::BlueprintCompiled, AssetPath);
+    }
+}
+
+void FMcpEventStream::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+    if (!Package || SaveContext.IsProceduralSave())
+    {
+        return;
+    }
+
+    UBlueprint* Blueprint = Cast<UBlueprint>(Package->FindAssetInPackage());
+    if (Blueprint && !FMcpBlueprintInspector::IsScratchObject(Blueprint))
+    {
+        Publish(EMcpEventType::BlueprintSaved, Blueprint->GetPathName());
+    }
+}
+
+void FMcpEventStream::OnAssetAdded(const FAssetData& AssetData)
+{
+    // The initial registry scan reports every asset as added; only live changes are interesting.
+    if (FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().IsLoadingAssets())
+    {
+        return;
+    }
+
+    Publish(EMcpEventType::AssetAdded, AssetData.GetObjectPathString(), AssetData.AssetClassPath.GetAssetName().ToString());
+}
+
+void FMcpEventStream::OnAssetRemoved(const FAssetData& AssetData)
+{
+    Publish(EMcpEventType::AssetRemoved, AssetData.GetObjectPathString(), AssetData.AssetClassPath.GetAssetName().ToString());
+}
+
+void FMcpEventStream::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    Publish(EMcpEventType::AssetRenamed, AssetData.GetObjectPathString(), AssetData.AssetClassPath.GetAssetName().ToString(), OldObjectPath);
+}
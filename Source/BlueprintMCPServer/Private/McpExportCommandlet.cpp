@@ -0,0 +1,65 @@
+#include "McpExportCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Json.h"
+#include "McpProjectExport.h"
+
+UMcpExportCommandlet::UMcpExportCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    ShowErrorCount = false;
+}
+
+int32 UMcpExportCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamMap;
+    ParseCommandLine(*Params, Tokens, Switches, ParamMap);
+
+    FMcpProjectExportConfig Config;
+    FString Roots;
+    FParse::Value(*Params, TEXT("out="), Config.OutputDir);
+    FParse::Value(*Params, TEXT("roots="), Roots, /*bShouldStopOnSeparator=*/false);
+    FParse::Value(*Params, TEXT("batch="), Config.BatchSize);
+    FParse::Value(*Params, TEXT("shard="), Config.ShardSize);
+    FParse::Value(*Params, TEXT("gcbatches="), Config.GcEveryBatches);
+    FParse::Value(*Params, TEXT("gcmb="), Config.GcMemoryGrowthMB);
+    Config.bCompress = Switches.Contains(TEXT("compress"));
+    Config.bIncremental = Switches.Contains(TEXT("incremental"));
+    Roots.ParseIntoArray(Config.Roots, TEXT(","));
+
+    const double BootStart = FPlatformTime::Seconds();
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/true);
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Asset registry ready in %.2fs."), FPlatformTime::Seconds() - BootStart);
+
+    FMcpProjectExporter Exporter;
+    FString Error;
+    if (!Exporter.Start(Config, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MCP] %s"), *Error);
+        return 1;
+    }
+
+    double LastTime = FPlatformTime::Seconds();
+    while (Exporter.IsRunning() && !IsEngineExitRequested())
+    {
+        const double Now = FPlatformTime::Seconds();
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FTSTicker::GetCoreTicker().Tick((float)(Now - LastTime));
+        LastTime = Now;
+    }
+    Exporter.Cancel();
+
+    FString Summary;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Summary);
+    FJsonSerializer::Serialize(Exporter.BuildStatusJson(), Writer);
+    UE_LOG(LogTemp, Display, TEXT("[MCP] %s"), *Summary);
+    return Exporter.HasFailed() ? 1 : 0;
+}
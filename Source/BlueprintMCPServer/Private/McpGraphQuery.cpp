@@ -0,0 +1,580 @@
+#include "McpGraphQuery.h"
+
+#include "Algo/Find.h"
+#include "BlueprintInspector.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Json.h"
+#include "K2Node_Variable.h"
+#include "McpNodeTitleCache.h"
+#include "McpTrace.h"
+
+namespace McpGraphQuery
+{
+    static constexpr int32 MaxQueryLength = 4096;
+
+    // "exec_in", "data_out", "in", "out", ...: which pins an unconnected= filter looks at.
+    static bool ParsePinSelector(const FString& Selector, bool& bOutExec, bool& bOutData, bool& bOutInput, bool& bOutOutput)
+    {
+        FString Kind;
+        FString Direction = Selector;
+        Selector.Split(TEXT("_"), &Kind, &Direction);
+
+        bOutExec = Kind.IsEmpty() || Kind == TEXT("exec");
+        bOutData = Kind.IsEmpty() || Kind == TEXT("data");
+        bOutInput = Direction == TEXT("in") || Direction == TEXT("any");
+        bOutOutput = Direction == TEXT("out") || Direction == TEXT("any");
+        return (bOutExec || bOutData) && (bOutInput || bOutOutput) && (Kind.IsEmpty() || Kind == TEXT("exec") || Kind == TEXT("data"));
+    }
+}
+
+class FMcpGraphQuery::FParser
+{
+public:
+    FParser(const FString& InText, FMcpGraphQuery& InQuery)
+        : Text(InText)
+        , Query(InQuery)
+    {
+    }
+
+    bool Parse(FString& OutError)
+    {
+        if (!ParseNode(OutError))
+        {
+            return false;
+        }
+
+        for (;;)
+        {
+            SkipSpace();
+            if (AtEnd())
+            {
+                return true;
+            }
+
+            FStep Step;
+            if (!ParseStep(Step, OutError) || !ParseNode(OutError))
+            {
+                return false;
+            }
+            Query.Steps.Add(Step);
+        }
+    }
+
+private:
+    bool AtEnd() const { return Pos >= Text.Len(); }
+
+    void SkipSpace()
+    {
+        while (!AtEnd() && FChar::IsWhitespace(Text[Pos]))
+        {
+            ++Pos;
+        }
+    }
+
+    bool Consume(const TCHAR* Token)
+    {
+        SkipSpace();
+        const int32 Length = FCString::Strlen(Token);
+        if (Pos + Length <= Text.Len() && FCString::Strncmp(*Text + Pos, Token, Length) == 0)
+        {
+            Pos += Length;
+            return true;
+        }
+        return false;
+    }
+
+    bool Fail(const TCHAR* Expected, FString& OutError) const
+    {
+        OutError = FString::Printf(TEXT("Query syntax error at %d: expected %s."), Pos, Expected);
+        return false;
+    }
+
+    FString ParseIdentifier()
+    {
+        SkipSpace();
+        const int32 Start = Pos;
+        while (!AtEnd() && (FChar::IsAlnum(Text[Pos]) || Text[Pos] == TEXT('_')))
+        {
+            ++Pos;
+        }
+        return Text.Mid(Start, Pos - Start);
+    }
+
+    bool ParseInt(int32& OutValue)
+    {
+        SkipSpace();
+        const int32 Start = Pos;
+        while (!AtEnd() && FChar::IsDigit(Text[Pos]))
+        {
+            ++Pos;
+        }
+        if (Pos == Start)
+        {
+            return false;
+        }
+        OutValue = FCString::Atoi(*Text.Mid(Start, Pos - Start));
+        return true;
+    }
+
+    // A quoted string, or a bare word of identifier characters plus wildcards, dots, dashes and slashes.
+    FString ParseValue()
+    {
+        SkipSpace();
+        if (!AtEnd() && Text[Pos] == TEXT('"'))
+        {
+            FString Value;
+            for (++Pos; !AtEnd() && Text[Pos] != TEXT('"'); ++Pos)
+            {
+                if (Text[Pos] == TEXT('\\') && Pos + 1 < Text.Len())
+                {
+                    ++Pos;
+                }
+                Value.AppendChar(Text[Pos]);
+            }
+            ++Pos;
+            return Value;
+        }
+
+        const int32 Start = Pos;
+        while (!AtEnd() && (FChar::IsAlnum(Text[Pos]) || FCString::Strchr(TEXT("_*?.-/"), Text[Pos])))
+        {
+            ++Pos;
+        }
+        return Text.Mid(Start, Pos - Start);
+    }
+
+    bool ParseNode(FString& OutError)
+    {
+        if (!Consume(TEXT("(")))
+        {
+            return Fail(TEXT("'('"), OutError);
+        }
+
+        FNodePattern Pattern;
+        Pattern.Variable = ParseIdentifier();
+        if (!Pattern.Variable.IsEmpty() && Query.Nodes.ContainsByPredicate([&Pattern](const FNodePattern& Existing) { return Existing.Variable == Pattern.Variable; }))
+        {
+            OutError = FString::Printf(TEXT("Query variable '%s' is used twice."), *Pattern.Variable);
+            return false;
+        }
+
+        if (Consume(TEXT(":")))
+        {
+            FFilter& Filter = Pattern.Filters.AddDefaulted_GetRef();
+            Filter.Field = EField::Class;
+            Filter.Pattern = ParseValue();
+            if (Filter.Pattern.IsEmpty())
+            {
+                return Fail(TEXT("a node class"), OutError);
+            }
+        }
+
+        if (Consume(TEXT("{")))
+        {
+            do
+            {
+                if (!ParseFilter(Pattern.Filters.AddDefaulted_GetRef(), OutError))
+                {
+                    return false;
+                }
+            }
+            while (Consume(TEXT(",")));
+
+            if (!Consume(TEXT("}")))
+            {
+                return Fail(TEXT("',' or '}'"), OutError);
+            }
+        }
+
+        if (!Consume(TEXT(")")))
+        {
+            return Fail(TEXT("')'"), OutError);
+        }
+
+        Query.Nodes.Add(MoveTemp(Pattern));
+        return true;
+    }
+
+    bool ParseFilter(FFilter& OutFilter, FString& OutError)
+    {
+        static const TPair<const TCHAR*, EField> Fields[] =
+        {
+            { TEXT("class"), EField::Class },
+            { TEXT("title"), EField::Title },
+            { TEXT("function"), EField::Function },
+            { TEXT("variable"), EField::Variable },
+            { TEXT("pin"), EField::Pin },
+            { TEXT("unconnected"), EField::Unconnected },
+            { TEXT("guid"), EField::Guid },
+        };
+
+        const FString Key = ParseIdentifier();
+        const TPair<const TCHAR*, EField>* Field = Algo::FindByPredicate(Fields, [&Key](const TPair<const TCHAR*, EField>& Candidate)
+        {
+            return Key.Equals(Candidate.Key, ESearchCase::IgnoreCase);
+        });
+        if (!Field)
+        {
+            OutError = Key.IsEmpty()
+                ? FString::Printf(TEXT("Query syntax error at %d: expected a filter name."), Pos)
+                : FString::Printf(TEXT("Unknown query filter '%s' (class, title, function, variable, pin, unconnected, guid)."), *Key);
+            return false;
+        }
+        OutFilter.Field = Field->Value;
+
+        OutFilter.bNegate = Consume(TEXT("!="));
+        if (!OutFilter.bNegate && !Consume(TEXT("=")))
+        {
+            return Fail(TEXT("'=' or '!='"), OutError);
+        }
+
+        OutFilter.Pattern = ParseValue();
+        if (OutFilter.Pattern.IsEmpty())
+        {
+            return Fail(TEXT("a value"), OutError);
+        }
+
+        bool bExec, bData, bInput, bOutput;
+        if (OutFilter.Field == EField::Unconnected && !McpGraphQuery::ParsePinSelector(OutFilter.Pattern.ToLower(), bExec, bData, bInput, bOutput))
+        {
+            OutError = FString::Printf(TEXT("Invalid unconnected='%s' (exec_in, exec_out, data_in, data_out, in, out, any)."), *OutFilter.Pattern);
+            return false;
+        }
+        return true;
+    }
+
+    bool ParseStep(FStep& OutStep, FString& OutError)
+    {
+        if (Consume(TEXT("<-")))
+        {
+            OutStep.bForward = false;
+        }
+        else if (!Consume(TEXT("-")))
+        {
+            return Fail(TEXT("'-[...]->' or '<-[...]-'"), OutError);
+        }
+
+        if (Consume(TEXT("[")))
+        {
+            const FString Kind = ParseIdentifier().ToLower();
+            if (Kind == TEXT("exec"))
+            {
+                OutStep.Kind = ELinkKind::Exec;
+            }
+            else if (Kind == TEXT("data"))
+            {
+                OutStep.Kind = ELinkKind::Data;
+            }
+            else if (!Kind.IsEmpty() && Kind != TEXT("any"))
+            {
+                OutError = FString::Printf(TEXT("Unknown link kind '%s' (exec, data, any)."), *Kind);
+                return false;
+            }
+
+            // Cypher-style hop ranges: *, *N, *N..M, *..M, *N..
+            if (Consume(TEXT("*")))
+            {
+                int32 Min = 1;
+                int32 Max = MaxPathDepth;
+                const bool bHasMin = ParseInt(Min);
+                if (Consume(TEXT("..")))
+                {
+                    ParseInt(Max);
+                }
+                else if (bHasMin)
+                {
+                    Max = Min;
+                }
+
+                if (Min < 1 || Max < Min || Max > MaxPathDepth)
+                {
+                    OutError = FString::Printf(TEXT("Invalid hop range %d..%d (1..%d)."), Min, Max, MaxPathDepth);
+                    return false;
+                }
+                OutStep.MinHops = Min;
+                OutStep.MaxHops = Max;
+            }
+
+            if (!Consume(TEXT("]")))
+            {
+                return Fail(TEXT("']'"), OutError);
+            }
+        }
+
+        if (!Consume(OutStep.bForward ? TEXT("->") : TEXT("-")))
+        {
+            return Fail(OutStep.bForward ? TEXT("'->'") : TEXT("'-'"), OutError);
+        }
+        return true;
+    }
+
+    const FString& Text;
+    FMcpGraphQuery& Query;
+    int32 Pos = 0;
+};
+
+TSharedPtr<const FMcpGraphQuery> FMcpGraphQuery::Compile(const FString& Text, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Query::Compile");
+
+    if (Text.Len() > McpGraphQuery::MaxQueryLength)
+    {
+        OutError = FString::Printf(TEXT("Query longer than %d characters."), McpGraphQuery::MaxQueryLength);
+        return nullptr;
+    }
+
+    TSharedRef<FMcpGraphQuery> Query = MakeShared<FMcpGraphQuery>();
+    FParser Parser(Text, *Query);
+    if (!Parser.Parse(OutError))
+    {
+        return nullptr;
+    }
+    return Query;
+}
+
+bool FMcpGraphQuery::Run(const UBlueprint* Blueprint, int32 Limit, TArray<TSharedPtr<FJsonValue>>& OutMatches) const
+{
+    MCP_TRACE_SCOPE("Mcp::Query::Run");
+
+    const FString AssetPath = Blueprint->GetPathName();
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+
+    TArray<const UEdGraphNode*> Bound;
+    for (const UEdGraph* Graph : Graphs)
+    {
+        if (!Graph)
+        {
+            continue;
+        }
+
+        const FString GraphName = Graph->GetName();
+        for (const UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (!Node || !Matches(Node, Nodes[0]))
+            {
+                continue;
+            }
+
+            Bound.Reset();
+            Bound.Add(Node);
+            if (!Extend(1, Bound, AssetPath, GraphName, Limit, OutMatches))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool FMcpGraphQuery::Extend(int32 Position, TArray<const UEdGraphNode*>& Bound, const FString& AssetPath, const FString& GraphName, int32 Limit, TArray<TSharedPtr<FJsonValue>>& OutMatches) const
+{
+    if (Position == Nodes.Num())
+    {
+        TSharedRef<FJsonObject> NodesObj = MakeShared<FJsonObject>();
+        for (int32 Index = 0; Index < Bound.Num(); ++Index)
+        {
+            TSharedRef<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+            NodeObj->SetStringField(TEXT("guid"), Bound[Index]->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+            NodeObj->SetStringField(TEXT("class"), Bound[Index]->GetClass()->GetName());
+            NodeObj->SetStringField(TEXT("title"), FMcpNodeTitleCache::Get().GetTitle(Bound[Index]));
+            NodesObj->SetObjectField(Nodes[Index].Variable.IsEmpty() ? FString::Printf(TEXT("_%d"), Index) : Nodes[Index].Variable, NodeObj);
+        }
+
+        TSharedRef<FJsonObject> MatchObj = MakeShared<FJsonObject>();
+        MatchObj->SetStringField(TEXT("asset_path"), AssetPath);
+        MatchObj->SetStringField(TEXT("graph"), GraphName);
+        MatchObj->SetObjectField(TEXT("nodes"), NodesObj);
+        OutMatches.Add(MakeShared<FJsonValueObject>(MatchObj));
+        return OutMatches.Num() < Limit;
+    }
+
+    TArray<const UEdGraphNode*> Candidates;
+    CollectReachable(Bound.Last(), Steps[Position - 1], Candidates);
+    for (const UEdGraphNode* Candidate : Candidates)
+    {
+        if (!Matches(Candidate, Nodes[Position]))
+        {
+            continue;
+        }
+
+        Bound.Push(Candidate);
+        const bool bContinue = Extend(Position + 1, Bound, AssetPath, GraphName, Limit, OutMatches);
+        Bound.Pop();
+        if (!bContinue)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Breadth-first, so each node is reported once at its shortest hop count.
+void FMcpGraphQuery::CollectReachable(const UEdGraphNode* From, const FStep& Step, TArray<const UEdGraphNode*>& OutNodes) const
+{
+    const EEdGraphPinDirection Direction = Step.bForward ? EGPD_Output : EGPD_Input;
+
+    TSet<const UEdGraphNode*> Visited;
+    Visited.Add(From);
+    TArray<const UEdGraphNode*> Frontier = { From };
+    TArray<const UEdGraphNode*> Next;
+
+    for (int32 Hop = 1; Hop <= Step.MaxHops && Frontier.Num() > 0; ++Hop)
+    {
+        Next.Reset();
+        for (const UEdGraphNode* Node : Frontier)
+        {
+            for (const UEdGraphPin* Pin : Node->Pins)
+            {
+                if (!Pin || Pin->Direction != Direction || !MatchesLinkKind(Pin, Step.Kind))
+                {
+                    continue;
+                }
+
+                for (const UEdGraphPin* Linked : Pin->LinkedTo)
+                {
+                    const UEdGraphNode* Owner = Linked ? Linked->GetOwningNodeUnchecked() : nullptr;
+                    bool bAlreadyVisited = true;
+                    if (Owner)
+                    {
+                        Visited.Add(Owner, &bAlreadyVisited);
+                    }
+                    if (bAlreadyVisited)
+                    {
+                        continue;
+                    }
+
+                    Next.Add(Owner);
+                    if (Hop >= Step.MinHops)
+                    {
+                        OutNodes.Add(Owner);
+                    }
+                }
+            }
+        }
+        Swap(Frontier, Next);
+    }
+}
+
+bool FMcpGraphQuery::Matches(const UEdGraphNode* Node, const FNodePattern& Pattern) const
+{
+    for (const FFilter& Filter : Pattern.Filters)
+    {
+        if (!MatchesFilter(Node, Filter))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FMcpGraphQuery::MatchesFilter(const UEdGraphNode* Node, const FFilter& Filter) const
+{
+    bool bMatch = false;
+    switch (Filter.Field)
+    {
+    case EField::Class:
+    {
+        // "IfThenElse" and "K2Node_IfThenElse" both match.
+        const FString ClassName = Node->GetClass()->GetName();
+        FString ShortName = ClassName;
+        if (!ShortName.RemoveFromStart(TEXT("K2Node_")))
+        {
+            ShortName.RemoveFromStart(TEXT("EdGraphNode_"));
+        }
+        bMatch = ShortName.MatchesWildcard(Filter.Pattern) || ClassName.MatchesWildcard(Filter.Pattern);
+        break;
+    }
+    case EField::Title:
+        bMatch = FMcpNodeTitleCache::Get().GetTitle(Node).MatchesWildcard(Filter.Pattern);
+        break;
+    case EField::Function:
+    {
+        const FString FunctionName = FMcpBlueprintInspector::GetFunctionName(Node);
+        bMatch = !FunctionName.IsEmpty() && FunctionName.MatchesWildcard(Filter.Pattern);
+        break;
+    }
+    case EField::Variable:
+    {
+        const UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node);
+        bMatch = VariableNode && VariableNode->GetVarName().ToString().MatchesWildcard(Filter.Pattern);
+        break;
+    }
+    case EField::Pin:
+        bMatch = Node->Pins.ContainsByPredicate([&Filter](const UEdGraphPin* Pin)
+        {
+            return Pin && !Pin->bHidden && Pin->PinName.ToString().MatchesWildcard(Filter.Pattern);
+        });
+        break;
+    case EField::Unconnected:
+    {
+        bool bExec, bData, bInput, bOutput;
+        McpGraphQuery::ParsePinSelector(Filter.Pattern.ToLower(), bExec, bData, bInput, bOutput);
+        bMatch = Node->Pins.ContainsByPredicate([=](const UEdGraphPin* Pin)
+        {
+            if (!Pin || Pin->bHidden || Pin->LinkedTo.Num() > 0)
+            {
+                return false;
+            }
+            const bool bIsExec = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+            return (bIsExec ? bExec : bData) && (Pin->Direction == EGPD_Input ? bInput : bOutput);
+        });
+        break;
+    }
+    case EField::Guid:
+        bMatch = Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens).MatchesWildcard(Filter.Pattern);
+        break;
+    }
+    return bMatch != Filter.bNegate;
+}
+
+bool FMcpGraphQuery::MatchesLinkKind(const UEdGraphPin* Pin, ELinkKind Kind)
+{
+    switch (Kind)
+    {
+    case ELinkKind::Exec:
+        return Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+    case ELinkKind::Data:
+        return Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec;
+    default:
+        return true;
+    }
+}
+
+FMcpGraphQueryCache::FMcpGraphQueryCache()
+{
+    FMcpServerMetrics::Get().RegisterCache(TEXT("queries"), &Counters);
+}
+
+FMcpGraphQueryCache::~FMcpGraphQueryCache()
+{
+    FMcpServerMetrics::Get().UnregisterCache(&Counters);
+}
+
+TSharedPtr<const FMcpGraphQuery> FMcpGraphQueryCache::Get(const FString& Text, FString& OutError)
+{
+    const FString Key = Text.TrimStartAndEnd();
+    if (const TSharedPtr<const FMcpGraphQuery>* Found = Queries.Find(Key))
+    {
+        Counters.Record(true);
+        return *Found;
+    }
+    Counters.Record(false);
+
+    TSharedPtr<const FMcpGraphQuery> Query = FMcpGraphQuery::Compile(Key, OutError);
+    if (!Query.IsValid())
+    {
+        return nullptr;
+    }
+
+    if (Queries.Num() >= Capacity)
+    {
+        Queries.Reset();
+    }
+    Queries.Add(Key, Query);
+    return Query;
+}
@@ -0,0 +1,238 @@
+#include "McpGraphTopology.h"
+
+#include "BlueprintInspector.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Json.h"
+#include "McpTrace.h"
+#include "Misc/Base64.h"
+
+namespace McpTopology
+{
+    struct FEdges
+    {
+        TArray<int32> Offsets;
+        TArray<int32> Targets;
+        TArray<int32> SourcePins;
+        TArray<int32> TargetPins;
+    };
+
+    // Interned names shared by every graph in one response, so nodes carry an index instead of a string.
+    struct FStringTable
+    {
+        TMap<FString, int32> Indices;
+        TArray<FString> Values;
+
+        int32 Intern(const FString& Value)
+        {
+            if (const int32* Found = Indices.Find(Value))
+            {
+                return *Found;
+            }
+            const int32 Index = Values.Add(Value);
+            Indices.Add(Value, Index);
+            return Index;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> ToJson() const
+        {
+            TArray<TSharedPtr<FJsonValue>> Result;
+            Result.Reserve(Values.Num());
+            for (const FString& Value : Values)
+            {
+                Result.Add(MakeShared<FJsonValueString>(Value));
+            }
+            return Result;
+        }
+    };
+
+    // Index of Pin among the node's non-null pins, the order get_blueprint_structure uses.
+    static int32 GetPinIndex(const UEdGraphPin* Pin)
+    {
+        int32 Index = 0;
+        for (const UEdGraphPin* Candidate : Pin->GetOwningNode()->Pins)
+        {
+            if (Candidate == Pin)
+            {
+                return Index;
+            }
+            if (Candidate)
+            {
+                ++Index;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    static TArray<TSharedPtr<FJsonValue>> ToJson(const TArray<int32>& Values)
+    {
+        TArray<TSharedPtr<FJsonValue>> Result;
+        Result.Reserve(Values.Num());
+        for (const int32 Value : Values)
+        {
+            Result.Add(MakeShared<FJsonValueNumber>(Value));
+        }
+        return Result;
+    }
+
+    static TSharedRef<FJsonObject> EdgesToJson(const FEdges& Edges)
+    {
+        TSharedRef<FJsonObject> EdgesObj = MakeShared<FJsonObject>();
+        EdgesObj->SetArrayField(TEXT("offsets"), ToJson(Edges.Offsets));
+        EdgesObj->SetArrayField(TEXT("targets"), ToJson(Edges.Targets));
+        EdgesObj->SetArrayField(TEXT("source_pins"), ToJson(Edges.SourcePins));
+        EdgesObj->SetArrayField(TEXT("target_pins"), ToJson(Edges.TargetPins));
+        return EdgesObj;
+    }
+
+    static void AppendInts(TArray<uint8>& Buffer, const TArray<int32>& Values)
+    {
+        static_assert(PLATFORM_LITTLE_ENDIAN, "Binary topology is little-endian.");
+        Buffer.Append(reinterpret_cast<const uint8*>(Values.GetData()), Values.Num() * sizeof(int32));
+    }
+
+    static void AppendEdges(TArray<uint8>& Buffer, const FEdges& Edges)
+    {
+        AppendInts(Buffer, Edges.Offsets);
+        AppendInts(Buffer, Edges.Targets);
+        AppendInts(Buffer, Edges.SourcePins);
+        AppendInts(Buffer, Edges.TargetPins);
+    }
+}
+
+bool FMcpGraphTopology::Build(const UBlueprint* Blueprint, const FString& GraphName, bool bBinary, TSharedPtr<FJsonObject>& OutJson, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Topology::Build");
+
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+
+    McpTopology::FStringTable Classes;
+    McpTopology::FStringTable Functions;
+    TArray<TSharedPtr<FJsonValue>> GraphArray;
+
+    TMap<const UEdGraphNode*, int32> NodeIndices;
+    TArray<const UEdGraphNode*> NodeList;
+    for (const UEdGraph* Graph : Graphs)
+    {
+        if (!Graph || (!GraphName.IsEmpty() && Graph->GetName() != GraphName))
+        {
+            continue;
+        }
+
+        NodeIndices.Reset();
+        NodeList.Reset();
+        for (const UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (Node)
+            {
+                NodeIndices.Add(Node, NodeList.Add(Node));
+            }
+        }
+
+        TArray<int32> Guids;
+        TArray<int32> ClassIndices;
+        TArray<int32> FunctionIndices;
+        McpTopology::FEdges Exec;
+        McpTopology::FEdges Data;
+        Guids.Reserve(NodeList.Num() * 4);
+        ClassIndices.Reserve(NodeList.Num());
+        FunctionIndices.Reserve(NodeList.Num());
+        Exec.Offsets.Reserve(NodeList.Num() + 1);
+        Data.Offsets.Reserve(NodeList.Num() + 1);
+
+        for (const UEdGraphNode* Node : NodeList)
+        {
+            const FGuid& Guid = Node->NodeGuid;
+            Guids.Append({ (int32)Guid.A, (int32)Guid.B, (int32)Guid.C, (int32)Guid.D });
+            ClassIndices.Add(Classes.Intern(Node->GetClass()->GetName()));
+            const FString FunctionName = FMcpBlueprintInspector::GetFunctionName(Node);
+            FunctionIndices.Add(FunctionName.IsEmpty() ? INDEX_NONE : Functions.Intern(FunctionName));
+
+            Exec.Offsets.Add(Exec.Targets.Num());
+            Data.Offsets.Add(Data.Targets.Num());
+
+            int32 PinIndex = 0;
+            for (const UEdGraphPin* Pin : Node->Pins)
+            {
+                if (!Pin)
+                {
+                    continue;
+                }
+
+                if (Pin->Direction == EGPD_Output)
+                {
+                    McpTopology::FEdges& Edges = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec ? Exec : Data;
+                    for (const UEdGraphPin* Linked : Pin->LinkedTo)
+                    {
+                        const int32* Target = Linked ? NodeIndices.Find(Linked->GetOwningNodeUnchecked()) : nullptr;
+                        if (!Target)
+                        {
+                            continue;
+                        }
+                        Edges.Targets.Add(*Target);
+                        Edges.SourcePins.Add(PinIndex);
+                        Edges.TargetPins.Add(McpTopology::GetPinIndex(Linked));
+                    }
+                }
+                ++PinIndex;
+            }
+        }
+        Exec.Offsets.Add(Exec.Targets.Num());
+        Data.Offsets.Add(Data.Targets.Num());
+
+        TSharedRef<FJsonObject> GraphObj = MakeShared<FJsonObject>();
+        GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+        GraphObj->SetNumberField(TEXT("node_count"), NodeList.Num());
+        GraphObj->SetNumberField(TEXT("exec_edge_count"), Exec.Targets.Num());
+        GraphObj->SetNumberField(TEXT("data_edge_count"), Data.Targets.Num());
+
+        if (bBinary)
+        {
+            TArray<uint8> Buffer;
+            Buffer.Reserve((Guids.Num() + ClassIndices.Num() * 2 + (NodeList.Num() + 1) * 2 + (Exec.Targets.Num() + Data.Targets.Num()) * 3) * sizeof(int32));
+            McpTopology::AppendInts(Buffer, Guids);
+            McpTopology::AppendInts(Buffer, ClassIndices);
+            McpTopology::AppendInts(Buffer, FunctionIndices);
+            McpTopology::AppendEdges(Buffer, Exec);
+            McpTopology::AppendEdges(Buffer, Data);
+            GraphObj->SetStringField(TEXT("data"), FBase64::Encode(Buffer));
+        }
+        else
+        {
+            TArray<TSharedPtr<FJsonValue>> GuidArray;
+            GuidArray.Reserve(NodeList.Num());
+            for (const UEdGraphNode* Node : NodeList)
+            {
+                GuidArray.Add(MakeShared<FJsonValueString>(Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens)));
+            }
+
+            TSharedRef<FJsonObject> NodesObj = MakeShared<FJsonObject>();
+            NodesObj->SetArrayField(TEXT("guids"), GuidArray);
+            NodesObj->SetArrayField(TEXT("classes"), McpTopology::ToJson(ClassIndices));
+            NodesObj->SetArrayField(TEXT("functions"), McpTopology::ToJson(FunctionIndices));
+            GraphObj->SetObjectField(TEXT("nodes"), NodesObj);
+            GraphObj->SetObjectField(TEXT("exec_edges"), McpTopology::EdgesToJson(Exec));
+            GraphObj->SetObjectField(TEXT("data_edges"), McpTopology::EdgesToJson(Data));
+        }
+
+        GraphArray.Add(MakeShared<FJsonValueObject>(GraphObj));
+    }
+
+    if (!GraphName.IsEmpty() && GraphArray.Num() == 0)
+    {
+        OutError = FString::Printf(TEXT("Graph '%s' not found"), *GraphName);
+        return false;
+    }
+
+    OutJson = MakeShared<FJsonObject>();
+    OutJson->SetStringField(TEXT("asset_path"), Blueprint->GetPathName());
+    OutJson->SetStringField(TEXT("format"), bBinary ? TEXT("binary") : TEXT("json"));
+    OutJson->SetArrayField(TEXT("classes"), Classes.ToJson());
+    OutJson->SetArrayField(TEXT("functions"), Functions.ToJson());
+    OutJson->SetArrayField(TEXT("graphs"), GraphArray);
+    return true;
+}
@@ -0,0 +1,323 @@
+#include "McpImpactAnalysis.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Json.h"
+#include "McpTrace.h"
+#include "Misc/PackageName.h"
+
+namespace McpImpact
+{
+    // Rough size of one serialized graph node, used when the Blueprint is not loaded.
+    static constexpr int64 EstimatedBytesPerNode = 1024;
+
+    struct FAffected
+    {
+        FName Package;
+        FString ObjectPath;
+        FString GeneratedClassPath;
+        int32 Depth = 0;
+        bool bRoot = false;
+        bool bParentClass = false;
+        bool bHard = false;
+        bool bSoft = false;
+        TArray<FName> Via;
+    };
+
+    static FString TagToObjectPath(const FAssetData& Asset, FName Tag)
+    {
+        FString Value;
+        if (!Asset.GetTagValue(Tag, Value) || Value.IsEmpty())
+        {
+            return FString();
+        }
+        return FPackageName::ExportTextPathToObjectPath(Value);
+    }
+
+    static int32 CountLoadedNodes(const UBlueprint* Blueprint)
+    {
+        TArray<UEdGraph*> Graphs;
+        Blueprint->GetAllGraphs(Graphs);
+
+        int32 Count = 0;
+        for (const UEdGraph* Graph : Graphs)
+        {
+            Count += Graph ? Graph->Nodes.Num() : 0;
+        }
+        return Count;
+    }
+}
+
+bool FMcpImpactAnalysis::Analyze(const FString& AssetPath, const FString& ClassPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::ImpactAnalysis");
+    using namespace McpImpact;
+    using namespace UE::AssetRegistry;
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+    // Index every Blueprint by package, generated class and parent class from registry tags.
+    TArray<FAssetData> BlueprintAssets;
+    AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), BlueprintAssets, /*bSearchSubClasses=*/true);
+
+    TMap<FName, const FAssetData*> BlueprintsByPackage;
+    TMap<FString, const FAssetData*> BlueprintsByClass;
+    TMultiMap<FString, const FAssetData*> ChildrenByParentClass;
+    for (const FAssetData& Asset : BlueprintAssets)
+    {
+        BlueprintsByPackage.Add(Asset.PackageName, &Asset);
+        const FString GeneratedClass = TagToObjectPath(Asset, FBlueprintTags::GeneratedClassPath);
+        if (!GeneratedClass.IsEmpty())
+        {
+            BlueprintsByClass.Add(GeneratedClass, &Asset);
+        }
+        const FString ParentClass = TagToObjectPath(Asset, FBlueprintTags::ParentClassPath);
+        if (!ParentClass.IsEmpty())
+        {
+            ChildrenByParentClass.Add(ParentClass, &Asset);
+        }
+    }
+
+    TMap<FName, FAffected> Affected;
+    TArray<FName> Order;
+    TMultiMap<FName, FName> Edges;
+    TArray<FName> Frontier;
+
+    auto AddAffected = [&](const FAssetData& Asset, int32 Depth) -> FAffected&
+    {
+        if (FAffected* Existing = Affected.Find(Asset.PackageName))
+        {
+            return *Existing;
+        }
+
+        FAffected& Entry = Affected.Add(Asset.PackageName);
+        Entry.Package = Asset.PackageName;
+        Entry.ObjectPath = Asset.GetObjectPathString();
+        Entry.GeneratedClassPath = TagToObjectPath(Asset, FBlueprintTags::GeneratedClassPath);
+        Entry.Depth = Depth;
+        Order.Add(Asset.PackageName);
+        return Entry;
+    };
+
+    FName RootPackage;
+    FString RootClass;
+    FString RootLabel;
+    if (!AssetPath.IsEmpty())
+    {
+        FString ObjectPath = FPackageName::ExportTextPathToObjectPath(AssetPath);
+        RootPackage = FName(*FPackageName::ObjectPathToPackageName(ObjectPath));
+        RootLabel = ObjectPath;
+
+        TArray<FAssetData> RootAssets;
+        AssetRegistry.GetAssetsByPackageName(RootPackage, RootAssets);
+        if (RootAssets.Num() == 0)
+        {
+            OutError = FString::Printf(TEXT("Asset '%s' not found in the asset registry."), *AssetPath);
+            return false;
+        }
+
+        if (const FAssetData* const* RootBlueprint = BlueprintsByPackage.Find(RootPackage))
+        {
+            FAffected& Root = AddAffected(**RootBlueprint, 0);
+            Root.bRoot = true;
+            RootClass = Root.GeneratedClassPath;
+        }
+    }
+    else if (!ClassPath.IsEmpty())
+    {
+        RootClass = FPackageName::ExportTextPathToObjectPath(ClassPath);
+        RootLabel = RootClass;
+        if (const FAssetData* const* RootBlueprint = BlueprintsByClass.Find(RootClass))
+        {
+            FAffected& Root = AddAffected(**RootBlueprint, 0);
+            Root.bRoot = true;
+            RootPackage = (*RootBlueprint)->PackageName;
+        }
+        else if (!FPackageName::IsScriptPackage(RootClass))
+        {
+            OutError = FString::Printf(TEXT("Class '%s' is neither a native class nor a known Blueprint class."), *ClassPath);
+            return false;
+        }
+    }
+    else
+    {
+        OutError = TEXT("Missing 'asset_path' or 'class'");
+        return false;
+    }
+
+    // Native classes have no package-level referencers worth following (every asset of that module
+    // would match), so they only contribute their Blueprint subclasses.
+    struct FVisit
+    {
+        FName Package;
+        FString ClassPath;
+        int32 Depth;
+    };
+    TArray<FVisit> Queue;
+    Queue.Add({ RootPackage, RootClass, 0 });
+    TSet<FName> Expanded;
+    TSet<FName> OtherReferencers;
+
+    for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+    {
+        const FVisit Visit = Queue[QueueIndex];
+
+        if (!Visit.ClassPath.IsEmpty())
+        {
+            TArray<const FAssetData*> Children;
+            ChildrenByParentClass.MultiFind(Visit.ClassPath, Children);
+            for (const FAssetData* Child : Children)
+            {
+                FAffected& Entry = AddAffected(*Child, Visit.Depth + 1);
+                Entry.bParentClass = true;
+                if (!Visit.Package.IsNone())
+                {
+                    Entry.Via.AddUnique(Visit.Package);
+                    Edges.AddUnique(Visit.Package, Child->PackageName);
+                }
+                if (!Expanded.Contains(Child->PackageName))
+                {
+                    Queue.Add({ Child->PackageName, Entry.GeneratedClassPath, Visit.Depth + 1 });
+                }
+            }
+        }
+
+        if (Visit.Package.IsNone() || Expanded.Contains(Visit.Package))
+        {
+            continue;
+        }
+        Expanded.Add(Visit.Package);
+
+        for (const EDependencyQuery Query : { EDependencyQuery::Hard, EDependencyQuery::Soft })
+        {
+            const bool bHard = Query == EDependencyQuery::Hard;
+            TArray<FName> Referencers;
+            AssetRegistry.GetReferencers(Visit.Package, Referencers, EDependencyCategory::Package, Query);
+
+            for (const FName Referencer : Referencers)
+            {
+                const FAssetData* const* ReferencerBlueprint = BlueprintsByPackage.Find(Referencer);
+                if (!ReferencerBlueprint)
+                {
+                    // Levels and data assets that use the root are reported as a count only.
+                    if (Visit.Package == RootPackage)
+                    {
+                        OtherReferencers.Add(Referencer);
+                    }
+                    continue;
+                }
+
+                FAffected& Entry = AddAffected(**ReferencerBlueprint, Visit.Depth + 1);
+                (bHard ? Entry.bHard : Entry.bSoft) = true;
+                Entry.Via.AddUnique(Visit.Package);
+                Edges.AddUnique(Visit.Package, Referencer);
+
+                // Soft references do not force a recompile, so they are reported but not followed.
+                if (bHard && !Expanded.Contains(Referencer))
+                {
+                    Queue.Add({ Referencer, Entry.GeneratedClassPath, Visit.Depth + 1 });
+                }
+            }
+        }
+    }
+
+    // Kahn's algorithm over the discovered edges; members of reference cycles are appended in discovery order.
+    TMap<FName, int32> InDegree;
+    for (const FName Package : Order)
+    {
+        InDegree.Add(Package, 0);
+    }
+    for (const TPair<FName, FName>& Edge : Edges)
+    {
+        if (Edge.Key != Edge.Value && Affected.Contains(Edge.Key))
+        {
+            ++InDegree[Edge.Value];
+        }
+    }
+
+    TArray<FName> Sorted;
+    TArray<FName> Ready;
+    for (const FName Package : Order)
+    {
+        if (InDegree[Package] == 0)
+        {
+            Ready.Add(Package);
+        }
+    }
+    for (int32 ReadyIndex = 0; ReadyIndex < Ready.Num(); ++ReadyIndex)
+    {
+        const FName Package = Ready[ReadyIndex];
+        Sorted.Add(Package);
+
+        TArray<FName> Targets;
+        Edges.MultiFind(Package, Targets);
+        for (const FName Target : Targets)
+        {
+            if (Target != Package && --InDegree[Target] == 0)
+            {
+                Ready.Add(Target);
+            }
+        }
+    }
+
+    TSet<FName> InCycle;
+    for (const FName Package : Order)
+    {
+        if (InDegree[Package] > 0)
+        {
+            InCycle.Add(Package);
+            Sorted.Add(Package);
+        }
+    }
+
+    TArray<TSharedPtr<FJsonValue>> AffectedArray;
+    int64 TotalNodes = 0;
+    for (const FName Package : Sorted)
+    {
+        const FAffected& Entry = Affected[Package];
+        TSharedRef<FJsonObject> EntryObj = MakeShared<FJsonObject>();
+        EntryObj->SetStringField(TEXT("asset_path"), Entry.ObjectPath);
+        EntryObj->SetNumberField(TEXT("depth"), Entry.Depth);
+        EntryObj->SetBoolField(TEXT("root"), Entry.bRoot);
+        EntryObj->SetBoolField(TEXT("parent_class"), Entry.bParentClass);
+        EntryObj->SetBoolField(TEXT("hard"), Entry.bHard);
+        EntryObj->SetBoolField(TEXT("soft"), Entry.bSoft);
+        EntryObj->SetBoolField(TEXT("recompiles"), Entry.bRoot || Entry.bParentClass || Entry.bHard);
+        if (InCycle.Contains(Package))
+        {
+            EntryObj->SetBoolField(TEXT("cycle"), true);
+        }
+
+        TArray<TSharedPtr<FJsonValue>> ViaArray;
+        for (const FName Via : Entry.Via)
+        {
+            ViaArray.Add(MakeShared<FJsonValueString>(Via.ToString()));
+        }
+        EntryObj->SetArrayField(TEXT("via"), ViaArray);
+
+        // Only already-loaded Blueprints are inspected; everything else is estimated from disk size.
+        int64 Nodes = 0;
+        if (const UBlueprint* Loaded = FindObject<UBlueprint>(nullptr, *Entry.ObjectPath))
+        {
+            Nodes = CountLoadedNodes(Loaded);
+            EntryObj->SetStringField(TEXT("cost_source"), TEXT("loaded"));
+        }
+        else if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Package))
+        {
+            Nodes = FMath::Max<int64>(1, PackageData->DiskSize / EstimatedBytesPerNode);
+            EntryObj->SetStringField(TEXT("cost_source"), TEXT("disk_size"));
+        }
+        EntryObj->SetNumberField(TEXT("estimated_nodes"), (double)Nodes);
+        TotalNodes += Entry.bRoot || Entry.bParentClass || Entry.bHard ? Nodes : 0;
+
+        AffectedArray.Add(MakeShared<FJsonValueObject>(EntryObj));
+    }
+
+    OutJson = MakeShared<FJsonObject>();
+    OutJson->SetStringField(TEXT("root"), RootLabel);
+    OutJson->SetArrayField(TEXT("affected"), AffectedArray);
+    OutJson->SetNumberField(TEXT("recompile_estimated_nodes"), (double)TotalNodes);
+    OutJson->SetNumberField(TEXT("other_referencers"), OtherReferencers.Num());
+    return true;
+}
@@ -0,0 +1,585 @@
+#include "McpLoadGenCommandlet.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Json.h"
+#include "Math/RandomStream.h"
+#include "McpServerMetrics.h"
+#include "Misc/FileHelper.h"
+
+namespace McpLoadGen
+{
+    static constexpr float PollSleepSeconds = 0.0005f;
+    static constexpr double StatsTimeoutSeconds = 10.0;
+    static constexpr double DrainTimeoutSeconds = 60.0;
+
+    struct FRequestSpec
+    {
+        double Offset = 0.0;
+        FString Client;
+        FString Action;
+        FString Body;
+    };
+
+    struct FActionReport
+    {
+        int32 Requests = 0;
+        int32 Errors = 0;
+        TArray<double> LatenciesMs;
+    };
+
+    // Only touched from HTTP completion callbacks, which the HTTP manager runs on the game thread.
+    struct FRunState
+    {
+        int32 InFlight = 0;
+        int32 Sent = 0;
+        int32 Completed = 0;
+        int32 Errors = 0;
+        TArray<double> LatenciesMs;
+        TMap<int32, int32> ErrorsByStatus;
+        TMap<FString, FActionReport> Actions;
+    };
+
+    struct FStatsFetch
+    {
+        bool bDone = false;
+        bool bOk = false;
+        FString Body;
+    };
+
+    static void Pump(double& LastTime)
+    {
+        const double Now = FPlatformTime::Seconds();
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FTSTicker::GetCoreTicker().Tick((float)(Now - LastTime));
+        LastTime = Now;
+    }
+
+    static FString MakeBody(const FString& Action, const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedRef<FJsonObject> BodyObj = MakeShared<FJsonObject>();
+        BodyObj->SetStringField(TEXT("action"), Action);
+        BodyObj->SetObjectField(TEXT("params"), Params.IsValid() ? Params : MakeShared<FJsonObject>());
+
+        FString Body;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+        FJsonSerializer::Serialize(BodyObj, Writer);
+        return Body;
+    }
+
+    static TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FString& Url, const FString& Client, const FString& Body)
+    {
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+        Request->SetURL(Url);
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        if (!Client.IsEmpty())
+        {
+            Request->SetHeader(TEXT("X-MCP-Client"), Client);
+        }
+        Request->SetContentAsString(Body);
+        return Request;
+    }
+
+    static bool LoadCapture(const FString& Path, TArray<FRequestSpec>& OutSpecs, FString& OutError)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+        {
+            OutError = FString::Printf(TEXT("Could not read capture '%s'."), *Path);
+            return false;
+        }
+
+        int32 Skipped = 0;
+        for (const FString& Line : Lines)
+        {
+            if (Line.TrimStartAndEnd().IsEmpty())
+            {
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> LineObj;
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+            if (!FJsonSerializer::Deserialize(Reader, LineObj) || !LineObj.IsValid())
+            {
+                ++Skipped;
+                continue;
+            }
+
+            if (LineObj->HasField(TEXT("format")))
+            {
+                int32 Version = 0;
+                LineObj->TryGetNumberField(TEXT("version"), Version);
+                if (Version != 1)
+                {
+                    OutError = FString::Printf(TEXT("Unsupported capture version %d."), Version);
+                    return false;
+                }
+                continue;
+            }
+
+            FRequestSpec Spec;
+            if (!LineObj->TryGetStringField(TEXT("action"), Spec.Action))
+            {
+                ++Skipped;
+                continue;
+            }
+            LineObj->TryGetNumberField(TEXT("t"), Spec.Offset);
+            LineObj->TryGetStringField(TEXT("client"), Spec.Client);
+
+            const TSharedPtr<FJsonObject>* ParamsObj = nullptr;
+            LineObj->TryGetObjectField(TEXT("params"), ParamsObj);
+            Spec.Body = MakeBody(Spec.Action, ParamsObj ? *ParamsObj : nullptr);
+            OutSpecs.Add(MoveTemp(Spec));
+        }
+
+        if (Skipped > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[MCP] Skipped %d malformed capture lines."), Skipped);
+        }
+
+        if (OutSpecs.Num() == 0)
+        {
+            OutError = FString::Printf(TEXT("Capture '%s' contains no requests."), *Path);
+            return false;
+        }
+
+        OutSpecs.StableSort([](const FRequestSpec& A, const FRequestSpec& B) { return A.Offset < B.Offset; });
+        const double FirstOffset = OutSpecs[0].Offset;
+        for (FRequestSpec& Spec : OutSpecs)
+        {
+            Spec.Offset -= FirstOffset;
+        }
+        return true;
+    }
+
+    static bool ParseMix(const FString& Mix, const FString& AssetPath, TArray<FRequestSpec>& OutSpecs, TArray<double>& OutWeights, FString& OutError)
+    {
+        TArray<FString> Entries;
+        Mix.ParseIntoArray(Entries, TEXT(","), /*InCullEmpty=*/true);
+
+        for (const FString& Entry : Entries)
+        {
+            FString Action = Entry.TrimStartAndEnd();
+            FString WeightText;
+            double Weight = 1.0;
+            if (Entry.Split(TEXT("="), &Action, &WeightText))
+            {
+                Action.TrimStartAndEndInline();
+                Weight = FCString::Atod(*WeightText);
+            }
+
+            if (Action.IsEmpty() || Weight <= 0.0)
+            {
+                OutError = FString::Printf(TEXT("Invalid mix entry '%s'; expected action=weight."), *Entry);
+                return false;
+            }
+
+            TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+            if (!AssetPath.IsEmpty())
+            {
+                Params->SetStringField(TEXT("asset_path"), AssetPath);
+            }
+
+            FRequestSpec Spec;
+            Spec.Action = Action;
+            Spec.Body = MakeBody(Action, Params);
+            OutSpecs.Add(MoveTemp(Spec));
+            OutWeights.Add(Weight);
+        }
+
+        if (OutSpecs.Num() == 0)
+        {
+            OutError = TEXT("Empty -mix.");
+            return false;
+        }
+        return true;
+    }
+
+    static int32 PickWeighted(const TArray<double>& Weights, double TotalWeight, FRandomStream& Random)
+    {
+        double Roll = Random.FRand() * TotalWeight;
+        for (int32 Index = 0; Index < Weights.Num(); ++Index)
+        {
+            Roll -= Weights[Index];
+            if (Roll < 0.0)
+            {
+                return Index;
+            }
+        }
+        return Weights.Num() - 1;
+    }
+
+    static void Send(const FString& Url, const FRequestSpec& Spec, const TSharedRef<FRunState>& State)
+    {
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(Url, Spec.Client, Spec.Body);
+
+        const double SendTime = FPlatformTime::Seconds();
+        Request->OnProcessRequestComplete().BindLambda(
+            [State, Action = Spec.Action, SendTime](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+            {
+                const double LatencyMs = (FPlatformTime::Seconds() - SendTime) * 1000.0;
+                const int32 Status = bConnectedSuccessfully && Response.IsValid() ? Response->GetResponseCode() : 0;
+
+                --State->InFlight;
+                ++State->Completed;
+
+                FActionReport& Report = State->Actions.FindOrAdd(Action);
+                ++Report.Requests;
+                if (EHttpResponseCodes::IsOk(Status))
+                {
+                    Report.LatenciesMs.Add(LatencyMs);
+                    State->LatenciesMs.Add(LatencyMs);
+                }
+                else
+                {
+                    ++Report.Errors;
+                    ++State->Errors;
+                    ++State->ErrorsByStatus.FindOrAdd(Status);
+                }
+            });
+
+        ++State->InFlight;
+        ++State->Sent;
+        Request->ProcessRequest();
+    }
+
+    // Snapshot of the server's cumulative frame-time histogram; two snapshots bracket a window.
+    static bool FetchFrameBuckets(const FString& Url, double& LastTime, TArray<uint64>& OutBuckets)
+    {
+        TSharedRef<FStatsFetch> Fetch = MakeShared<FStatsFetch>();
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(Url, TEXT("mcp-loadgen"), MakeBody(TEXT("get_server_stats"), nullptr));
+        Request->OnProcessRequestComplete().BindLambda(
+            [Fetch](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+            {
+                Fetch->bDone = true;
+                Fetch->bOk = bConnectedSuccessfully && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
+                if (Fetch->bOk)
+                {
+                    Fetch->Body = Response->GetContentAsString();
+                }
+            });
+        Request->ProcessRequest();
+
+        const double Deadline = FPlatformTime::Seconds() + StatsTimeoutSeconds;
+        while (!Fetch->bDone && FPlatformTime::Seconds() < Deadline)
+        {
+            Pump(LastTime);
+            FPlatformProcess::Sleep(PollSleepSeconds);
+        }
+
+        if (!Fetch->bOk)
+        {
+            Request->CancelRequest();
+            return false;
+        }
+
+        TSharedPtr<FJsonObject> StatsObj;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Fetch->Body);
+        const TSharedPtr<FJsonObject>* FrameObj = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* BucketArray = nullptr;
+        if (!FJsonSerializer::Deserialize(Reader, StatsObj) || !StatsObj.IsValid()
+            || !StatsObj->TryGetObjectField(TEXT("frame_time_ms"), FrameObj)
+            || !(*FrameObj)->TryGetArrayField(TEXT("buckets"), BucketArray)
+            || BucketArray->Num() != FMcpLatencyHistogram::NumBuckets + 1)
+        {
+            return false;
+        }
+
+        OutBuckets.Reset(BucketArray->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *BucketArray)
+        {
+            OutBuckets.Add((uint64)Value->AsNumber());
+        }
+        return true;
+    }
+
+    static TSharedRef<FJsonObject> BuildFrameWindow(const TArray<uint64>& Begin, const TArray<uint64>& End)
+    {
+        TArray<uint64> Delta;
+        uint64 Count = 0;
+        for (int32 Index = 0; Index < End.Num(); ++Index)
+        {
+            Delta.Add(End[Index] >= Begin[Index] ? End[Index] - Begin[Index] : 0);
+            Count += Delta.Last();
+        }
+
+        TSharedRef<FJsonObject> WindowObj = MakeShared<FJsonObject>();
+        WindowObj->SetNumberField(TEXT("count"), (double)Count);
+        WindowObj->SetNumberField(TEXT("p50"), FMcpLatencyHistogram::GetPercentile(Delta, 0.50) * 1000.0);
+        WindowObj->SetNumberField(TEXT("p95"), FMcpLatencyHistogram::GetPercentile(Delta, 0.95) * 1000.0);
+        WindowObj->SetNumberField(TEXT("p99"), FMcpLatencyHistogram::GetPercentile(Delta, 0.99) * 1000.0);
+        return WindowObj;
+    }
+
+    static void AddLatencyFields(const TSharedRef<FJsonObject>& Obj, TArray<double>& LatenciesMs)
+    {
+        LatenciesMs.Sort();
+        const auto Percentile = [&LatenciesMs](double Fraction)
+        {
+            if (LatenciesMs.Num() == 0)
+            {
+                return 0.0;
+            }
+            const int32 Rank = FMath::Clamp(FMath::CeilToInt(Fraction * LatenciesMs.Num()) - 1, 0, LatenciesMs.Num() - 1);
+            return LatenciesMs[Rank];
+        };
+
+        double Sum = 0.0;
+        for (const double Latency : LatenciesMs)
+        {
+            Sum += Latency;
+        }
+
+        Obj->SetNumberField(TEXT("p50"), Percentile(0.50));
+        Obj->SetNumberField(TEXT("p95"), Percentile(0.95));
+        Obj->SetNumberField(TEXT("p99"), Percentile(0.99));
+        Obj->SetNumberField(TEXT("mean"), LatenciesMs.Num() > 0 ? Sum / LatenciesMs.Num() : 0.0);
+        Obj->SetNumberField(TEXT("max"), LatenciesMs.Num() > 0 ? LatenciesMs.Last() : 0.0);
+    }
+}
+
+UMcpLoadGenCommandlet::UMcpLoadGenCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    ShowErrorCount = false;
+}
+
+int32 UMcpLoadGenCommandlet::Main(const FString& Params)
+{
+    using namespace McpLoadGen;
+
+    FString Url = TEXT("http://127.0.0.1:9000/mcp");
+    FString CapturePath;
+    FString Mix;
+    FString AssetPath;
+    FString OutPath;
+    double Speed = 1.0;
+    double Rate = 0.0;
+    double Duration = 30.0;
+    double Baseline = 5.0;
+    int32 Loops = 1;
+    int32 Concurrency = 8;
+    int32 Seed = 0;
+    FParse::Value(*Params, TEXT("url="), Url);
+    FParse::Value(*Params, TEXT("capture="), CapturePath);
+    FParse::Value(*Params, TEXT("mix="), Mix, /*bShouldStopOnSeparator=*/false);
+    FParse::Value(*Params, TEXT("asset="), AssetPath);
+    FParse::Value(*Params, TEXT("out="), OutPath);
+    FParse::Value(*Params, TEXT("speed="), Speed);
+    FParse::Value(*Params, TEXT("rate="), Rate);
+    FParse::Value(*Params, TEXT("duration="), Duration);
+    FParse::Value(*Params, TEXT("baseline="), Baseline);
+    FParse::Value(*Params, TEXT("loops="), Loops);
+    FParse::Value(*Params, TEXT("concurrency="), Concurrency);
+    FParse::Value(*Params, TEXT("seed="), Seed);
+
+    const bool bReplay = !CapturePath.IsEmpty();
+    if (bReplay == !Mix.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MCP] Pass exactly one of -capture=<file> or -mix=action=weight,..."));
+        return 1;
+    }
+    if (Concurrency < 1 || Speed <= 0.0 || Rate < 0.0 || Loops < 1 || Duration <= 0.0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MCP] Invalid -concurrency, -speed, -rate, -loops or -duration."));
+        return 1;
+    }
+
+    TArray<FRequestSpec> Specs;
+    TArray<double> Weights;
+    FString Error;
+    if (bReplay ? !LoadCapture(CapturePath, Specs, Error) : !ParseMix(Mix, AssetPath, Specs, Weights, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MCP] %s"), *Error);
+        return 1;
+    }
+
+    double TotalWeight = 0.0;
+    for (const double Weight : Weights)
+    {
+        TotalWeight += Weight;
+    }
+    FRandomStream Random(Seed);
+
+    double LastTime = FPlatformTime::Seconds();
+
+    // Idle window first so the load window's frame times have something to be compared against.
+    TArray<uint64> IdleBegin;
+    TArray<uint64> LoadBegin;
+    TArray<uint64> LoadEnd;
+    bool bFrameStats = FetchFrameBuckets(Url, LastTime, IdleBegin);
+    if (!bFrameStats)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[MCP] Could not read frame times from %s; reporting client-side numbers only."), *Url);
+    }
+    else if (Baseline > 0.0)
+    {
+        UE_LOG(LogTemp, Display, TEXT("[MCP] Measuring idle frame times for %.1fs..."), Baseline);
+        const double IdleEnd = FPlatformTime::Seconds() + Baseline;
+        while (FPlatformTime::Seconds() < IdleEnd)
+        {
+            Pump(LastTime);
+            FPlatformProcess::Sleep(PollSleepSeconds);
+        }
+        bFrameStats = FetchFrameBuckets(Url, LastTime, LoadBegin);
+    }
+    else
+    {
+        LoadBegin = IdleBegin;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("[MCP] %s against %s (concurrency %d, rate %s)."),
+        bReplay ? *FString::Printf(TEXT("Replaying %d requests x%d"), Specs.Num(), Loops) : *FString::Printf(TEXT("Running %d-action mix for %.1fs"), Specs.Num(), Duration),
+        *Url, Concurrency, Rate > 0.0 ? *FString::Printf(TEXT("%.1f/s"), Rate) : bReplay ? TEXT("as captured") : TEXT("unthrottled"));
+
+    TSharedRef<FRunState> State = MakeShared<FRunState>();
+    const double CaptureSpan = Specs.Last().Offset;
+    const double RunStart = FPlatformTime::Seconds();
+    double IssueEnd = 0.0;
+    int32 NextIndex = 0;
+    int32 Loop = 0;
+    bool bIssuing = true;
+
+    while (bIssuing || State->InFlight > 0)
+    {
+        Pump(LastTime);
+        const double Now = FPlatformTime::Seconds();
+
+        while (bIssuing && State->InFlight < Concurrency)
+        {
+            if (bReplay && NextIndex >= Specs.Num())
+            {
+                NextIndex = 0;
+                if (++Loop >= Loops)
+                {
+                    bIssuing = false;
+                    break;
+                }
+            }
+            if (!bReplay && Now - RunStart >= Duration)
+            {
+                bIssuing = false;
+                break;
+            }
+
+            // -rate paces both modes evenly; otherwise replay keeps the captured spacing and a mix runs closed-loop.
+            const double Due = Rate > 0.0
+                ? RunStart + (double)State->Sent / Rate
+                : bReplay ? RunStart + ((double)Loop * CaptureSpan + Specs[NextIndex].Offset) / Speed : Now;
+            if (Due > Now)
+            {
+                break;
+            }
+
+            const int32 SpecIndex = bReplay ? NextIndex++ : PickWeighted(Weights, TotalWeight, Random);
+            Send(Url, Specs[SpecIndex], State);
+        }
+
+        if (!bIssuing)
+        {
+            if (IssueEnd == 0.0)
+            {
+                IssueEnd = Now;
+            }
+            else if (Now - IssueEnd > DrainTimeoutSeconds)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[MCP] Gave up waiting for %d outstanding requests."), State->InFlight);
+                break;
+            }
+        }
+
+        FPlatformProcess::Sleep(PollSleepSeconds);
+    }
+
+    const double Elapsed = FPlatformTime::Seconds() - RunStart;
+    bFrameStats = bFrameStats && FetchFrameBuckets(Url, LastTime, LoadEnd);
+
+    TSharedRef<FJsonObject> ReportObj = MakeShared<FJsonObject>();
+    ReportObj->SetStringField(TEXT("mode"), bReplay ? TEXT("replay") : TEXT("mix"));
+    ReportObj->SetStringField(TEXT("url"), Url);
+    ReportObj->SetNumberField(TEXT("concurrency"), Concurrency);
+    ReportObj->SetNumberField(TEXT("duration_s"), Elapsed);
+    ReportObj->SetNumberField(TEXT("sent"), State->Sent);
+    ReportObj->SetNumberField(TEXT("completed"), State->Completed);
+    ReportObj->SetNumberField(TEXT("throughput_rps"), Elapsed > 0.0 ? State->Completed / Elapsed : 0.0);
+
+    TSharedRef<FJsonObject> LatencyObj = MakeShared<FJsonObject>();
+    AddLatencyFields(LatencyObj, State->LatenciesMs);
+    ReportObj->SetObjectField(TEXT("latency_ms"), LatencyObj);
+
+    TSharedRef<FJsonObject> ErrorsObj = MakeShared<FJsonObject>();
+    ErrorsObj->SetNumberField(TEXT("total"), State->Errors);
+    ErrorsObj->SetNumberField(TEXT("rate"), State->Completed > 0 ? (double)State->Errors / State->Completed : 0.0);
+    TSharedRef<FJsonObject> ByStatusObj = MakeShared<FJsonObject>();
+    for (const TPair<int32, int32>& Pair : State->ErrorsByStatus)
+    {
+        ByStatusObj->SetNumberField(Pair.Key == 0 ? TEXT("connection") : FString::FromInt(Pair.Key), Pair.Value);
+    }
+    ErrorsObj->SetObjectField(TEXT("by_status"), ByStatusObj);
+    ReportObj->SetObjectField(TEXT("errors"), ErrorsObj);
+
+    UE_LOG(LogTemp, Display, TEXT("[MCP] %d requests in %.2fs: %.1f req/s, p50 %.2fms, p95 %.2fms, p99 %.2fms, %d errors (%.2f%%)."),
+        State->Completed, Elapsed, ReportObj->GetNumberField(TEXT("throughput_rps")),
+        LatencyObj->GetNumberField(TEXT("p50")), LatencyObj->GetNumberField(TEXT("p95")), LatencyObj->GetNumberField(TEXT("p99")),
+        State->Errors, ErrorsObj->GetNumberField(TEXT("rate")) * 100.0);
+    for (const TPair<int32, int32>& Pair : State->ErrorsByStatus)
+    {
+        UE_LOG(LogTemp, Display, TEXT("[MCP]   status %s: %d"), Pair.Key == 0 ? TEXT("connection") : *FString::FromInt(Pair.Key), Pair.Value);
+    }
+
+    TSharedRef<FJsonObject> ActionsObj = MakeShared<FJsonObject>();
+    for (TPair<FString, FActionReport>& Pair : State->Actions)
+    {
+        TSharedRef<FJsonObject> ActionObj = MakeShared<FJsonObject>();
+        ActionObj->SetNumberField(TEXT("requests"), Pair.Value.Requests);
+        ActionObj->SetNumberField(TEXT("errors"), Pair.Value.Errors);
+        AddLatencyFields(ActionObj, Pair.Value.LatenciesMs);
+        ActionsObj->SetObjectField(Pair.Key, ActionObj);
+
+        UE_LOG(LogTemp, Display, TEXT("[MCP]   %-28s %6d req %5d err  p50 %8.2fms  p95 %8.2fms  p99 %8.2fms"),
+            *Pair.Key, Pair.Value.Requests, Pair.Value.Errors,
+            ActionObj->GetNumberField(TEXT("p50")), ActionObj->GetNumberField(TEXT("p95")), ActionObj->GetNumberField(TEXT("p99")));
+    }
+    ReportObj->SetObjectField(TEXT("actions"), ActionsObj);
+
+    if (bFrameStats)
+    {
+        TSharedRef<FJsonObject> FrameObj = MakeShared<FJsonObject>();
+        if (Baseline > 0.0)
+        {
+            FrameObj->SetObjectField(TEXT("idle"), BuildFrameWindow(IdleBegin, LoadBegin));
+        }
+        FrameObj->SetObjectField(TEXT("load"), BuildFrameWindow(LoadBegin, LoadEnd));
+        ReportObj->SetObjectField(TEXT("frame_time_ms"), FrameObj);
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Window : FrameObj->Values)
+        {
+            const TSharedPtr<FJsonObject> WindowObj = Window.Value->AsObject();
+            UE_LOG(LogTemp, Display, TEXT("[MCP] Frame time (%s): p50 %.2fms, p95 %.2fms, p99 %.2fms over %d frames."),
+                *Window.Key, WindowObj->GetNumberField(TEXT("p50")), WindowObj->GetNumberField(TEXT("p95")),
+                WindowObj->GetNumberField(TEXT("p99")), (int32)WindowObj->GetNumberField(TEXT("count")));
+        }
+    }
+
+    if (!OutPath.IsEmpty())
+    {
+        FString ReportJson;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportJson);
+        FJsonSerializer::Serialize(ReportObj, Writer);
+        if (!FFileHelper::SaveStringToFile(ReportJson, *OutPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[MCP] Could not write report to %s"), *OutPath);
+            return 1;
+        }
+        UE_LOG(LogTemp, Display, TEXT("[MCP] Report written to %s"), *OutPath);
+    }
+
+    return 0;
+}
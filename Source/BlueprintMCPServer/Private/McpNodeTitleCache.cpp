@@ -0,0 +1,113 @@
+#include "McpNodeTitleCache.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "McpTrace.h"
+#include "UObject/UObjectGlobals.h"
+
+TUniquePtr<FMcpNodeTitleCache> FMcpNodeTitleCache::Instance;
+
+FMcpNodeTitleCache& FMcpNodeTitleCache::Get()
+{
+    check(IsInGameThread());
+    if (!Instance.IsValid())
+    {
+        Instance = TUniquePtr<FMcpNodeTitleCache>(new FMcpNodeTitleCache());
+    }
+    Instance->RegisterEditorHooks();
+    return *Instance;
+}
+
+void FMcpNodeTitleCache::Shutdown()
+{
+    Instance.Reset();
+}
+
+FMcpNodeTitleCache::FMcpNodeTitleCache()
+{
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMcpNodeTitleCache::OnObjectModified);
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FMcpNodeTitleCache::PurgeStale);
+    FMcpServerMetrics::Get().RegisterCache(TEXT("node_titles"), &Counters);
+}
+
+FMcpNodeTitleCache::~FMcpNodeTitleCache()
+{
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+    if (GEditor && BlueprintCompiledHandle.IsValid())
+    {
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+    }
+    FMcpServerMetrics::Get().UnregisterCache(&Counters);
+}
+
+void FMcpNodeTitleCache::RegisterEditorHooks()
+{
+    if (GEditor && !BlueprintCompiledHandle.IsValid())
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMcpNodeTitleCache::OnBlueprintCompiled);
+    }
+}
+
+const FString& FMcpNodeTitleCache::GetTitle(const UEdGraphNode* Node)
+{
+    const UBlueprint* Blueprint = Node->GetTypedOuter<UBlueprint>();
+    if (!Blueprint || !Node->NodeGuid.IsValid())
+    {
+        MCP_TRACE_SCOPE("Mcp::GetNodeTitle");
+        UncachedTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+        return UncachedTitle;
+    }
+
+    TMap<FGuid, FString>& Titles = Blueprints.FindOrAdd(Blueprint).Titles;
+    if (const FString* Cached = Titles.Find(Node->NodeGuid))
+    {
+        Counters.Record(true);
+        return *Cached;
+    }
+
+    Counters.Record(false);
+    MCP_TRACE_SCOPE("Mcp::GetNodeTitle");
+    return Titles.Add(Node->NodeGuid, Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+}
+
+void FMcpNodeTitleCache::Invalidate(const UBlueprint* Blueprint)
+{
+    Blueprints.Remove(Blueprint);
+}
+
+void FMcpNodeTitleCache::OnObjectModified(UObject* Object)
+{
+    if (Blueprints.Num() == 0 || !Object)
+    {
+        return;
+    }
+
+    if (const UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+    {
+        Invalidate(Blueprint);
+    }
+    else if (Object->IsA<UEdGraphNode>() || Object->IsA<UEdGraph>())
+    {
+        Invalidate(Object->GetTypedOuter<UBlueprint>());
+    }
+}
+
+void FMcpNodeTitleCache::OnBlueprintCompiled()
+{
+    // Compiling one Blueprint can change the titles of call nodes in others that use its functions.
+    Blueprints.Reset();
+}
+
+void FMcpNodeTitleCache::PurgeStale()
+{
+    for (auto It = Blueprints.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
@@ -0,0 +1,599 @@
+#include "McpProjectExport.h"
+
+#include "Async/Async.h"
+#include "HAL/PlatformMemory.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "IO/IoHash.h"
+#include "Json.h"
+#include "McpTrace.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace McpProjectExport
+{
+    static constexpr int32 ManifestVersion = 1;
+    static constexpr int32 MaxBatchesInFlight = 4;
+    static constexpr int32 MaxShardsInFlight = 4;
+    static constexpr int32 MaxReportedFailures = 50;
+
+    static const TCHAR* ManifestName = TEXT("manifest.json");
+
+    static TArray<uint8> SerializeLines(const TArray<TSharedRef<FJsonObject>>& Records)
+    {
+        MCP_TRACE_SCOPE("Mcp::Export::Serialize");
+
+        TArray<FString> Lines;
+        Lines.SetNum(Records.Num());
+        ParallelFor(Records.Num(), [&Records, &Lines](int32 Index)
+        {
+            TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Lines[Index]);
+            FJsonSerializer::Serialize(Records[Index], Writer);
+        });
+
+        TArray<uint8> Bytes;
+        for (const FString& Line : Lines)
+        {
+            FTCHARToUTF8 Utf8(*Line);
+            Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+            Bytes.Add('\n');
+        }
+        return Bytes;
+    }
+}
+
+FMcpProjectExporter::~FMcpProjectExporter()
+{
+    Cancel();
+}
+
+FString FMcpProjectExporter::GetDefaultOutputDir()
+{
+    return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("BlueprintMCP/Export"));
+}
+
+FString FMcpProjectExporter::GetManifestPath() const
+{
+    return Config.OutputDir / McpProjectExport::ManifestName;
+}
+
+bool FMcpProjectExporter::Start(const FMcpProjectExportConfig& InConfig, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Export::Start");
+
+    if (IsRunning())
+    {
+        OutError = TEXT("An export is already running.");
+        return false;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        OutError = TEXT("The asset registry is still scanning; retry once it has finished.");
+        return false;
+    }
+
+    Config = InConfig;
+    Config.BatchSize = FMath::Clamp(Config.BatchSize, 1, 1024);
+    Config.ShardSize = FMath::Max(Config.ShardSize, 1);
+    Config.GcEveryBatches = FMath::Max(Config.GcEveryBatches, 1);
+    Config.GcMemoryGrowthMB = FMath::Max(Config.GcMemoryGrowthMB, 1);
+    Config.OutputDir = FPaths::ConvertRelativePathToFull(Config.OutputDir.IsEmpty() ? GetDefaultOutputDir() : Config.OutputDir);
+    if (!IFileManager::Get().MakeDirectory(*Config.OutputDir, /*Tree=*/true))
+    {
+        OutError = FString::Printf(TEXT("Failed to create '%s'."), *Config.OutputDir);
+        return false;
+    }
+
+    TMap<FString, FAssetEntry> PreviousAssets;
+    TMap<FString, FShardResult> PreviousShards;
+    int32 PreviousGeneration = 0;
+    if (!ReadManifest(PreviousAssets, PreviousShards, PreviousGeneration, OutError))
+    {
+        return false;
+    }
+
+    Status = EStatus::Running;
+    Error.Reset();
+    Generation = PreviousGeneration + 1;
+    StartTime = FPlatformTime::Seconds();
+    EndTime = 0.0;
+    Pending.Reset();
+    NextPending = 0;
+    Exported = 0;
+    Unchanged = 0;
+    Failures.Reset();
+    NumFailures = 0;
+    BatchesSinceGc = 0;
+    UsedPhysicalAfterGc = FPlatformMemory::GetStats().UsedPhysical;
+    NumGarbageCollections = 0;
+    Assets.Reset();
+    Shards.Reset();
+    WrittenShardFiles.Reset();
+    StaleShardFiles.Reset();
+    NextShard = 0;
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    for (const FString& Root : Config.Roots)
+    {
+        Filter.PackagePaths.Emplace(*Root);
+    }
+    Filter.bRecursivePaths = Config.Roots.Num() > 0;
+
+    TArray<FAssetData> AssetDatas;
+    AssetRegistry.GetAssets(Filter, AssetDatas);
+
+    for (const FAssetData& Data : AssetDatas)
+    {
+        FPendingAsset Asset;
+        Asset.ObjectPath = Data.GetObjectPathString();
+        Asset.PackageName = Data.PackageName;
+        if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Data.PackageName))
+        {
+            Asset.PackageHash = LexToString(PackageData->GetPackageSavedHash());
+        }
+        const UPackage* LoadedPackage = FindPackage(nullptr, *Data.PackageName.ToString());
+        Asset.bDirty = LoadedPackage && LoadedPackage->IsDirty();
+
+        // Dirty packages differ from their saved hash, so they are always re-exported and never reused.
+        const FAssetEntry* Previous = Config.bIncremental ? PreviousAssets.Find(Asset.ObjectPath) : nullptr;
+        if (Previous && !Previous->bDirty && !Asset.bDirty && !Asset.PackageHash.IsEmpty()
+            && Previous->PackageHash == Asset.PackageHash && PreviousShards.Contains(Previous->Shard))
+        {
+            Assets.Add(Asset.ObjectPath, *Previous);
+            ++Unchanged;
+            continue;
+        }
+        Pending.Add(MoveTemp(Asset));
+    }
+
+    for (const TPair<FString, FAssetEntry>& Pair : Assets)
+    {
+        Shards.Add(Pair.Value.Shard, PreviousShards.FindChecked(Pair.Value.Shard));
+    }
+    for (const TPair<FString, FShardResult>& Pair : PreviousShards)
+    {
+        if (!Shards.Contains(Pair.Key))
+        {
+            StaleShardFiles.Add(Pair.Key);
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Exporting %d Blueprints to %s (%d unchanged)."), Pending.Num(), *Config.OutputDir, Unchanged);
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMcpProjectExporter::Tick));
+    return true;
+}
+
+void FMcpProjectExporter::Cancel()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    Finish(EStatus::Cancelled);
+}
+
+bool FMcpProjectExporter::Tick(float DeltaTime)
+{
+    MCP_TRACE_SCOPE("Mcp::Export::Tick");
+
+    CollectBatches(/*bWait=*/false);
+    CollectShards(/*bWait=*/false);
+    if (Status != EStatus::Running)
+    {
+        return false;
+    }
+
+    if (NextPending < Pending.Num())
+    {
+        // Loading runs ahead of the writers by a few batches at most.
+        if (PendingBatches.Num() < McpProjectExport::MaxBatchesInFlight && PendingShards.Num() < McpProjectExport::MaxShardsInFlight)
+        {
+            ExportBatch();
+        }
+        return true;
+    }
+
+    CollectBatches(/*bWait=*/true);
+    FlushShard();
+    CollectShards(/*bWait=*/true);
+    if (Status != EStatus::Running)
+    {
+        return false;
+    }
+
+    FString ManifestError;
+    if (WriteManifest(ManifestError))
+    {
+        Finish(EStatus::Finished);
+    }
+    else
+    {
+        Finish(EStatus::Failed, ManifestError);
+    }
+    return false;
+}
+
+void FMcpProjectExporter::ExportBatch()
+{
+    MCP_TRACE_SCOPE("Mcp::Export::Batch");
+
+    // Blueprints that were already in memory (open in an editor, loaded by another tool) are left alone.
+    TArray<UPackage*> LoadedPackages;
+    FBatch Batch;
+    TArray<TSharedRef<FJsonObject>> Records;
+    const int32 End = FMath::Min(NextPending + Config.BatchSize, Pending.Num());
+    for (; NextPending < End; ++NextPending)
+    {
+        const FPendingAsset& Asset = Pending[NextPending];
+
+        const bool bWasLoaded = FindPackage(nullptr, *Asset.PackageName.ToString()) != nullptr;
+        UBlueprint* Blueprint = nullptr;
+        {
+            MCP_TRACE_SCOPE("Mcp::LoadObject");
+            Blueprint = LoadObject<UBlueprint>(nullptr, *Asset.ObjectPath);
+        }
+        if (Blueprint && !bWasLoaded)
+        {
+            LoadedPackages.AddUnique(Blueprint->GetPackage());
+        }
+
+        FString AssetError = TEXT("Failed to load Blueprint");
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        if (Blueprint && FMcpBlueprintInspector::BuildBlueprintJson(Blueprint, Json, AssetError, Config.Options))
+        {
+            Json->SetStringField(TEXT("package_hash"), Asset.PackageHash);
+            Records.Add(Json);
+            Batch.Assets.Add(Asset.ObjectPath);
+
+            FAssetEntry& Entry = Assets.Add(Asset.ObjectPath);
+            Entry.PackageHash = Asset.PackageHash;
+            Entry.bDirty = Asset.bDirty;
+            continue;
+        }
+
+        ++NumFailures;
+        if (Failures.Num() < McpProjectExport::MaxReportedFailures)
+        {
+            Failures.Add(FString::Printf(TEXT("%s: %s"), *Asset.ObjectPath, *AssetError));
+        }
+    }
+
+    ReleaseLoadedPackages(LoadedPackages);
+
+    if (Records.Num() > 0)
+    {
+        Exported += Records.Num();
+        Batch.Lines = Async(EAsyncExecution::ThreadPool, [Records = MoveTemp(Records)]()
+        {
+            return McpProjectExport::SerializeLines(Records);
+        });
+        PendingBatches.Add(MoveTemp(Batch));
+    }
+}
+
+void FMcpProjectExporter::CollectBatches(bool bWait)
+{
+    while (PendingBatches.Num() > 0 && (bWait || PendingBatches[0].Lines.IsReady()))
+    {
+        FBatch Batch = MoveTemp(PendingBatches[0]);
+        PendingBatches.RemoveAt(0);
+
+        ShardBuffer.Append(Batch.Lines.Get());
+        ShardAssets.Append(MoveTemp(Batch.Assets));
+        if (ShardAssets.Num() >= Config.ShardSize)
+        {
+            FlushShard();
+        }
+    }
+}
+
+void FMcpProjectExporter::FlushShard()
+{
+    if (ShardAssets.Num() == 0)
+    {
+        return;
+    }
+
+    const FString File = FString::Printf(TEXT("shard_%04d_%04d.ndjson%s"), Generation, NextShard++, Config.bCompress ? TEXT(".gz") : TEXT(""));
+    for (const FString& AssetPath : ShardAssets)
+    {
+        Assets.FindChecked(AssetPath).Shard = File;
+    }
+    WrittenShardFiles.Add(File);
+
+    PendingShards.Add(Async(EAsyncExecution::ThreadPool, [File, Path = Config.OutputDir / File, Records = ShardAssets.Num(), Buffer = MoveTemp(ShardBuffer), bCompress = Config.bCompress]() mutable
+    {
+        MCP_TRACE_SCOPE("Mcp::Export::WriteShard");
+
+        FShardResult Result;
+        Result.File = File;
+        Result.Records = Records;
+
+        if (bCompress)
+        {
+            int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Buffer.Num());
+            TArray<uint8> Compressed;
+            Compressed.SetNumUninitialized(CompressedSize);
+            if (!FCompression::CompressMemory(NAME_Gzip, Compressed.GetData(), CompressedSize, Buffer.GetData(), Buffer.Num()))
+            {
+                Result.Error = FString::Printf(TEXT("Failed to compress '%s'."), *File);
+                return Result;
+            }
+            Compressed.SetNum(CompressedSize);
+            Buffer = MoveTemp(Compressed);
+        }
+
+        Result.Bytes = Buffer.Num();
+        Result.Hash = FMD5::HashBytes(Buffer.GetData(), Buffer.Num());
+        if (!FFileHelper::SaveArrayToFile(Buffer, *Path))
+        {
+            Result.Error = FString::Printf(TEXT("Failed to write '%s'."), *Path);
+        }
+        return Result;
+    }));
+
+    ShardBuffer.Reset();
+    ShardAssets.Reset();
+}
+
+void FMcpProjectExporter::CollectShards(bool bWait)
+{
+    while (PendingShards.Num() > 0 && (bWait || PendingShards[0].IsReady()))
+    {
+        FShardResult Result = PendingShards[0].Get();
+        PendingShards.RemoveAt(0);
+
+        if (!Result.Error.IsEmpty())
+        {
+            Finish(EStatus::Failed, Result.Error);
+            return;
+        }
+        Shards.Add(Result.File, MoveTemp(Result));
+    }
+}
+
+void FMcpProjectExporter::ReleaseLoadedPackages(const TArray<UPackage*>& LoadedPackages)
+{
+    MCP_TRACE_SCOPE("Mcp::Export::Release");
+
+    // Only Blueprint packages this batch loaded lose RF_Standalone; one edited since stays resident.
+    // Their dependencies go with them once nothing else references them.
+    for (UPackage* Package : LoadedPackages)
+    {
+        if (Package->IsDirty())
+        {
+            continue;
+        }
+
+        ForEachObjectWithPackage(Package, [](UObject* Object)
+        {
+            Object->ClearFlags(RF_Standalone);
+            return true;
+        });
+    }
+
+    if (LoadedPackages.Num() > 0)
+    {
+        ++BatchesSinceGc;
+    }
+    if (BatchesSinceGc == 0)
+    {
+        return;
+    }
+
+    // A full GC stalls the editor, so it runs every few batches unless memory is climbing faster.
+    const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+    const uint64 GrowthLimit = (uint64)Config.GcMemoryGrowthMB * 1024 * 1024;
+    if (BatchesSinceGc < Config.GcEveryBatches && UsedPhysical < UsedPhysicalAfterGc + GrowthLimit)
+    {
+        return;
+    }
+
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    BatchesSinceGc = 0;
+    UsedPhysicalAfterGc = FPlatformMemory::GetStats().UsedPhysical;
+    ++NumGarbageCollections;
+}
+
+bool FMcpProjectExporter::ReadManifest(TMap<FString, FAssetEntry>& OutAssets, TMap<FString, FShardResult>& OutShards, int32& OutGeneration, FString& OutError) const
+{
+    FString Text;
+    if (!FFileHelper::LoadFileToString(Text, *GetManifestPath()))
+    {
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> ManifestObj;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+    int32 Version = 0;
+    if (!FJsonSerializer::Deserialize(Reader, ManifestObj) || !ManifestObj.IsValid()
+        || !ManifestObj->TryGetNumberField(TEXT("version"), Version) || Version != McpProjectExport::ManifestVersion)
+    {
+        OutError = FString::Printf(TEXT("'%s' is not a version %d export manifest; remove it or pick another output directory."), *GetManifestPath(), McpProjectExport::ManifestVersion);
+        return false;
+    }
+
+    ManifestObj->TryGetNumberField(TEXT("generation"), OutGeneration);
+
+    const TArray<TSharedPtr<FJsonValue>>* ShardArray = nullptr;
+    if (ManifestObj->TryGetArrayField(TEXT("shards"), ShardArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *ShardArray)
+        {
+            const TSharedPtr<FJsonObject>* ShardObj = nullptr;
+            FShardResult Shard;
+            if (Value->TryGetObject(ShardObj) && (*ShardObj)->TryGetStringField(TEXT("file"), Shard.File))
+            {
+                (*ShardObj)->TryGetNumberField(TEXT("records"), Shard.Records);
+                (*ShardObj)->TryGetNumberField(TEXT("bytes"), Shard.Bytes);
+                (*ShardObj)->TryGetStringField(TEXT("md5"), Shard.Hash);
+                OutShards.Add(Shard.File, MoveTemp(Shard));
+            }
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* AssetsObj = nullptr;
+    if (ManifestObj->TryGetObjectField(TEXT("assets"), AssetsObj))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*AssetsObj)->Values)
+        {
+            const TSharedPtr<FJsonObject>* AssetObj = nullptr;
+            if (Pair.Value->TryGetObject(AssetObj))
+            {
+                FAssetEntry& Entry = OutAssets.Add(Pair.Key);
+                (*AssetObj)->TryGetStringField(TEXT("package_hash"), Entry.PackageHash);
+                (*AssetObj)->TryGetStringField(TEXT("shard"), Entry.Shard);
+                (*AssetObj)->TryGetBoolField(TEXT("dirty"), Entry.bDirty);
+            }
+        }
+    }
+    return true;
+}
+
+bool FMcpProjectExporter::WriteManifest(FString& OutError) const
+{
+    MCP_TRACE_SCOPE("Mcp::Export::WriteManifest");
+
+    TSharedRef<FJsonObject> ManifestObj = MakeShared<FJsonObject>();
+    ManifestObj->SetNumberField(TEXT("version"), McpProjectExport::ManifestVersion);
+    ManifestObj->SetNumberField(TEXT("generation"), Generation);
+    ManifestObj->SetStringField(TEXT("created"), FDateTime::UtcNow().ToIso8601());
+    ManifestObj->SetNumberField(TEXT("asset_count"), Assets.Num());
+
+    TArray<TSharedPtr<FJsonValue>> RootArray;
+    for (const FString& Root : Config.Roots)
+    {
+        RootArray.Add(MakeShared<FJsonValueString>(Root));
+    }
+    ManifestObj->SetArrayField(TEXT("roots"), RootArray);
+
+    TArray<TSharedPtr<FJsonValue>> ShardArray;
+    for (const TPair<FString, FShardResult>& Pair : Shards)
+    {
+        TSharedRef<FJsonObject> ShardObj = MakeShared<FJsonObject>();
+        ShardObj->SetStringField(TEXT("file"), Pair.Value.File);
+        ShardObj->SetNumberField(TEXT("records"), Pair.Value.Records);
+        ShardObj->SetNumberField(TEXT("bytes"), Pair.Value.Bytes);
+        ShardObj->SetStringField(TEXT("md5"), Pair.Value.Hash);
+        ShardArray.Add(MakeShared<FJsonValueObject>(ShardObj));
+    }
+    ManifestObj->SetArrayField(TEXT("shards"), ShardArray);
+
+    TSharedRef<FJsonObject> AssetsObj = MakeShared<FJsonObject>();
+    for (const TPair<FString, FAssetEntry>& Pair : Assets)
+    {
+        TSharedRef<FJsonObject> AssetObj = MakeShared<FJsonObject>();
+        AssetObj->SetStringField(TEXT("package_hash"), Pair.Value.PackageHash);
+        AssetObj->SetStringField(TEXT("shard"), Pair.Value.Shard);
+        if (Pair.Value.bDirty)
+        {
+            AssetObj->SetBoolField(TEXT("dirty"), true);
+        }
+        AssetsObj->SetObjectField(Pair.Key, AssetObj);
+    }
+    ManifestObj->SetObjectField(TEXT("assets"), AssetsObj);
+
+    FString Text;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Text);
+    FJsonSerializer::Serialize(ManifestObj, Writer);
+
+    // Written beside the old manifest and moved over it, so readers never see a partial file.
+    const FString TempPath = GetManifestPath() + TEXT(".tmp");
+    if (!FFileHelper::SaveStringToFile(Text, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+        || !IFileManager::Get().Move(*GetManifestPath(), *TempPath, /*Replace=*/true))
+    {
+        OutError = FString::Printf(TEXT("Failed to write '%s'."), *GetManifestPath());
+        return false;
+    }
+    return true;
+}
+
+void FMcpProjectExporter::Finish(EStatus InStatus, const FString& InError)
+{
+    TickerHandle.Reset();
+
+    for (FBatch& Batch : PendingBatches)
+    {
+        Batch.Lines.Wait();
+    }
+    for (TFuture<FShardResult>& Shard : PendingShards)
+    {
+        Shard.Wait();
+    }
+    PendingBatches.Reset();
+    PendingShards.Reset();
+    ShardBuffer.Empty();
+    ShardAssets.Empty();
+
+    // A finished run drops shards the new manifest no longer names; any other outcome keeps the
+    // previous export intact and drops what this run wrote.
+    for (const FString& File : InStatus == EStatus::Finished ? StaleShardFiles : WrittenShardFiles)
+    {
+        IFileManager::Get().Delete(*(Config.OutputDir / File), /*RequireExists=*/false, /*EvenReadOnly=*/false, /*Quiet=*/true);
+    }
+
+    Status = InStatus;
+    Error = InError;
+    EndTime = FPlatformTime::Seconds();
+
+    if (Status == EStatus::Failed)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[MCP] Export failed: %s"), *Error);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Display, TEXT("[MCP] Export %s after %.2fs: %d exported, %d unchanged, %d failed, %d shards."),
+            Status == EStatus::Finished ? TEXT("finished") : TEXT("cancelled"), EndTime - StartTime, Exported, Unchanged, NumFailures, Shards.Num());
+    }
+}
+
+TSharedRef<FJsonObject> FMcpProjectExporter::BuildStatusJson() const
+{
+    static const TCHAR* StatusNames[] = { TEXT("idle"), TEXT("running"), TEXT("finished"), TEXT("cancelled"), TEXT("failed") };
+
+    TSharedRef<FJsonObject> StatusObj = MakeShared<FJsonObject>();
+    StatusObj->SetStringField(TEXT("status"), StatusNames[(int32)Status]);
+    if (Status == EStatus::Idle)
+    {
+        return StatusObj;
+    }
+
+    StatusObj->SetStringField(TEXT("output_dir"), Config.OutputDir);
+    StatusObj->SetStringField(TEXT("manifest"), GetManifestPath());
+    StatusObj->SetNumberField(TEXT("generation"), Generation);
+    StatusObj->SetNumberField(TEXT("total"), Pending.Num() + Unchanged);
+    StatusObj->SetNumberField(TEXT("exported"), Exported);
+    StatusObj->SetNumberField(TEXT("unchanged"), Unchanged);
+    StatusObj->SetNumberField(TEXT("remaining"), Status == EStatus::Running ? Pending.Num() - NextPending : 0);
+    StatusObj->SetNumberField(TEXT("failed"), NumFailures);
+    StatusObj->SetNumberField(TEXT("shards_written"), WrittenShardFiles.Num());
+    StatusObj->SetNumberField(TEXT("garbage_collections"), NumGarbageCollections);
+    StatusObj->SetNumberField(TEXT("elapsed_s"), (Status == EStatus::Running ? FPlatformTime::Seconds() : EndTime) - StartTime);
+
+    if (Failures.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> FailureArray;
+        for (const FString& Failure : Failures)
+        {
+            FailureArray.Add(MakeShared<FJsonValueString>(Failure));
+        }
+        StatusObj->SetArrayField(TEXT("failures"), FailureArray);
+    }
+    if (!Error.IsEmpty())
+    {
+        StatusObj->SetStringField(TEXT("error"), Error);
+    }
+    return StatusObj;
+}
@@ -0,0 +1,201 @@
+#include "McpRequestRecorder.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Json.h"
+#include "McpTrace.h"
+#include "Misc/Paths.h"
+
+namespace McpRequestRecorder
+{
+    static constexpr int32 MaxPendingLines = 65536;
+    static constexpr uint32 FlushIntervalMs = 200;
+
+    static void StartFromConsole(const TArray<FString>& Args)
+    {
+        const FString Path = Args.Num() > 0
+            ? Args[0]
+            : FPaths::ProjectSavedDir() / TEXT("BlueprintMCP") / TEXT("Captures") / FString::Printf(TEXT("capture-%s.jsonl"), *FDateTime::Now().ToString());
+
+        FString Error;
+        if (FMcpRequestRecorder::Get().Start(Path, Error))
+        {
+            UE_LOG(LogTemp, Display, TEXT("[MCP] Capturing requests to %s"), *FMcpRequestRecorder::Get().GetPath());
+        }
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("[MCP] %s"), *Error);
+        }
+    }
+
+    static void StopFromConsole()
+    {
+        const FString Path = FMcpRequestRecorder::Get().GetPath();
+        FMcpRequestRecorder::Get().Shutdown();
+        UE_LOG(LogTemp, Display, TEXT("[MCP] Capture stopped: %s"), *Path);
+    }
+
+    static FAutoConsoleCommand StartCommand(
+        TEXT("Mcp.Capture.Start"),
+        TEXT("Records incoming MCP requests for replay with -run=McpLoadGen. Arg: optional output path (default Saved/BlueprintMCP/Captures)."),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&StartFromConsole));
+
+    static FAutoConsoleCommand StopCommand(
+        TEXT("Mcp.Capture.Stop"),
+        TEXT("Stops recording MCP requests."),
+        FConsoleCommandDelegate::CreateStatic(&StopFromConsole));
+}
+
+FMcpRequestRecorder& FMcpRequestRecorder::Get()
+{
+    static FMcpRequestRecorder Instance;
+    return Instance;
+}
+
+FMcpRequestRecorder::~FMcpRequestRecorder()
+{
+    Shutdown();
+}
+
+bool FMcpRequestRecorder::Start(const FString& InPath, FString& OutError)
+{
+    if (Thread)
+    {
+        OutError = FString::Printf(TEXT("Already capturing to '%s'."), *FilePath);
+        return false;
+    }
+
+    FilePath = FPaths::ConvertRelativePathToFull(InPath);
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), /*Tree=*/true);
+    FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath));
+    if (!FileHandle)
+    {
+        OutError = FString::Printf(TEXT("Failed to open capture file '%s'."), *FilePath);
+        return false;
+    }
+
+    const FString Header = FString::Printf(TEXT("{\"format\":\"mcp-capture\",\"version\":1,\"started\":\"%s\"}\n"), *FDateTime::UtcNow().ToIso8601());
+    const FTCHARToUTF8 HeaderUtf8(*Header);
+    FileHandle->Write(reinterpret_cast<const uint8*>(HeaderUtf8.Get()), HeaderUtf8.Length());
+
+    // Drop anything a racing Record() enqueued after the previous capture stopped.
+    Pending.Empty();
+    PendingCount = 0;
+
+    StartTime = FPlatformTime::Seconds();
+    bStopping = false;
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("McpRequestRecorder"), 0, TPri_BelowNormal);
+    if (!Thread)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+        FileHandle.Reset();
+        OutError = TEXT("Failed to create capture writer thread.");
+        return false;
+    }
+
+    bRecording = true;
+    return true;
+}
+
+void FMcpRequestRecorder::Shutdown()
+{
+    bRecording = false;
+
+    if (Thread)
+    {
+        Thread->Kill(/*bShouldWait=*/true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    FileHandle.Reset();
+}
+
+void FMcpRequestRecorder::Record(const TCHAR* Transport, const FString& Client, const FString& Action, const TSharedPtr<FJsonObject>& Payload)
+{
+    if (!bRecording.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    if (PendingCount.fetch_add(1, std::memory_order_relaxed) >= McpRequestRecorder::MaxPendingLines)
+    {
+        PendingCount.fetch_sub(1, std::memory_order_relaxed);
+        DroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    MCP_TRACE_SCOPE("Mcp::Capture::Record");
+
+    // Params are serialized here because the payload is still read by the action afterwards.
+    TSharedRef<FJsonObject> LineObj = MakeShared<FJsonObject>();
+    LineObj->SetNumberField(TEXT("t"), FPlatformTime::Seconds() - StartTime);
+    LineObj->SetStringField(TEXT("transport"), Transport);
+    LineObj->SetStringField(TEXT("client"), Client);
+    LineObj->SetStringField(TEXT("action"), Action);
+    LineObj->SetObjectField(TEXT("params"), Payload.IsValid() ? Payload : MakeShared<FJsonObject>());
+
+    FString Line;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+    FJsonSerializer::Serialize(LineObj, Writer);
+    Line += TEXT('\n');
+
+    Pending.Enqueue(MoveTemp(Line));
+}
+
+void FMcpRequestRecorder::Stop()
+{
+    bStopping = true;
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+uint32 FMcpRequestRecorder::Run()
+{
+    while (!bStopping)
+    {
+        WakeEvent->Wait(McpRequestRecorder::FlushIntervalMs);
+        WritePending();
+    }
+
+    WritePending();
+    return 0;
+}
+
+void FMcpRequestRecorder::WritePending()
+{
+    MCP_TRACE_SCOPE("Mcp::Capture::Write");
+
+    const int32 Dropped = DroppedCount.exchange(0, std::memory_order_relaxed);
+    if (Dropped > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[MCP] Capture dropped %d requests (writer behind)."), Dropped);
+    }
+
+    int32 NumWritten = 0;
+    FString Line;
+    while (Pending.Dequeue(Line))
+    {
+        const FTCHARToUTF8 Utf8(*Line, Line.Len());
+        FileHandle->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        ++NumWritten;
+    }
+    PendingCount.fetch_sub(NumWritten, std::memory_order_relaxed);
+
+    if (NumWritten > 0)
+    {
+        FileHandle->Flush();
+    }
+}
@@ -1,5 +1,6 @@
 #include "McpServer.h"
 
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "Async/Async.h"
 #include "BlueprintInspector.h"
 #include "BlueprintMutator.h"
@@ -11,13 +12,262 @@
 #include "IHttpRouter.h"
 #include "Json.h"
 #include "JsonUtilities.h"
+#include "McpAccessLog.h"
+#include "McpAdmissionController.h"
+#include "McpBlueprintCache.h"
+#include "McpBlueprintDiff.h"
+#include "McpBulkRefactor.h"
+#include "McpEventStream.h"
+#include "McpGraphQuery.h"
+#include "McpGraphTopology.h"
+#include "McpImpactAnalysis.h"
+#include "McpProjectExport.h"
+#include "McpTemplateLibrary.h"
+#include "McpTimeSlicer.h"
+#include "McpRequestRecorder.h"
+#include "McpServerMetrics.h"
+#include "McpSymbolResolver.h"
+#include "McpTrace.h"
+#include "McpUnixSocketTransport.h"
+#include "McpValidationSandbox.h"
+#include "McpWarmup.h"
+#include "McpWebSocketTransport.h"
 #include "HAL/PlatformProcess.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+namespace McpServer
+{
+    static constexpr int32 MaxPendingLogEntries = 8192;
+    // Upper bound for query_graph's max_blueprints; a root scan may load this many Blueprints.
+    static constexpr int32 MaxQueryBlueprints = 2000;
+
+    // Every action DispatchAction handles; metrics count anything else under "other".
+    static const TCHAR* KnownActions[] =
+    {
+        TEXT("add_call_function_node"),
+        TEXT("add_component"),
+        TEXT("add_event_node"),
+        TEXT("add_function_graph"),
+        TEXT("add_input_action_event"),
+        TEXT("add_variable"),
+        TEXT("apply_graph"),
+        TEXT("bulk_refactor"),
+        TEXT("capture_template"),
+        TEXT("compile_blueprint"),
+        TEXT("connect_pins"),
+        TEXT("create_blueprint"),
+        TEXT("diff_blueprints"),
+        TEXT("export_project"),
+        TEXT("get_blueprint_structure"),
+        TEXT("get_export_status"),
+        TEXT("get_graph_topology"),
+        TEXT("get_refactor_status"),
+        TEXT("get_references"),
+        TEXT("get_server_stats"),
+        TEXT("impact_analysis"),
+        TEXT("instantiate_template"),
+        TEXT("list_blueprints"),
+        TEXT("list_templates"),
+        TEXT("query_graph"),
+        TEXT("resolve_symbols"),
+        TEXT("save_blueprint"),
+        TEXT("set_pin_default"),
+        TEXT("shutdown"),
+        TEXT("validate_edits")
+    };
+
+    static bool IsReadAction(const FString& Action)
+    {
+        return Action == TEXT("list_blueprints")
+            || Action == TEXT("get_blueprint_structure")
+            || Action == TEXT("get_references")
+            || Action == TEXT("get_server_stats")
+            || Action == TEXT("list_templates")
+            || Action == TEXT("resolve_symbols")
+            || Action == TEXT("impact_analysis")
+            || Action == TEXT("validate_edits")
+            || Action == TEXT("diff_blueprints")
+            || Action == TEXT("query_graph")
+            || Action == TEXT("get_graph_topology")
+            || Action == TEXT("export_project")
+            || Action == TEXT("get_export_status")
+            || Action == TEXT("get_refactor_status");
+    }
+
+    // Actions that only query the asset registry or server state and may run on any thread.
+    static bool IsThreadSafeAction(const FString& Action)
+    {
+        return Action == TEXT("list_blueprints")
+            || Action == TEXT("get_references")
+            || Action == TEXT("get_server_stats")
+            || Action == TEXT("shutdown");
+    }
+
+    // Edits that validate_edits may replay on a transient copy; all of them target `asset_path`.
+    static bool IsValidatableAction(const FString& Action)
+    {
+        return Action == TEXT("add_variable")
+            || Action == TEXT("add_function_graph")
+            || Action == TEXT("add_call_function_node")
+            || Action == TEXT("add_event_node")
+            || Action == TEXT("add_input_action_event")
+            || Action == TEXT("add_component")
+            || Action == TEXT("set_pin_default")
+            || Action == TEXT("connect_pins")
+            || Action == TEXT("apply_graph");
+    }
+
+    static void ReadExportOptions(const FJsonObject& Payload, FMcpExportOptions& OutOptions)
+    {
+        Payload.TryGetBoolField(TEXT("include_titles"), OutOptions.bIncludeTitles);
+        Payload.TryGetBoolField(TEXT("include_full_titles"), OutOptions.bIncludeFullTitles);
+        Payload.TryGetBoolField(TEXT("include_tooltips"), OutOptions.bIncludeTooltips);
+    }
+
+    static void SerializeResponse(const TSharedRef<FJsonObject>& ResponseObj, FString& OutResponse)
+    {
+        MCP_TRACE_SCOPE("Mcp::SerializeResponse");
+        FMcpScopedSerializationTimer SerializationTimer;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
+        FJsonSerializer::Serialize(ResponseObj, Writer);
+    }
+
+    // A query_graph request. Step is resumable so a root scan can load its Blueprints over several frames.
+    struct FGraphQueryScan
+    {
+        FString QueryText;
+        TSharedPtr<const FMcpGraphQuery> Query;
+        FString AssetPath;
+        TArray<FString> Assets;
+        int32 Limit = 100;
+        int32 MaxBlueprints = 500;
+        bool bLoadedOnly = false;
+
+        int32 NextAsset = 0;
+        int32 Scanned = 0;
+        int32 NotLoaded = 0;
+        int32 LoadFailed = 0;
+        bool bTruncated = false;
+        TArray<TSharedPtr<FJsonValue>> Matches;
+        FString Error;
+
+        bool Read(const TSharedPtr<FJsonObject>& Payload, FMcpGraphQueryCache& Queries, FString& OutError)
+        {
+            if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("query"), QueryText))
+            {
+                OutError = TEXT("Missing 'query'");
+                return false;
+            }
+            FString Root;
+            Payload->TryGetStringField(TEXT("asset_path"), AssetPath);
+            Payload->TryGetStringField(TEXT("root"), Root);
+            if (AssetPath.IsEmpty() == Root.IsEmpty())
+            {
+                OutError = TEXT("Expected exactly one of 'asset_path' or 'root'");
+                return false;
+            }
+
+            Payload->TryGetNumberField(TEXT("limit"), Limit);
+            Payload->TryGetNumberField(TEXT("max_blueprints"), MaxBlueprints);
+            Payload->TryGetBoolField(TEXT("loaded_only"), bLoadedOnly);
+            Limit = FMath::Clamp(Limit, 1, 10000);
+            MaxBlueprints = FMath::Clamp(MaxBlueprints, 1, MaxQueryBlueprints);
+
+            Query = Queries.Get(QueryText, OutError);
+            if (!Query.IsValid())
+            {
+                return false;
+            }
+
+            if (!AssetPath.IsEmpty())
+            {
+                Assets.Add(AssetPath);
+                return true;
+            }
+            return FMcpBlueprintInspector::ListBlueprints({ Root }, Assets, OutError);
+        }
+
+        // Visits assets until Deadline (at least one per call) and returns true once the scan is over.
+        // Error is set only when a single asset_path does not load.
+        bool Step(FMcpBlueprintCache& Blueprints, double Deadline)
+        {
+            bool bVisited = false;
+            while (NextAsset < Assets.Num())
+            {
+                if (bVisited && FPlatformTime::Seconds() >= Deadline)
+                {
+                    return false;
+                }
+                if (Scanned >= MaxBlueprints)
+                {
+                    bTruncated = true;
+                    return true;
+                }
+
+                const FString& Asset = Assets[NextAsset++];
+                bVisited = true;
+                if (bLoadedOnly && !FindPackage(nullptr, *FPackageName::ObjectPathToPackageName(Asset)))
+                {
+                    ++NotLoaded;
+                    continue;
+                }
+
+                const UBlueprint* Blueprint = Blueprints.Load(Asset);
+                if (!Blueprint)
+                {
+                    if (!AssetPath.IsEmpty())
+                    {
+                        Error = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *Asset);
+                        return true;
+                    }
+                    ++LoadFailed;
+                    continue;
+                }
+
+                ++Scanned;
+                if (!Query->Run(Blueprint, Limit, Matches))
+                {
+                    bTruncated = true;
+                    return true;
+                }
+            }
+            return true;
+        }
+
+        TSharedRef<FJsonObject> ToJson() const
+        {
+            TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+            ResponseObj->SetStringField(TEXT("query"), QueryText);
+            ResponseObj->SetArrayField(TEXT("matches"), Matches);
+            ResponseObj->SetNumberField(TEXT("scanned"), Scanned);
+            ResponseObj->SetNumberField(TEXT("blueprints"), Assets.Num());
+            ResponseObj->SetNumberField(TEXT("not_loaded"), NotLoaded);
+            ResponseObj->SetNumberField(TEXT("load_failed"), LoadFailed);
+            ResponseObj->SetBoolField(TEXT("truncated"), bTruncated);
+            return ResponseObj;
+        }
+    };
+}
 
 FMcpServer::FMcpServer()
     : bIsRunning(false)
     , Port(0)
     , HttpServerModule(nullptr)
+    , AccessLog(MakeUnique<FMcpAccessLog>())
+    , Admission(MakeShared<FMcpAdmissionController, ESPMode::ThreadSafe>())
+    , Templates(MakeUnique<FMcpTemplateLibrary>())
+    , Symbols(MakeUnique<FMcpSymbolResolver>())
+    , Blueprints(MakeUnique<FMcpBlueprintCache>())
+    , Validation(MakeUnique<FMcpValidationSandbox>())
+    , Warmup(MakeUnique<FMcpWarmup>())
+    , Diffs(MakeUnique<FMcpBlueprintDiff>())
+    , Queries(MakeUnique<FMcpGraphQueryCache>())
+    , Exporter(MakeUnique<FMcpProjectExporter>())
+    , Slicer(MakeUnique<FMcpTimeSlicer>())
+    , Refactors(MakeUnique<FMcpBulkRefactor>())
 {
+    FMcpServerMetrics::Get().RegisterActions(McpServer::KnownActions);
 }
 
 FMcpServer::~FMcpServer()
@@ -56,14 +306,148 @@ bool FMcpServer::Start(uint16 InPort, FString& OutError)
 
     RouteHandles.Add(Handle);
 
+    EventStream = MakeUnique<FMcpEventStream>();
+    FHttpRouteHandle EventsHandle = Router->BindRoute(
+        FHttpPath(TEXT("/events")),
+        EHttpServerRequestVerbs::VERB_GET,
+        FHttpRequestHandler::CreateRaw(this, &FMcpServer::HandleEventsRequest));
+
+    if (!EventsHandle)
+    {
+        OutError = TEXT("Failed to bind events route.");
+        Router->UnbindRoute(Handle);
+        RouteHandles.Reset();
+        EventStream.Reset();
+        Router.Reset();
+        return false;
+    }
+
+    RouteHandles.Add(EventsHandle);
+
+    FHttpRouteHandle MetricsHandle = Router->BindRoute(
+        FHttpPath(TEXT("/metrics")),
+        EHttpServerRequestVerbs::VERB_GET,
+        FHttpRequestHandler::CreateRaw(this, &FMcpServer::HandleMetricsRequest));
+
+    if (MetricsHandle)
+    {
+        RouteHandles.Add(MetricsHandle);
+    }
+    else
+    {
+        Log(TEXT("Failed to bind metrics route."), EMcpLogSeverity::Warning);
+    }
+
     HttpServerModule->StartAllListeners();
 
+    FString AccessLogError;
+    if (!AccessLog->Start(AccessLogError))
+    {
+        Log(AccessLogError, EMcpLogSeverity::Warning);
+    }
+
+    FrameTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float DeltaTime)
+    {
+        FMcpServerMetrics::Get().RecordFrameTime(DeltaTime);
+        return true;
+    }));
+
     Port = InPort;
+    bShutdownRequested = false;
     bIsRunning = true;
     Log(FString::Printf(TEXT("Server started on 127.0.0.1:%d"), Port));
+
+    if (WebSocketPort != 0)
+    {
+        WebSocketTransport = MakeShared<FMcpWebSocketTransport>(AsShared());
+        FString WebSocketError;
+        if (WebSocketTransport->Start(WebSocketPort, WebSocketError))
+        {
+            Log(FString::Printf(TEXT("WebSocket listener started on 127.0.0.1:%d"), WebSocketPort));
+        }
+        else
+        {
+            Log(WebSocketError, EMcpLogSeverity::Error);
+            WebSocketTransport.Reset();
+        }
+    }
+
+    const FString SocketPath = UnixSocketPath.IsEmpty() ? FMcpUnixSocketTransport::GetDefaultPath() : UnixSocketPath;
+    if (!SocketPath.IsEmpty())
+    {
+        UnixSocketTransport = MakeShared<FMcpUnixSocketTransport, ESPMode::ThreadSafe>(AsShared());
+        FString UnixSocketError;
+        if (UnixSocketTransport->Start(SocketPath, UnixSocketError))
+        {
+            Log(FString::Printf(TEXT("Unix socket listener started on %s"), *SocketPath));
+        }
+        else
+        {
+            Log(UnixSocketError, EMcpLogSeverity::Error);
+            UnixSocketTransport.Reset();
+        }
+    }
+
+    if (bWarmUpOnStart)
+    {
+        BeginWarmup();
+    }
     return true;
 }
 
+void FMcpServer::BeginWarmup()
+{
+    TArray<FMcpWarmup::FStep> Steps;
+    Steps.Add({ TEXT("asset_registry"), []()
+    {
+        return !FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().IsLoadingAssets();
+    }});
+    Steps.Add({ TEXT("editor_modules"), []()
+    {
+        for (const TCHAR* ModuleName : { TEXT("AssetTools"), TEXT("Kismet"), TEXT("KismetCompiler"), TEXT("BlueprintGraph") })
+        {
+            FModuleManager::Get().LoadModule(ModuleName);
+        }
+        return true;
+    }});
+    Steps.Add({ TEXT("blueprint_index"), []()
+    {
+        TArray<FString> Assets;
+        FString Error;
+        FMcpBlueprintInspector::ListBlueprints({}, Assets, Error);
+        return true;
+    }});
+    Steps.Add({ TEXT("symbols"), [this]()
+    {
+        Symbols->Warm();
+        return true;
+    }});
+    Steps.Add({ TEXT("class_resolver"), [this]()
+    {
+        // The parent classes agents ask for most; resolving them loads anything still missing.
+        for (const TCHAR* ClassName : { TEXT("Actor"), TEXT("Pawn"), TEXT("Character"), TEXT("ActorComponent"), TEXT("SceneComponent") })
+        {
+            FString Error;
+            Symbols->ResolveClass(ClassName, Error);
+        }
+        return true;
+    }});
+
+    Log(TEXT("Warming up; requests get 503 until it finishes."));
+    Warmup->Begin(MoveTemp(Steps));
+}
+
+bool FMcpServer::IsWarmingUp(const FString& Action) const
+{
+    // Stats stay available so clients can poll the warm-up progress.
+    return Warmup->IsWarming() && Action != TEXT("get_server_stats");
+}
+
+FString FMcpServer::GetWarmupStatus() const
+{
+    return Warmup->Describe();
+}
+
 void FMcpServer::Stop()
 {
     if (!bIsRunning && !Router.IsValid())
@@ -71,6 +455,18 @@ void FMcpServer::Stop()
         return;
     }
 
+    if (WebSocketTransport.IsValid())
+    {
+        WebSocketTransport->Stop();
+        WebSocketTransport.Reset();
+    }
+
+    if (UnixSocketTransport.IsValid())
+    {
+        UnixSocketTransport->Shutdown();
+        UnixSocketTransport.Reset();
+    }
+
     if (Router.IsValid())
     {
         for (FHttpRouteHandle& Handle : RouteHandles)
@@ -80,6 +476,21 @@ void FMcpServer::Stop()
         RouteHandles.Reset();
     }
 
+    Warmup->Cancel();
+    Exporter->Cancel();
+    Slicer->CancelAll();
+    Refactors->CancelAll();
+
+    if (FrameTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(FrameTickerHandle);
+        FrameTickerHandle.Reset();
+    }
+
+    Admission->CancelQueued();
+    EventStream.Reset();
+    AccessLog->Shutdown();
+
     if (HttpServerModule && FHttpServerModule::IsAvailable())
     {
         HttpServerModule->StopAllListeners();
@@ -94,97 +505,867 @@ void FMcpServer::Stop()
 
 bool FMcpServer::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
-    TArray<uint8> BodyBytes = Request.Body;
-    FString BodyString;
+    MCP_LLM_SCOPE();
+    MCP_TRACE_SCOPE("Mcp::HandleRequest");
+
+    FMcpRequestTiming Timing;
+    Timing.StartTime = FPlatformTime::Seconds();
+    Timing.Transport = TEXT("http");
+    // Local agents all connect from 127.0.0.1, so fair scheduling keys on the identity a client gives:
+    // X-MCP-Client, else its MCP session id. The host is only the fallback.
+    FString ClientKey;
+    FString SessionId;
+    for (const TPair<FString, TArray<FString>>& Header : Request.Headers)
     {
-        const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(BodyBytes.GetData()), BodyBytes.Num());
-        BodyString = FString(Converter.Length(), Converter.Get());
+        if (Header.Value.Num() == 0)
+        {
+            continue;
+        }
+        if (Header.Key.Equals(TEXT("X-MCP-Client"), ESearchCase::IgnoreCase))
+        {
+            ClientKey = Header.Value[0];
+        }
+        else if (Header.Key.Equals(TEXT("Mcp-Session-Id"), ESearchCase::IgnoreCase))
+        {
+            SessionId = Header.Value[0];
+        }
+    }
+    if (ClientKey.IsEmpty() && !SessionId.IsEmpty())
+    {
+        ClientKey = TEXT("session:") + SessionId;
+    }
+
+    // The access log keeps the port; scheduling keys on the host alone, since every HTTP connection
+    // gets a fresh ephemeral port and one client would otherwise get a lane per connection.
+    if (Request.PeerAddress.IsValid())
+    {
+        Timing.Client = Request.PeerAddress->ToString(/*bAppendPort=*/true);
+        if (ClientKey.IsEmpty())
+        {
+            ClientKey = Request.PeerAddress->ToString(/*bAppendPort=*/false);
+        }
     }
 
-    Log(FString::Printf(TEXT("Request received (%d bytes)."), BodyBytes.Num()));
+    FString ParseError;
+    int32 RetryAfterSeconds = 0;
+    const EMcpSubmitResult Result = SubmitRequest(Request.Body, ClientKey, Timing,
+        [OnComplete](bool bOk, const FString& ResponsePayload, const FString& ErrorMessage)
+        {
+            if (!bOk)
+            {
+                FString ErrorResponse = FString::Printf(TEXT("{\"error\":\"%s\"}"), *ErrorMessage.ReplaceCharWithEscapedChar());
+                TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ErrorResponse, TEXT("application/json"));
+                Response->Code = EHttpServerResponseCodes::BadRequest;
+                OnComplete(MoveTemp(Response));
+                return;
+            }
 
-    TSharedPtr<FJsonObject> RequestObj;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BodyString);
+            TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ResponsePayload, TEXT("application/json"));
+            Response->Code = EHttpServerResponseCodes::Ok;
+            OnComplete(MoveTemp(Response));
+        },
+        ParseError, RetryAfterSeconds);
 
-    if (!FJsonSerializer::Deserialize(Reader, RequestObj) || !RequestObj.IsValid())
+    if (Result == EMcpSubmitResult::BadRequest)
     {
-        Log(TEXT("Malformed JSON request."));
-        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("Malformed JSON"), TEXT("text/plain"));
+        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ParseError, TEXT("text/plain"));
         Response->Code = EHttpServerResponseCodes::BadRequest;
         OnComplete(MoveTemp(Response));
-        return true;
+    }
+    else if (Result == EMcpSubmitResult::Busy)
+    {
+        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(
+            FString::Printf(TEXT("{\"error\":\"Server busy\",\"retry_after\":%d}"), RetryAfterSeconds),
+            TEXT("application/json"));
+        Response->Code = EHttpServerResponseCodes::TooManyRequests;
+        Response->Headers.Add(TEXT("Retry-After"), { FString::FromInt(RetryAfterSeconds) });
+        OnComplete(MoveTemp(Response));
+    }
+    else if (Result == EMcpSubmitResult::Warming)
+    {
+        TSharedRef<FJsonObject> WarmupObj = Warmup->BuildStatusJson();
+        WarmupObj->SetStringField(TEXT("error"), ParseError);
+        WarmupObj->SetNumberField(TEXT("retry_after"), RetryAfterSeconds);
+        FString Body;
+        McpServer::SerializeResponse(WarmupObj, Body);
+        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Body, TEXT("application/json"));
+        Response->Code = EHttpServerResponseCodes::ServiceUnavail;
+        Response->Headers.Add(TEXT("Retry-After"), { FString::FromInt(RetryAfterSeconds) });
+        OnComplete(MoveTemp(Response));
+    }
+    return true;
+}
+
+EMcpSubmitResult FMcpServer::SubmitRequest(TConstArrayView<uint8> Body, const FString& ClientKey, FMcpRequestTiming& Timing, FMcpActionCallback&& OnDone, FString& OutError, int32& OutRetryAfterSeconds)
+{
+    MCP_TRACE_SCOPE("Mcp::SubmitRequest");
+
+    if (Timing.StartTime == 0.0)
+    {
+        Timing.StartTime = FPlatformTime::Seconds();
+    }
+    Timing.RequestBytes = Body.Num();
+
+    FString BodyString;
+    {
+        MCP_TRACE_SCOPE("Mcp::DecodeBody");
+        const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+        BodyString = FString(Converter.Length(), Converter.Get());
+    }
+
+    Log(FString::Printf(TEXT("Request received (%d bytes)."), Body.Num()));
+
+    TSharedPtr<FJsonObject> RequestObj;
+    bool bParsed = false;
+    {
+        MCP_TRACE_SCOPE("Mcp::ParseRequest");
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BodyString);
+        bParsed = FJsonSerializer::Deserialize(Reader, RequestObj) && RequestObj.IsValid();
     }
 
     FString Action;
-    if (!RequestObj->TryGetStringField(TEXT("action"), Action))
+    if (!bParsed || !RequestObj->TryGetStringField(TEXT("action"), Action))
     {
-        Log(TEXT("Missing 'action' field."));
-        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("Missing 'action'"), TEXT("text/plain"));
-        Response->Code = EHttpServerResponseCodes::BadRequest;
-        OnComplete(MoveTemp(Response));
-        return true;
+        OutError = bParsed ? TEXT("Missing 'action'") : TEXT("Malformed JSON");
+        Log(bParsed ? TEXT("Missing 'action' field.") : TEXT("Malformed JSON request."), EMcpLogSeverity::Warning);
+        Timing.TotalSeconds = FPlatformTime::Seconds() - Timing.StartTime;
+        RecordAccess(FString(), nullptr, false, OutError, Timing);
+        return EMcpSubmitResult::BadRequest;
     }
 
     const TSharedPtr<FJsonObject>* PayloadObj = nullptr;
     RequestObj->TryGetObjectField(TEXT("params"), PayloadObj);
 
-    FString ResponsePayload;
-    FString ErrorMessage;
-    if (!DispatchAction(Action, PayloadObj ? *PayloadObj : MakeShared<FJsonObject>(), ResponsePayload, ErrorMessage))
-    {
-        Log(FString::Printf(TEXT("Action '%s' failed: %s"), *Action, *ErrorMessage));
-        FString ErrorResponse = FString::Printf(TEXT("{\"error\":\"%s\"}"), *ErrorMessage.ReplaceCharWithEscapedChar());
-        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ErrorResponse, TEXT("application/json"));
-        Response->Code = EHttpServerResponseCodes::BadRequest;
-        OnComplete(MoveTemp(Response));
+    const TSharedPtr<FJsonObject> Payload = PayloadObj ? *PayloadObj : MakeShared<FJsonObject>();
+
+    if (IsWarmingUp(Action))
+    {
+        OutError = GetWarmupStatus();
+        OutRetryAfterSeconds = 1;
+        return EMcpSubmitResult::Warming;
+    }
+
+    const FString& Client = ClientKey.IsEmpty() ? Timing.Client : ClientKey;
+    return SubmitAction(Action, Payload, Client, Timing, MoveTemp(OnDone), OutRetryAfterSeconds)
+        ? EMcpSubmitResult::Admitted
+        : EMcpSubmitResult::Busy;
+}
+
+bool FMcpServer::SubmitAction(const FString& Action, const TSharedPtr<FJsonObject>& Payload, const FString& ClientKey, const FMcpRequestTiming& Timing, FMcpActionCallback&& OnDone, int32& OutRetryAfterSeconds)
+{
+    FMcpRequestRecorder::Get().Record(Timing.Transport, ClientKey, Action, Payload);
+
+    const EMcpLane Lane = FMcpAdmissionController::Classify(Action);
+    TWeakPtr<FMcpServer> SelfWeak = AsShared();
+    const double SubmitTime = FPlatformTime::Seconds();
+    TSharedRef<FMcpActionCallback, ESPMode::ThreadSafe> Callback = MakeShared<FMcpActionCallback, ESPMode::ThreadSafe>(MoveTemp(OnDone));
+
+    auto Run = [SelfWeak, Action, Payload, Timing, SubmitTime, Callback]()
+    {
+        FMcpRequestTiming RequestTiming = Timing;
+        RequestTiming.QueueWaitSeconds += FPlatformTime::Seconds() - SubmitTime;
+
+        FString Response;
+        FString Error;
+        bool bOk = false;
+        if (TSharedPtr<FMcpServer> Self = SelfWeak.Pin())
+        {
+            bOk = Self->ExecuteAction(Action, Payload, Response, Error, RequestTiming);
+        }
+        else
+        {
+            Error = TEXT("Server stopped.");
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [SelfWeak, Action, Payload, Callback, bOk, Response = MoveTemp(Response), Error = MoveTemp(Error)]()
+        {
+            if (bOk)
+            {
+                if (TSharedPtr<FMcpServer> Self = SelfWeak.Pin())
+                {
+                    Self->NotifyActionCompleted(Action, Payload);
+                }
+            }
+            (*Callback)(bOk, Response, Error);
+        });
+    };
+
+    auto Cancel = [Callback]()
+    {
+        AsyncTask(ENamedThreads::GameThread, [Callback]()
+        {
+            (*Callback)(false, FString(), TEXT("Server stopped."));
+        });
+    };
+
+    if (!Admission->Submit(Lane, ClientKey, MoveTemp(Run), MoveTemp(Cancel), OutRetryAfterSeconds))
+    {
+        Log(FString::Printf(TEXT("Rejected '%s': %s lane full, retry after %ds."), *Action, FMcpAdmissionController::GetLaneName(Lane), OutRetryAfterSeconds), EMcpLogSeverity::Warning);
+        return false;
+    }
+    return true;
+}
+
+bool FMcpServer::ExecuteAction(const FString& Action, const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError, FMcpRequestTiming& Timing) const
+{
+    MCP_LLM_SCOPE();
+    MCP_TRACE_SCOPE("Mcp::ExecuteAction");
+
+    FMcpServerMetrics& Metrics = FMcpServerMetrics::Get();
+    Metrics.BeginRequest();
+    if (Timing.StartTime == 0.0)
+    {
+        Timing.StartTime = FPlatformTime::Seconds();
+    }
+
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(McpChannel))
+    {
+        FString AssetPath;
+        if (Payload.IsValid())
+        {
+            Payload->TryGetStringField(TEXT("asset_path"), AssetPath);
+        }
+        FMcpTrace::RequestBegin(Action, AssetPath, Timing.RequestBytes);
+    }
+
+    bool bOk = false;
+    if (McpServer::IsThreadSafeAction(Action))
+    {
+        FMcpRequestTimingScope TimingScope(Timing);
+        bOk = DispatchAction(Action, Payload, OutResponse, OutError);
+    }
+    else if (Action == TEXT("get_blueprint_structure") && !IsInGameThread() && FMcpTimeSlicer::IsEnabled())
+    {
+        bOk = ExportStructureSliced(Payload, OutResponse, OutError, Timing);
+    }
+    else if (Action == TEXT("query_graph") && !IsInGameThread() && FMcpTimeSlicer::IsEnabled())
+    {
+        bOk = QueryGraphSliced(Payload, OutResponse, OutError, Timing);
+    }
+    else
+    {
+        const double EnqueueTime = FPlatformTime::Seconds();
+        RunGameThread([&]()
+        {
+            MCP_LLM_SCOPE();
+            const double GameThreadStart = FPlatformTime::Seconds();
+            Timing.QueueWaitSeconds += GameThreadStart - EnqueueTime;
+
+            FMcpRequestTimingScope TimingScope(Timing);
+            const double SerializationBefore = Timing.SerializationSeconds;
+            bOk = DispatchAction(Action, Payload, OutResponse, OutError);
+            Timing.GameThreadSeconds += FPlatformTime::Seconds() - GameThreadStart - (Timing.SerializationSeconds - SerializationBefore);
+        });
+    }
+
+    const FString& Body = bOk ? OutResponse : OutError;
+    Timing.ResponseBytes = FPlatformString::ConvertedLength<UTF8CHAR>(*Body, Body.Len());
+    Timing.TotalSeconds = FPlatformTime::Seconds() - Timing.StartTime;
+    Metrics.EndRequest(Action, bOk, Timing);
+    FMcpTrace::RequestEnd(Action, bOk, Timing.ResponseBytes, Timing.TotalSeconds);
+    RecordAccess(Action, Payload, bOk, OutError, Timing);
+
+    if (!bOk)
+    {
+        Log(FString::Printf(TEXT("Action '%s' failed: %s"), *Action, *OutError), EMcpLogSeverity::Warning);
+        return false;
+    }
+
+    Log(FString::Printf(TEXT("Action '%s' succeeded."), *Action));
+    return true;
+}
+
+bool FMcpServer::ExportStructureSliced(const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError, FMcpRequestTiming& Timing) const
+{
+    MCP_TRACE_SCOPE("Mcp::ExportStructureSliced");
+
+    FString AssetPath;
+    if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+    {
+        OutError = TEXT("Missing 'asset_path'");
+        return false;
+    }
+    FMcpExportOptions Options;
+    McpServer::ReadExportOptions(*Payload, Options);
+
+    // The export runs in budgeted slices on the game thread; this worker waits for the last one and
+    // serializes the response itself, so the game thread never holds the whole request.
+    TSharedPtr<FJsonObject> Result;
+    double GameThreadSeconds = 0.0;
+    FEvent* Done = FPlatformProcess::GetSynchEventFromPool(true);
+    const double EnqueueTime = FPlatformTime::Seconds();
+
+    AsyncTask(ENamedThreads::GameThread, [&, this]()
+    {
+        const double GameThreadStart = FPlatformTime::Seconds();
+        Timing.QueueWaitSeconds += GameThreadStart - EnqueueTime;
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        GameThreadSeconds += FPlatformTime::Seconds() - GameThreadStart;
+        if (!Blueprint)
+        {
+            OutError = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *AssetPath);
+            Done->Trigger();
+            return;
+        }
+
+        TSharedRef<FMcpBlueprintJsonBuilder> Builder = MakeShared<FMcpBlueprintJsonBuilder>(Blueprint, Options, MakeShared<FJsonObject>());
+        Slicer->Add(
+            [Builder, &GameThreadSeconds](double Deadline)
+            {
+                const double SliceStart = FPlatformTime::Seconds();
+                const bool bFinished = Builder->Step(Deadline);
+                GameThreadSeconds += FPlatformTime::Seconds() - SliceStart;
+                return bFinished;
+            },
+            [Builder, &Result, &OutError, Done](bool bInCompleted)
+            {
+                if (Builder->Succeeded())
+                {
+                    Result = Builder->GetJson();
+                }
+                else
+                {
+                    OutError = bInCompleted ? Builder->GetError() : TEXT("Server stopped.");
+                }
+                Done->Trigger();
+            });
+    });
+
+    {
+        MCP_TRACE_SCOPE("Mcp::WaitForGameThread");
+        Done->Wait();
+    }
+    FPlatformProcess::ReturnSynchEventToPool(Done);
+    Timing.GameThreadSeconds += GameThreadSeconds;
+
+    if (!Result.IsValid())
+    {
+        if (OutError.IsEmpty())
+        {
+            OutError = TEXT("Server stopped.");
+        }
+        return false;
+    }
+
+    FMcpRequestTimingScope TimingScope(Timing);
+    McpServer::SerializeResponse(Result.ToSharedRef(), OutResponse);
+    Log(FString::Printf(TEXT("Exported structure for '%s'."), *AssetPath));
+    return true;
+}
+
+bool FMcpServer::QueryGraphSliced(const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError, FMcpRequestTiming& Timing) const
+{
+    MCP_TRACE_SCOPE("Mcp::QueryGraphSliced");
+
+    // Like ExportStructureSliced: a root scan loads and matches Blueprints in budgeted slices, so
+    // Blueprints that are not in memory yet are covered without stalling the editor.
+    TSharedRef<McpServer::FGraphQueryScan> Scan = MakeShared<McpServer::FGraphQueryScan>();
+    bool bCompleted = false;
+    double GameThreadSeconds = 0.0;
+    FEvent* Done = FPlatformProcess::GetSynchEventFromPool(true);
+    const double EnqueueTime = FPlatformTime::Seconds();
+
+    AsyncTask(ENamedThreads::GameThread, [&, this]()
+    {
+        const double GameThreadStart = FPlatformTime::Seconds();
+        Timing.QueueWaitSeconds += GameThreadStart - EnqueueTime;
+
+        const bool bRead = Scan->Read(Payload, *Queries, OutError);
+        GameThreadSeconds += FPlatformTime::Seconds() - GameThreadStart;
+        if (!bRead)
+        {
+            Done->Trigger();
+            return;
+        }
+
+        Slicer->Add(
+            [Scan, this, &GameThreadSeconds](double Deadline)
+            {
+                const double SliceStart = FPlatformTime::Seconds();
+                const bool bFinished = Scan->Step(*Blueprints, Deadline);
+                GameThreadSeconds += FPlatformTime::Seconds() - SliceStart;
+                return bFinished;
+            },
+            [&bCompleted, Done](bool bInCompleted)
+            {
+                bCompleted = bInCompleted;
+                Done->Trigger();
+            });
+    });
+
+    {
+        MCP_TRACE_SCOPE("Mcp::WaitForGameThread");
+        Done->Wait();
+    }
+    FPlatformProcess::ReturnSynchEventToPool(Done);
+    Timing.GameThreadSeconds += GameThreadSeconds;
+
+    if (!OutError.IsEmpty())
+    {
+        return false;
+    }
+    if (!bCompleted)
+    {
+        OutError = TEXT("Server stopped.");
+        return false;
+    }
+    if (!Scan->Error.IsEmpty())
+    {
+        OutError = Scan->Error;
+        return false;
+    }
+
+    FMcpRequestTimingScope TimingScope(Timing);
+    McpServer::SerializeResponse(Scan->ToJson(), OutResponse);
+    return true;
+}
+
+void FMcpServer::RecordAccess(const FString& Action, const TSharedPtr<FJsonObject>& Payload, bool bSuccess, const FString& Error, const FMcpRequestTiming& Timing) const
+{
+    const int32 SampleInterval = AccessLog->ShouldRecord(McpServer::IsReadAction(Action), bSuccess);
+    if (SampleInterval == 0)
+    {
+        return;
+    }
+
+    FMcpAccessRecord AccessRecord;
+    AccessRecord.Timestamp = FDateTime::UtcNow();
+    AccessRecord.Transport = Timing.Transport;
+    AccessRecord.Client = Timing.Client;
+    AccessRecord.Action = Action;
+    if (Payload.IsValid() && !Payload->TryGetStringField(TEXT("asset_path"), AccessRecord.AssetPath))
+    {
+        Payload->TryGetStringField(TEXT("package_path"), AccessRecord.AssetPath);
+    }
+    AccessRecord.bSuccess = bSuccess;
+    if (!bSuccess)
+    {
+        AccessRecord.Error = Error;
+    }
+    AccessRecord.SampleInterval = SampleInterval;
+    AccessRecord.Timing = Timing;
+    AccessLog->Record(MoveTemp(AccessRecord));
+}
+
+void FMcpServer::NotifyActionCompleted(const FString& Action, const TSharedPtr<FJsonObject>& Payload)
+{
+    check(IsInGameThread());
+
+    if (!EventStream.IsValid() || McpServer::IsReadAction(Action))
+    {
+        return;
+    }
+
+    FString AssetPath;
+    if (Payload.IsValid() && !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+    {
+        Payload->TryGetStringField(TEXT("package_path"), AssetPath);
+    }
+    EventStream->Publish(EMcpEventType::JobCompleted, AssetPath, Action);
+}
+
+void FMcpServer::RunGameThread(TFunction<void()>&& InFunc)
+{
+    if (IsInGameThread())
+    {
+        InFunc();
+        return;
+    }
+
+    FEvent* Event = FPlatformProcess::GetSynchEventFromPool(true);
+    AsyncTask(ENamedThreads::GameThread, [Event, Func = MoveTemp(InFunc)]() mutable
+    {
+        MCP_TRACE_SCOPE("Mcp::RunGameThread");
+        Func();
+        Event->Trigger();
+    });
+
+    MCP_TRACE_SCOPE("Mcp::WaitForGameThread");
+    Event->Wait();
+    FPlatformProcess::ReturnSynchEventToPool(Event);
+}
+
+bool FMcpServer::HandleMetricsRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+    TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(
+        FMcpServerMetrics::Get().BuildPrometheusText(),
+        TEXT("text/plain; version=0.0.4"));
+    Response->Code = EHttpServerResponseCodes::Ok;
+    OnComplete(MoveTemp(Response));
+    return true;
+}
+
+bool FMcpServer::HandleEventsRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+    if (!EventStream.IsValid())
+    {
+        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("Server not running"), TEXT("text/plain"));
+        Response->Code = EHttpServerResponseCodes::ServiceUnavail;
+        OnComplete(MoveTemp(Response));
+        return true;
+    }
+
+    return EventStream->HandleSubscribe(Request, OnComplete);
+}
+
+bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError) const
+{
+    MCP_TRACE_SCOPE("Mcp::DispatchAction");
+    MCP_TRACE_SCOPE_TEXT(*Action);
+
+    if (Action == TEXT("list_blueprints"))
+    {
+        TArray<FString> Roots;
+        if (Payload.IsValid())
+        {
+            const TArray<TSharedPtr<FJsonValue>>* RootArray = nullptr;
+            if (Payload->TryGetArrayField(TEXT("paths"), RootArray))
+            {
+                for (const TSharedPtr<FJsonValue>& Value : *RootArray)
+                {
+                    Roots.Add(Value->AsString());
+                }
+            }
+        }
+
+        TArray<FString> Assets;
+        if (!FMcpBlueprintInspector::ListBlueprints(Roots, Assets, OutError))
+        {
+            return false;
+        }
+
+        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+        TArray<TSharedPtr<FJsonValue>> AssetValues;
+        for (const FString& AssetPath : Assets)
+        {
+            AssetValues.Add(MakeShared<FJsonValueString>(AssetPath));
+        }
+        ResponseObj->SetArrayField(TEXT("blueprints"), AssetValues);
+
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Listed %d blueprints."), AssetValues.Num()));
+        return true;
+    }
+
+    if (Action == TEXT("get_blueprint_structure"))
+    {
+        FString AssetPath;
+        if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+        {
+            OutError = TEXT("Missing 'asset_path'");
+            return false;
+        }
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
+        {
+            OutError = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *AssetPath);
+            return false;
+        }
+
+        FMcpExportOptions Options;
+        McpServer::ReadExportOptions(*Payload, Options);
+
+        TSharedRef<FJsonObject> BlueprintJson = MakeShared<FJsonObject>();
+        if (!FMcpBlueprintInspector::BuildBlueprintJson(Blueprint, BlueprintJson, OutError, Options))
+        {
+            return false;
+        }
+
+        McpServer::SerializeResponse(BlueprintJson, OutResponse);
+        Log(FString::Printf(TEXT("Exported structure for '%s'."), *AssetPath));
+        return true;
+    }
+
+    if (Action == TEXT("get_graph_topology"))
+    {
+        FString AssetPath;
+        if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+        {
+            OutError = TEXT("Missing 'asset_path'");
+            return false;
+        }
+        FString GraphName;
+        FString Format = TEXT("json");
+        Payload->TryGetStringField(TEXT("graph"), GraphName);
+        Payload->TryGetStringField(TEXT("format"), Format);
+        if (Format != TEXT("json") && Format != TEXT("binary"))
+        {
+            OutError = FString::Printf(TEXT("Unknown format '%s' (json, binary)"), *Format);
+            return false;
+        }
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
+        {
+            OutError = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *AssetPath);
+            return false;
+        }
+
+        TSharedPtr<FJsonObject> TopologyJson;
+        if (!FMcpGraphTopology::Build(Blueprint, GraphName, Format == TEXT("binary"), TopologyJson, OutError))
+        {
+            return false;
+        }
+
+        McpServer::SerializeResponse(TopologyJson.ToSharedRef(), OutResponse);
+        return true;
+    }
+
+    if (Action == TEXT("export_project"))
+    {
+        bool bCancel = false;
+        if (Payload.IsValid() && Payload->TryGetBoolField(TEXT("cancel"), bCancel) && bCancel)
+        {
+            Exporter->Cancel();
+            McpServer::SerializeResponse(Exporter->BuildStatusJson(), OutResponse);
+            return true;
+        }
+
+        FMcpProjectExportConfig Config;
+        FString OutputDir;
+        if (Payload.IsValid())
+        {
+            Payload->TryGetStringField(TEXT("output_dir"), OutputDir);
+            Payload->TryGetNumberField(TEXT("batch_size"), Config.BatchSize);
+            Payload->TryGetNumberField(TEXT("shard_size"), Config.ShardSize);
+            Payload->TryGetNumberField(TEXT("gc_every_batches"), Config.GcEveryBatches);
+            Payload->TryGetNumberField(TEXT("gc_memory_growth_mb"), Config.GcMemoryGrowthMB);
+            Payload->TryGetBoolField(TEXT("compress"), Config.bCompress);
+            Payload->TryGetBoolField(TEXT("incremental"), Config.bIncremental);
+            Payload->TryGetBoolField(TEXT("include_titles"), Config.Options.bIncludeTitles);
+
+            const TArray<TSharedPtr<FJsonValue>>* RootArray = nullptr;
+            if (Payload->TryGetArrayField(TEXT("roots"), RootArray))
+            {
+                for (const TSharedPtr<FJsonValue>& Value : *RootArray)
+                {
+                    Config.Roots.Add(Value->AsString());
+                }
+            }
+        }
+
+        // Remote callers may only write below the project's Saved directory.
+        Config.OutputDir = FMcpProjectExporter::GetDefaultOutputDir();
+        if (!OutputDir.IsEmpty())
+        {
+            Config.OutputDir = FPaths::ConvertRelativePathToFull(FPaths::IsRelative(OutputDir) ? Config.OutputDir / OutputDir : OutputDir);
+            if (!FPaths::IsUnderDirectory(Config.OutputDir, FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir())))
+            {
+                OutError = TEXT("'output_dir' must be inside the project's Saved directory");
+                return false;
+            }
+        }
+
+        if (!Exporter->Start(Config, OutError))
+        {
+            return false;
+        }
+
+        McpServer::SerializeResponse(Exporter->BuildStatusJson(), OutResponse);
+        Log(FString::Printf(TEXT("Started project export to '%s'."), *Config.OutputDir));
+        return true;
+    }
+
+    if (Action == TEXT("get_export_status"))
+    {
+        McpServer::SerializeResponse(Exporter->BuildStatusJson(), OutResponse);
+        return true;
+    }
+
+    if (Action == TEXT("get_refactor_status"))
+    {
+        int32 JobId = INDEX_NONE;
+        if (!Payload.IsValid() || !Payload->TryGetNumberField(TEXT("job_id"), JobId))
+        {
+            OutError = TEXT("Missing 'job_id'");
+            return false;
+        }
+
+        TSharedPtr<FJsonObject> JobJson = Refactors->BuildJobJson(JobId);
+        if (!JobJson.IsValid())
+        {
+            OutError = FString::Printf(TEXT("Unknown job %d"), JobId);
+            return false;
+        }
+
+        McpServer::SerializeResponse(JobJson.ToSharedRef(), OutResponse);
+        return true;
+    }
+
+    if (Action == TEXT("get_server_stats"))
+    {
+        TSharedRef<FJsonObject> StatsObj = FMcpServerMetrics::Get().BuildStatsJson();
+        StatsObj->SetObjectField(TEXT("lanes"), Admission->BuildStatsJson());
+        StatsObj->SetObjectField(TEXT("warmup"), Warmup->BuildStatusJson());
+        StatsObj->SetObjectField(TEXT("time_slicing"), Slicer->BuildStatsJson());
+        McpServer::SerializeResponse(StatsObj, OutResponse);
+        return true;
+    }
+
+    if (Action == TEXT("shutdown"))
+    {
+        if (!bAllowShutdown)
+        {
+            OutError = TEXT("Shutdown is only available when running headless.");
+            return false;
+        }
+
+        bShutdownRequested = true;
+        OutResponse = TEXT("{\"status\":\"shutting_down\"}");
+        Log(TEXT("Shutdown requested."));
+        return true;
+    }
+
+    if (Action == TEXT("validate_edits"))
+    {
+        FString AssetPath;
+        const TArray<TSharedPtr<FJsonValue>>* EditArray = nullptr;
+        if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath) || !Payload->TryGetArrayField(TEXT("edits"), EditArray))
+        {
+            OutError = TEXT("Missing 'asset_path' or 'edits'");
+            return false;
+        }
+
+        TArray<FString> EditActions;
+        TArray<TSharedPtr<FJsonObject>> EditParams;
+        TArray<FString> EditKeys;
+        for (const TSharedPtr<FJsonValue>& EditValue : *EditArray)
+        {
+            const TSharedPtr<FJsonObject>* EditObj = nullptr;
+            const TSharedPtr<FJsonObject>* ParamsObj = nullptr;
+            FString EditAction;
+            if (!EditValue->TryGetObject(EditObj) || !(*EditObj)->TryGetStringField(TEXT("action"), EditAction))
+            {
+                OutError = TEXT("Each edit needs an 'action'.");
+                return false;
+            }
+            if (!McpServer::IsValidatableAction(EditAction))
+            {
+                OutError = FString::Printf(TEXT("Action '%s' cannot be validated."), *EditAction);
+                return false;
+            }
+
+            FString Key;
+            TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> KeyWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Key);
+            FJsonSerializer::Serialize(EditObj->ToSharedRef(), KeyWriter);
+
+            EditActions.Add(EditAction);
+            EditParams.Add((*EditObj)->TryGetObjectField(TEXT("params"), ParamsObj) ? MakeShared<FJsonObject>(**ParamsObj) : MakeShared<FJsonObject>());
+            EditKeys.Add(MoveTemp(Key));
+        }
+
+        UBlueprint* Source = Blueprints->Load(AssetPath);
+        if (!Source)
+        {
+            OutError = TEXT("Blueprint not found.");
+            return false;
+        }
+
+        int32 AppliedCount = 0;
+        UBlueprint* Copy = Validation->Acquire(Source, EditKeys, AppliedCount, OutError);
+        if (!Copy)
+        {
+            return false;
+        }
+
+        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+        ResponseObj->SetNumberField(TEXT("reused_edits"), AppliedCount);
+
+        TArray<TSharedPtr<FJsonValue>> ResultArray;
+        const FString CopyPath = Copy->GetPathName();
+        for (int32 Index = AppliedCount; Index < EditActions.Num(); ++Index)
+        {
+            EditParams[Index]->SetStringField(TEXT("asset_path"), CopyPath);
+
+            FString EditResponse;
+            FString EditError;
+            bool bEditOk = false;
+            {
+                TGuardValue<bool> ValidatingScope(bValidatingEdits, true);
+                bEditOk = DispatchAction(EditActions[Index], EditParams[Index], EditResponse, EditError);
+            }
+
+            if (!bEditOk)
+            {
+                // The copy may be half-edited now, so the next validation starts from a fresh one.
+                Validation->Discard(Source);
+                ResponseObj->SetBoolField(TEXT("valid"), false);
+                ResponseObj->SetNumberField(TEXT("failed_edit"), Index);
+                ResponseObj->SetStringField(TEXT("error"), EditError);
+                ResponseObj->SetArrayField(TEXT("results"), ResultArray);
+                McpServer::SerializeResponse(ResponseObj, OutResponse);
+                return true;
+            }
+
+            TSharedPtr<FJsonObject> EditResult;
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(EditResponse);
+            if (FJsonSerializer::Deserialize(Reader, EditResult) && EditResult.IsValid())
+            {
+                EditResult->SetNumberField(TEXT("edit"), Index);
+                ResultArray.Add(MakeShared<FJsonValueObject>(EditResult));
+            }
+        }
+        Validation->MarkApplied(Source, EditKeys);
+
+        TArray<FMcpValidationDiagnostic> Diagnostics;
+        const bool bValid = FMcpValidationSandbox::Compile(Copy, Diagnostics);
+
+        TArray<TSharedPtr<FJsonValue>> DiagnosticArray;
+        for (const FMcpValidationDiagnostic& Diagnostic : Diagnostics)
+        {
+            TSharedRef<FJsonObject> DiagnosticObj = MakeShared<FJsonObject>();
+            DiagnosticObj->SetStringField(TEXT("severity"), Diagnostic.Severity);
+            DiagnosticObj->SetStringField(TEXT("message"), Diagnostic.Message);
+            if (Diagnostic.NodeGuid.IsValid())
+            {
+                DiagnosticObj->SetStringField(TEXT("graph"), Diagnostic.Graph);
+                DiagnosticObj->SetStringField(TEXT("node_guid"), Diagnostic.NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+            }
+            DiagnosticArray.Add(MakeShared<FJsonValueObject>(DiagnosticObj));
+        }
+
+        ResponseObj->SetBoolField(TEXT("valid"), bValid);
+        ResponseObj->SetArrayField(TEXT("results"), ResultArray);
+        ResponseObj->SetArrayField(TEXT("diagnostics"), DiagnosticArray);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Validated %d edits on '%s': %s."), EditActions.Num(), *AssetPath, bValid ? TEXT("valid") : TEXT("invalid")));
         return true;
     }
 
-    Log(FString::Printf(TEXT("Action '%s' succeeded."), *Action));
-    TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ResponsePayload, TEXT("application/json"));
-    Response->Code = EHttpServerResponseCodes::Ok;
-    OnComplete(MoveTemp(Response));
-    return true;
-}
-
-bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError) const
-{
-    if (Action == TEXT("list_blueprints"))
+    if (Action == TEXT("impact_analysis"))
     {
-        TArray<FString> Roots;
+        FString AssetPath;
+        FString ClassPath;
         if (Payload.IsValid())
         {
-            const TArray<TSharedPtr<FJsonValue>>* RootArray = nullptr;
-            if (Payload->TryGetArrayField(TEXT("paths"), RootArray))
-            {
-                for (const TSharedPtr<FJsonValue>& Value : *RootArray)
-                {
-                    Roots.Add(Value->AsString());
-                }
-            }
+            Payload->TryGetStringField(TEXT("asset_path"), AssetPath);
+            Payload->TryGetStringField(TEXT("class"), ClassPath);
         }
 
-        TArray<FString> Assets;
-        if (!FMcpBlueprintInspector::ListBlueprints(Roots, Assets, OutError))
+        // Full paths are analyzed without loading anything; short names go through the symbol resolver.
+        if (!ClassPath.IsEmpty() && !ClassPath.StartsWith(TEXT("/")))
         {
-            return false;
+            const UClass* Class = Symbols->ResolveClass(ClassPath, OutError);
+            if (!Class)
+            {
+                return false;
+            }
+            ClassPath = Class->GetPathName();
         }
 
-        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
-        TArray<TSharedPtr<FJsonValue>> AssetValues;
-        for (const FString& AssetPath : Assets)
+        TSharedPtr<FJsonObject> ImpactJson;
+        if (!FMcpImpactAnalysis::Analyze(AssetPath, ClassPath, ImpactJson, OutError))
         {
-            AssetValues.Add(MakeShared<FJsonValueString>(AssetPath));
+            return false;
         }
-        ResponseObj->SetArrayField(TEXT("blueprints"), AssetValues);
 
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
-        Log(FString::Printf(TEXT("Listed %d blueprints."), AssetValues.Num()));
+        McpServer::SerializeResponse(ImpactJson.ToSharedRef(), OutResponse);
         return true;
     }
 
-    if (Action == TEXT("get_blueprint_structure"))
+    if (Action == TEXT("diff_blueprints"))
     {
         FString AssetPath;
         if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
@@ -192,16 +1373,49 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
             OutError = TEXT("Missing 'asset_path'");
             return false;
         }
+        FString BasePath;
+        Payload->TryGetStringField(TEXT("base_path"), BasePath);
 
-        TSharedRef<FJsonObject> BlueprintJson = MakeShared<FJsonObject>();
-        if (!FMcpBlueprintInspector::BuildBlueprintJson(AssetPath, BlueprintJson, OutError))
+        UBlueprint* Target = Blueprints->Load(AssetPath);
+        if (!Target)
         {
+            OutError = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *AssetPath);
             return false;
         }
 
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(BlueprintJson, Writer);
-        Log(FString::Printf(TEXT("Exported structure for '%s'."), *AssetPath));
+        // Without a base the asset is compared with its saved package, i.e. the unsaved edits.
+        UBlueprint* Base = BasePath.IsEmpty() ? Diffs->LoadSavedRevision(Target, OutError) : Blueprints->Load(BasePath);
+        if (!Base)
+        {
+            if (OutError.IsEmpty())
+            {
+                OutError = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *BasePath);
+            }
+            return false;
+        }
+
+        TSharedRef<FJsonObject> DiffJson = FMcpBlueprintDiff::Diff(Base, Target);
+        DiffJson->SetStringField(TEXT("base"), BasePath.IsEmpty() ? TEXT("saved") : Base->GetPathName());
+        DiffJson->SetStringField(TEXT("target"), Target->GetPathName());
+        McpServer::SerializeResponse(DiffJson, OutResponse);
+        return true;
+    }
+
+    if (Action == TEXT("query_graph"))
+    {
+        McpServer::FGraphQueryScan Scan;
+        if (!Scan.Read(Payload, *Queries, OutError))
+        {
+            return false;
+        }
+
+        Scan.Step(*Blueprints, TNumericLimits<double>::Max());
+        if (!Scan.Error.IsEmpty())
+        {
+            OutError = Scan.Error;
+            return false;
+        }
+        McpServer::SerializeResponse(Scan.ToJson(), OutResponse);
         return true;
     }
 
@@ -220,8 +1434,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
             return false;
         }
 
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ReferencesJson.ToSharedRef(), Writer);
+        McpServer::SerializeResponse(ReferencesJson.ToSharedRef(), OutResponse);
         Log(FString::Printf(TEXT("Fetched references for '%s'."), *AssetPath));
         return true;
     }
@@ -229,7 +1442,8 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
     // Write operations (require bAllowWrites)
     auto RequireWrite = [this, &OutError]() -> bool
     {
-        if (!bAllowWrites)
+        // Edits replayed by validate_edits only touch a transient copy.
+        if (!bAllowWrites && !bValidatingEdits)
         {
             OutError = TEXT("Write operations are disabled.");
             return false;
@@ -237,24 +1451,6 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         return true;
     };
 
-    auto RunGameThread = [](TFunction<void()>&& InFunc)
-    {
-        if (IsInGameThread())
-        {
-            InFunc();
-            return;
-        }
-
-        FEvent* Event = FPlatformProcess::GetSynchEventFromPool(true);
-        AsyncTask(ENamedThreads::GameThread, [Event, Func = MoveTemp(InFunc)]() mutable
-        {
-            Func();
-            Event->Trigger();
-        });
-        Event->Wait();
-        FPlatformProcess::ReturnSynchEventToPool(Event);
-    };
-
     if (Action == TEXT("create_blueprint"))
     {
         if (!RequireWrite())
@@ -274,10 +1470,9 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         UClass* ParentClass = AActor::StaticClass();
         if (!ParentClassName.IsEmpty())
         {
-            ParentClass = FindObject<UClass>(nullptr, *ParentClassName);
+            ParentClass = Symbols->ResolveClass(ParentClassName, OutError);
             if (!ParentClass)
             {
-                OutError = FString::Printf(TEXT("Parent class '%s' not found."), *ParentClassName);
                 return false;
             }
         }
@@ -297,8 +1492,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
         ResponseObj->SetStringField(TEXT("asset_path"), Result.AssetPath);
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
         Log(FString::Printf(TEXT("Created Blueprint '%s'."), *Result.AssetPath));
         return true;
     }
@@ -344,7 +1538,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         (*TypeObj)->TryGetBoolField(TEXT("is_map"), bIsMap);
         PinType.ContainerType = bIsArray ? EPinContainerType::Array : (bIsSet ? EPinContainerType::Set : (bIsMap ? EPinContainerType::Map : EPinContainerType::None));
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
         if (!Blueprint)
         {
             OutError = TEXT("Blueprint not found.");
@@ -363,8 +1557,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
         ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
         Log(FString::Printf(TEXT("Added variable '%s' to '%s'."), *VarNameStr, *AssetPath));
         return true;
     }
@@ -384,7 +1577,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
             return false;
         }
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
         if (!Blueprint)
         {
             OutError = TEXT("Blueprint not found.");
@@ -403,8 +1596,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
         ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
         Log(FString::Printf(TEXT("Added function graph '%s' to '%s'."), *FunctionName, *AssetPath));
         return true;
     }
@@ -432,17 +1624,16 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         Payload->TryGetNumberField(TEXT("x"), PosX);
         Payload->TryGetNumberField(TEXT("y"), PosY);
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
         if (!Blueprint)
         {
             OutError = TEXT("Blueprint not found.");
             return false;
         }
 
-        UFunction* TargetFunction = FindObject<UFunction>(nullptr, *FunctionPath);
+        UFunction* TargetFunction = Symbols->ResolveFunction(FunctionPath, OutError);
         if (!TargetFunction)
         {
-            OutError = TEXT("Function not found.");
             return false;
         }
 
@@ -459,8 +1650,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
         ResponseObj->SetStringField(TEXT("node_guid"), NewGuid.ToString(EGuidFormats::DigitsWithHyphens));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
         Log(FString::Printf(TEXT("Added call node '%s' to graph '%s'."), *FunctionPath, *GraphName));
         return true;
     }
@@ -488,7 +1678,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         Payload->TryGetNumberField(TEXT("x"), PosX);
         Payload->TryGetNumberField(TEXT("y"), PosY);
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
         if (!Blueprint)
         {
             OutError = TEXT("Blueprint not found.");
@@ -508,8 +1698,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
         ResponseObj->SetStringField(TEXT("node_guid"), NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
         Log(FString::Printf(TEXT("Added event '%s' to graph '%s'."), *EventName, *GraphName));
         return true;
     }
@@ -539,7 +1728,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         Payload->TryGetNumberField(TEXT("x"), PosX);
         Payload->TryGetNumberField(TEXT("y"), PosY);
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
         if (!Blueprint)
         {
             OutError = TEXT("Blueprint not found.");
@@ -559,8 +1748,7 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
         ResponseObj->SetStringField(TEXT("node_guid"), NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
         Log(FString::Printf(TEXT("Added input action '%s' to graph '%s'."), *InputAction, *GraphName));
         return true;
     }
@@ -580,28 +1768,213 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
             !Payload->TryGetStringField(TEXT("component_class"), ComponentClassPath) ||
             !Payload->TryGetStringField(TEXT("name"), ComponentName))
         {
-            OutError = TEXT("Missing 'asset_path', 'component_class', or 'name'.");
+            OutError = TEXT("Missing 'asset_path', 'component_class', or 'name'.");
+            return false;
+        }
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
+        {
+            OutError = TEXT("Blueprint not found.");
+            return false;
+        }
+
+        UClass* ComponentClass = Symbols->ResolveClass(ComponentClassPath, OutError);
+        if (!ComponentClass)
+        {
+            return false;
+        }
+
+        bool bOk = false;
+        RunGameThread([&]()
+        {
+            bOk = FMcpBlueprintMutator::AddComponent(Blueprint, ComponentClass, FName(*ComponentName), OutError);
+        });
+        if (!bOk)
+        {
+            return false;
+        }
+
+        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Added component '%s' to '%s'."), *ComponentName, *AssetPath));
+        return true;
+    }
+
+    if (Action == TEXT("set_pin_default"))
+    {
+        if (!RequireWrite())
+        {
+            return false;
+        }
+
+        FString AssetPath;
+        FString GraphName;
+        FString NodeGuidStr;
+        FString PinName;
+        FString LiteralValue;
+        if (!Payload.IsValid() ||
+            !Payload->TryGetStringField(TEXT("asset_path"), AssetPath) ||
+            !Payload->TryGetStringField(TEXT("graph"), GraphName) ||
+            !Payload->TryGetStringField(TEXT("node_guid"), NodeGuidStr) ||
+            !Payload->TryGetStringField(TEXT("pin_name"), PinName) ||
+            !Payload->TryGetStringField(TEXT("value"), LiteralValue))
+        {
+            OutError = TEXT("Missing parameters for set_pin_default.");
+            return false;
+        }
+
+        FGuid NodeGuid;
+        if (!FGuid::Parse(NodeGuidStr, NodeGuid))
+        {
+            OutError = TEXT("Invalid node_guid.");
+            return false;
+        }
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
+        {
+            OutError = TEXT("Blueprint not found.");
+            return false;
+        }
+
+        bool bOk = false;
+        RunGameThread([&]()
+        {
+            bOk = FMcpBlueprintMutator::SetPinDefault(Blueprint, FName(*GraphName), NodeGuid, PinName, LiteralValue, OutError);
+        });
+        if (!bOk)
+        {
+            return false;
+        }
+
+        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Set pin default %s on node %s"), *PinName, *NodeGuidStr));
+        return true;
+    }
+
+    if (Action == TEXT("connect_pins"))
+    {
+        if (!RequireWrite())
+        {
+            return false;
+        }
+
+        FString AssetPath;
+        FString GraphName;
+        FString FromGuidStr;
+        FString ToGuidStr;
+        FString FromPin;
+        FString ToPin;
+        if (!Payload.IsValid() ||
+            !Payload->TryGetStringField(TEXT("asset_path"), AssetPath) ||
+            !Payload->TryGetStringField(TEXT("graph"), GraphName) ||
+            !Payload->TryGetStringField(TEXT("from_node"), FromGuidStr) ||
+            !Payload->TryGetStringField(TEXT("from_pin"), FromPin) ||
+            !Payload->TryGetStringField(TEXT("to_node"), ToGuidStr) ||
+            !Payload->TryGetStringField(TEXT("to_pin"), ToPin))
+        {
+            OutError = TEXT("Missing parameters for connect_pins.");
+            return false;
+        }
+
+        FGuid FromGuid, ToGuid;
+        if (!FGuid::Parse(FromGuidStr, FromGuid) || !FGuid::Parse(ToGuidStr, ToGuid))
+        {
+            OutError = TEXT("Invalid node GUID.");
+            return false;
+        }
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
+        {
+            OutError = TEXT("Blueprint not found.");
+            return false;
+        }
+
+        bool bOk = false;
+        RunGameThread([&]()
+        {
+            bOk = FMcpBlueprintMutator::ConnectPins(Blueprint, FName(*GraphName), FromGuid, FromPin, ToGuid, ToPin, OutError);
+        });
+        if (!bOk)
+        {
+            return false;
+        }
+
+        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Connected pins %s:%s -> %s:%s"), *FromGuidStr, *FromPin, *ToGuidStr, *ToPin));
+        return true;
+    }
+
+    if (Action == TEXT("compile_blueprint"))
+    {
+        if (!RequireWrite())
+        {
+            return false;
+        }
+
+        FString AssetPath;
+        if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+        {
+            OutError = TEXT("Missing 'asset_path'");
+            return false;
+        }
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
+        {
+            OutError = TEXT("Blueprint not found.");
+            return false;
+        }
+
+        bool bOk = false;
+        RunGameThread([&]()
+        {
+            bOk = FMcpBlueprintMutator::Compile(Blueprint, OutError);
+        });
+        if (!bOk)
+        {
+            return false;
+        }
+
+        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Compiled Blueprint '%s'."), *AssetPath));
+        return true;
+    }
+
+    if (Action == TEXT("save_blueprint"))
+    {
+        if (!RequireWrite())
+        {
             return false;
         }
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
-        if (!Blueprint)
+        FString AssetPath;
+        if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
         {
-            OutError = TEXT("Blueprint not found.");
+            OutError = TEXT("Missing 'asset_path'");
             return false;
         }
 
-        UClass* ComponentClass = FindObject<UClass>(nullptr, *ComponentClassPath);
-        if (!ComponentClass)
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
         {
-            OutError = TEXT("Component class not found.");
+            OutError = TEXT("Blueprint not found.");
             return false;
         }
 
         bool bOk = false;
         RunGameThread([&]()
         {
-            bOk = FMcpBlueprintMutator::AddComponent(Blueprint, ComponentClass, FName(*ComponentName), OutError);
+            bOk = FMcpBlueprintMutator::SaveBlueprint(Blueprint, OutError);
         });
         if (!bOk)
         {
@@ -610,13 +1983,12 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
         ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
-        Log(FString::Printf(TEXT("Added component '%s' to '%s'."), *ComponentName, *AssetPath));
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Saved Blueprint '%s'."), *AssetPath));
         return true;
     }
 
-    if (Action == TEXT("set_pin_default"))
+    if (Action == TEXT("apply_graph"))
     {
         if (!RequireWrite())
         {
@@ -625,38 +1997,108 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
 
         FString AssetPath;
         FString GraphName;
-        FString NodeGuidStr;
-        FString PinName;
-        FString LiteralValue;
+        const TArray<TSharedPtr<FJsonValue>>* NodeArray = nullptr;
         if (!Payload.IsValid() ||
             !Payload->TryGetStringField(TEXT("asset_path"), AssetPath) ||
             !Payload->TryGetStringField(TEXT("graph"), GraphName) ||
-            !Payload->TryGetStringField(TEXT("node_guid"), NodeGuidStr) ||
-            !Payload->TryGetStringField(TEXT("pin_name"), PinName) ||
-            !Payload->TryGetStringField(TEXT("value"), LiteralValue))
+            !Payload->TryGetArrayField(TEXT("nodes"), NodeArray))
         {
-            OutError = TEXT("Missing parameters for set_pin_default.");
+            OutError = TEXT("Missing 'asset_path', 'graph', or 'nodes'.");
             return false;
         }
 
-        FGuid NodeGuid;
-        if (!FGuid::Parse(NodeGuidStr, NodeGuid))
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+        if (!Blueprint)
         {
-            OutError = TEXT("Invalid node_guid.");
+            OutError = TEXT("Blueprint not found.");
             return false;
         }
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
-        if (!Blueprint)
+        FMcpGraphSpec Spec;
+        Payload->TryGetStringField(TEXT("client_id"), Spec.ClientId);
+        Payload->TryGetBoolField(TEXT("remove_unlisted"), Spec.bRemoveUnlisted);
+
+        for (const TSharedPtr<FJsonValue>& NodeValue : *NodeArray)
         {
-            OutError = TEXT("Blueprint not found.");
-            return false;
+            const TSharedPtr<FJsonObject>* NodeObj = nullptr;
+            if (!NodeValue->TryGetObject(NodeObj))
+            {
+                OutError = TEXT("'nodes' must contain objects.");
+                return false;
+            }
+
+            FMcpGraphNodeSpec& NodeSpec = Spec.Nodes.AddDefaulted_GetRef();
+            (*NodeObj)->TryGetStringField(TEXT("id"), NodeSpec.Id);
+
+            FString NodeGuidStr;
+            FString FunctionPath;
+            FString EventName;
+            if ((*NodeObj)->TryGetStringField(TEXT("node_guid"), NodeGuidStr))
+            {
+                if (!FGuid::Parse(NodeGuidStr, NodeSpec.ExistingGuid))
+                {
+                    OutError = FString::Printf(TEXT("Invalid node_guid for node '%s'."), *NodeSpec.Id);
+                    return false;
+                }
+            }
+            else if ((*NodeObj)->TryGetStringField(TEXT("function_path"), FunctionPath))
+            {
+                NodeSpec.Function = Symbols->ResolveFunction(FunctionPath, OutError);
+                if (!NodeSpec.Function)
+                {
+                    return false;
+                }
+            }
+            else if ((*NodeObj)->TryGetStringField(TEXT("event_name"), EventName))
+            {
+                NodeSpec.EventName = FName(*EventName);
+            }
+
+            double PosX = 0;
+            double PosY = 0;
+            const bool bHasX = (*NodeObj)->TryGetNumberField(TEXT("x"), PosX);
+            const bool bHasY = (*NodeObj)->TryGetNumberField(TEXT("y"), PosY);
+            NodeSpec.bHasPosition = bHasX || bHasY;
+            NodeSpec.Position = FVector2D((float)PosX, (float)PosY);
+
+            const TSharedPtr<FJsonObject>* DefaultsObj = nullptr;
+            if ((*NodeObj)->TryGetObjectField(TEXT("defaults"), DefaultsObj))
+            {
+                for (const TPair<FString, TSharedPtr<FJsonValue>>& Default : (*DefaultsObj)->Values)
+                {
+                    // Numbers and booleans convert to their literal form.
+                    FString Value;
+                    Default.Value->TryGetString(Value);
+                    NodeSpec.Defaults.Add(Default.Key, Value);
+                }
+            }
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* LinkArray = nullptr;
+        if (Payload->TryGetArrayField(TEXT("links"), LinkArray))
+        {
+            for (const TSharedPtr<FJsonValue>& LinkValue : *LinkArray)
+            {
+                const TSharedPtr<FJsonObject>* LinkObj = nullptr;
+                FMcpGraphLinkSpec Link;
+                if (!LinkValue->TryGetObject(LinkObj) ||
+                    !(*LinkObj)->TryGetStringField(TEXT("from"), Link.FromId) ||
+                    !(*LinkObj)->TryGetStringField(TEXT("from_pin"), Link.FromPin) ||
+                    !(*LinkObj)->TryGetStringField(TEXT("to"), Link.ToId) ||
+                    !(*LinkObj)->TryGetStringField(TEXT("to_pin"), Link.ToPin))
+                {
+                    OutError = TEXT("Each link needs 'from', 'from_pin', 'to' and 'to_pin'.");
+                    return false;
+                }
+                Spec.Links.Add(MoveTemp(Link));
+            }
         }
 
+        FMcpGraphApplyResult Result;
         bool bOk = false;
         RunGameThread([&]()
         {
-            bOk = FMcpBlueprintMutator::SetPinDefault(Blueprint, FName(*GraphName), NodeGuid, PinName, LiteralValue, OutError);
+            bOk = FMcpBlueprintMutator::ApplyGraph(Blueprint, FName(*GraphName), Spec, Result, OutError);
         });
         if (!bOk)
         {
@@ -664,71 +2106,235 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         }
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
-        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
-        Log(FString::Printf(TEXT("Set pin default %s on node %s"), *PinName, *NodeGuidStr));
+        TSharedRef<FJsonObject> GuidsObj = MakeShared<FJsonObject>();
+        for (const TPair<FString, FGuid>& Pair : Result.NodeGuids)
+        {
+            GuidsObj->SetStringField(Pair.Key, Pair.Value.ToString(EGuidFormats::DigitsWithHyphens));
+        }
+        ResponseObj->SetObjectField(TEXT("node_guids"), GuidsObj);
+
+        TArray<TSharedPtr<FJsonValue>> EditArray;
+        for (const FMcpGraphEdit& Edit : Result.Edits)
+        {
+            TSharedRef<FJsonObject> EditObj = MakeShared<FJsonObject>();
+            EditObj->SetStringField(TEXT("op"), Edit.Op);
+            EditObj->SetStringField(TEXT("target"), Edit.Target);
+            if (!Edit.Detail.IsEmpty())
+            {
+                EditObj->SetStringField(TEXT("detail"), Edit.Detail);
+            }
+            EditArray.Add(MakeShared<FJsonValueObject>(EditObj));
+        }
+        ResponseObj->SetArrayField(TEXT("edits"), EditArray);
+
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Applied graph '%s' on '%s' (%d edits)."), *GraphName, *AssetPath, Result.Edits.Num()));
         return true;
     }
 
-    if (Action == TEXT("connect_pins"))
+    if (Action == TEXT("bulk_refactor"))
     {
-        if (!RequireWrite())
+        if (!Payload.IsValid())
         {
+            OutError = TEXT("Missing 'op'");
             return false;
         }
 
-        FString AssetPath;
-        FString GraphName;
-        FString FromGuidStr;
-        FString ToGuidStr;
-        FString FromPin;
-        FString ToPin;
-        if (!Payload.IsValid() ||
-            !Payload->TryGetStringField(TEXT("asset_path"), AssetPath) ||
-            !Payload->TryGetStringField(TEXT("graph"), GraphName) ||
-            !Payload->TryGetStringField(TEXT("from_node"), FromGuidStr) ||
-            !Payload->TryGetStringField(TEXT("from_pin"), FromPin) ||
-            !Payload->TryGetStringField(TEXT("to_node"), ToGuidStr) ||
-            !Payload->TryGetStringField(TEXT("to_pin"), ToPin))
+        int32 JobId = INDEX_NONE;
+        bool bCancel = false;
+        if (Payload->TryGetBoolField(TEXT("cancel"), bCancel) && bCancel)
+        {
+            if (!Payload->TryGetNumberField(TEXT("job_id"), JobId))
+            {
+                OutError = TEXT("Missing 'job_id'");
+                return false;
+            }
+            if (!Refactors->Cancel(JobId, OutError))
+            {
+                return false;
+            }
+            McpServer::SerializeResponse(Refactors->BuildJobJson(JobId).ToSharedRef(), OutResponse);
+            return true;
+        }
+
+        FString OpName;
+        FString From;
+        FString To;
+        FMcpRefactorSpec Spec;
+        Payload->TryGetStringField(TEXT("op"), OpName);
+        Payload->TryGetStringField(TEXT("from"), From);
+        Payload->TryGetStringField(TEXT("to"), To);
+        Payload->TryGetBoolField(TEXT("dry_run"), Spec.bDryRun);
+        Payload->TryGetBoolField(TEXT("save"), Spec.bSave);
+        Payload->TryGetBoolField(TEXT("reparent"), Spec.bReparent);
+        if (!FMcpBulkRefactor::ParseOp(OpName, Spec.Op))
+        {
+            OutError = FString::Printf(TEXT("Unknown op '%s' (replace_function_call, rename_variable, retarget_class, replace_component_class)"), *OpName);
+            return false;
+        }
+        if (From.IsEmpty() || To.IsEmpty())
+        {
+            OutError = TEXT("Missing 'from' or 'to'");
+            return false;
+        }
+        // A dry run only reads, so it is allowed while writes are disabled.
+        if (!Spec.bDryRun && !RequireWrite())
         {
-            OutError = TEXT("Missing parameters for connect_pins.");
             return false;
         }
 
-        FGuid FromGuid, ToGuid;
-        if (!FGuid::Parse(FromGuidStr, FromGuid) || !FGuid::Parse(ToGuidStr, ToGuid))
+        const TArray<TSharedPtr<FJsonValue>>* RootArray = nullptr;
+        if (Payload->TryGetArrayField(TEXT("roots"), RootArray))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *RootArray)
+            {
+                Spec.Roots.Add(Value->AsString());
+            }
+        }
+
+        switch (Spec.Op)
+        {
+        case EMcpRefactorOp::ReplaceFunctionCall:
+        {
+            Spec.FromFunction = Symbols->ResolveFunction(From, OutError);
+            Spec.ToFunction = Spec.FromFunction ? Symbols->ResolveFunction(To, OutError) : nullptr;
+            if (!Spec.ToFunction)
+            {
+                return false;
+            }
+
+            const TSharedPtr<FJsonObject>* PinMapObj = nullptr;
+            if (Payload->TryGetObjectField(TEXT("pin_map"), PinMapObj))
+            {
+                for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*PinMapObj)->Values)
+                {
+                    Spec.PinMap.Add(FName(*Pair.Key), FName(*Pair.Value->AsString()));
+                }
+            }
+            break;
+        }
+
+        case EMcpRefactorOp::RenameVariable:
+        {
+            FString AssetPath;
+            if (!Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+            {
+                OutError = TEXT("Missing 'asset_path' of the Blueprint that owns the variable");
+                return false;
+            }
+            Spec.Owner = Blueprints->Load(AssetPath);
+            if (!Spec.Owner)
+            {
+                OutError = FString::Printf(TEXT("Failed to load Blueprint '%s'"), *AssetPath);
+                return false;
+            }
+            Spec.FromVariable = FName(*From);
+            Spec.ToVariable = FName(*To);
+            break;
+        }
+
+        default:
+            Spec.FromClass = Symbols->ResolveClass(From, OutError);
+            Spec.ToClass = Spec.FromClass ? Symbols->ResolveClass(To, OutError) : nullptr;
+            if (!Spec.ToClass)
+            {
+                return false;
+            }
+            break;
+        }
+
+        if (!Refactors->Start(Spec, JobId, OutError))
         {
-            OutError = TEXT("Invalid node GUID.");
             return false;
         }
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
-        if (!Blueprint)
+        McpServer::SerializeResponse(Refactors->BuildJobJson(JobId).ToSharedRef(), OutResponse);
+        Log(FString::Printf(TEXT("Started bulk refactor %d (%s %s -> %s%s)."), JobId, *OpName, *From, *To, Spec.bDryRun ? TEXT(", dry run") : TEXT("")));
+        return true;
+    }
+
+    if (Action == TEXT("resolve_symbols"))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* SymbolArray = nullptr;
+        if (!Payload.IsValid() || !Payload->TryGetArrayField(TEXT("symbols"), SymbolArray))
         {
-            OutError = TEXT("Blueprint not found.");
+            OutError = TEXT("Missing 'symbols'");
             return false;
         }
 
-        bool bOk = false;
-        RunGameThread([&]()
+        TArray<TSharedPtr<FJsonValue>> Results;
+        for (const TSharedPtr<FJsonValue>& SymbolValue : *SymbolArray)
         {
-            bOk = FMcpBlueprintMutator::ConnectPins(Blueprint, FName(*GraphName), FromGuid, FromPin, ToGuid, ToPin, OutError);
-        });
-        if (!bOk)
+            const TSharedPtr<FJsonObject>* SymbolObj = nullptr;
+            FString Name;
+            FString Kind = TEXT("class");
+            if (!SymbolValue->TryGetObject(SymbolObj) || !(*SymbolObj)->TryGetStringField(TEXT("name"), Name))
+            {
+                OutError = TEXT("Each symbol needs a 'name'.");
+                return false;
+            }
+            (*SymbolObj)->TryGetStringField(TEXT("kind"), Kind);
+
+            FString ResolveError;
+            TArray<FString> Candidates;
+            const UObject* Resolved = nullptr;
+            if (Kind == TEXT("function"))
+            {
+                Resolved = Symbols->ResolveFunction(Name, ResolveError, &Candidates);
+            }
+            else if (Kind == TEXT("class"))
+            {
+                Resolved = Symbols->ResolveClass(Name, ResolveError, &Candidates);
+            }
+            else
+            {
+                ResolveError = FString::Printf(TEXT("Unknown kind '%s'."), *Kind);
+            }
+
+            TSharedRef<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+            ResultObj->SetStringField(TEXT("name"), Name);
+            ResultObj->SetStringField(TEXT("kind"), Kind);
+            if (Resolved)
+            {
+                ResultObj->SetStringField(TEXT("path"), Resolved->GetPathName());
+            }
+            else
+            {
+                ResultObj->SetStringField(TEXT("error"), ResolveError);
+                if (Candidates.Num() > 0)
+                {
+                    TArray<TSharedPtr<FJsonValue>> CandidateValues;
+                    for (const FString& Candidate : Candidates)
+                    {
+                        CandidateValues.Add(MakeShared<FJsonValueString>(Candidate));
+                    }
+                    ResultObj->SetArrayField(TEXT("candidates"), CandidateValues);
+                }
+            }
+            Results.Add(MakeShared<FJsonValueObject>(ResultObj));
+        }
+
+        TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
+        ResponseObj->SetArrayField(TEXT("symbols"), Results);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        return true;
+    }
+
+    if (Action == TEXT("list_templates"))
+    {
+        TArray<TSharedPtr<FJsonValue>> NameValues;
+        for (const FString& Name : Templates->GetTemplateNames())
         {
-            return false;
+            NameValues.Add(MakeShared<FJsonValueString>(Name));
         }
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
-        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
-        Log(FString::Printf(TEXT("Connected pins %s:%s -> %s:%s"), *FromGuidStr, *FromPin, *ToGuidStr, *ToPin));
+        ResponseObj->SetArrayField(TEXT("templates"), NameValues);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
         return true;
     }
 
-    if (Action == TEXT("compile_blueprint"))
+    if (Action == TEXT("capture_template"))
     {
         if (!RequireWrite())
         {
@@ -736,73 +2342,170 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
         }
 
         FString AssetPath;
-        if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+        FString GraphName;
+        FString TemplateName;
+        const TArray<TSharedPtr<FJsonValue>>* GuidArray = nullptr;
+        if (!Payload.IsValid() ||
+            !Payload->TryGetStringField(TEXT("asset_path"), AssetPath) ||
+            !Payload->TryGetStringField(TEXT("graph"), GraphName) ||
+            !Payload->TryGetStringField(TEXT("name"), TemplateName) ||
+            !Payload->TryGetArrayField(TEXT("node_guids"), GuidArray))
         {
-            OutError = TEXT("Missing 'asset_path'");
+            OutError = TEXT("Missing 'asset_path', 'graph', 'name', or 'node_guids'.");
             return false;
         }
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        TArray<FGuid> NodeGuids;
+        for (const TSharedPtr<FJsonValue>& Value : *GuidArray)
+        {
+            FGuid NodeGuid;
+            if (!FGuid::Parse(Value->AsString(), NodeGuid))
+            {
+                OutError = FString::Printf(TEXT("Invalid node guid '%s'."), *Value->AsString());
+                return false;
+            }
+            NodeGuids.Add(NodeGuid);
+        }
+
+        UBlueprint* Blueprint = Blueprints->Load(AssetPath);
         if (!Blueprint)
         {
             OutError = TEXT("Blueprint not found.");
             return false;
         }
 
+        TArray<FMcpTemplateNodeInfo> Nodes;
         bool bOk = false;
         RunGameThread([&]()
         {
-            bOk = FMcpBlueprintMutator::Compile(Blueprint, OutError);
+            bOk = Templates->Capture(TemplateName, Blueprint, FName(*GraphName), NodeGuids, Nodes, OutError);
         });
         if (!bOk)
         {
             return false;
         }
 
+        TArray<TSharedPtr<FJsonValue>> NodeValues;
+        for (const FMcpTemplateNodeInfo& Node : Nodes)
+        {
+            TSharedRef<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+            NodeObj->SetStringField(TEXT("key"), Node.Key);
+            NodeObj->SetStringField(TEXT("class"), Node.Class);
+            NodeObj->SetStringField(TEXT("title"), Node.Title);
+            NodeValues.Add(MakeShared<FJsonValueObject>(NodeObj));
+        }
+
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
-        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
-        Log(FString::Printf(TEXT("Compiled Blueprint '%s'."), *AssetPath));
+        ResponseObj->SetStringField(TEXT("name"), TemplateName);
+        ResponseObj->SetArrayField(TEXT("nodes"), NodeValues);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Captured template '%s' (%d nodes)."), *TemplateName, Nodes.Num()));
         return true;
     }
 
-    if (Action == TEXT("save_blueprint"))
+    if (Action == TEXT("instantiate_template"))
     {
         if (!RequireWrite())
         {
             return false;
         }
 
-        FString AssetPath;
-        if (!Payload.IsValid() || !Payload->TryGetStringField(TEXT("asset_path"), AssetPath))
+        FString TemplateName;
+        const TArray<TSharedPtr<FJsonValue>>* TargetArray = nullptr;
+        if (!Payload.IsValid() ||
+            !Payload->TryGetStringField(TEXT("name"), TemplateName) ||
+            !Payload->TryGetArrayField(TEXT("targets"), TargetArray))
         {
-            OutError = TEXT("Missing 'asset_path'");
+            OutError = TEXT("Missing 'name' or 'targets'.");
             return false;
         }
 
-        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
-        if (!Blueprint)
+        TMap<FString, TMap<FString, FString>> PinOverrides;
+        const TSharedPtr<FJsonObject>* OverridesObj = nullptr;
+        if (Payload->TryGetObjectField(TEXT("overrides"), OverridesObj))
         {
-            OutError = TEXT("Blueprint not found.");
-            return false;
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& NodePair : (*OverridesObj)->Values)
+            {
+                const TSharedPtr<FJsonObject>* PinsObj = nullptr;
+                if (!NodePair.Value->TryGetObject(PinsObj))
+                {
+                    continue;
+                }
+
+                TMap<FString, FString>& NodeOverrides = PinOverrides.Add(NodePair.Key);
+                for (const TPair<FString, TSharedPtr<FJsonValue>>& PinPair : (*PinsObj)->Values)
+                {
+                    FString Value;
+                    PinPair.Value->TryGetString(Value);
+                    NodeOverrides.Add(PinPair.Key, Value);
+                }
+            }
         }
 
-        bool bOk = false;
+        int32 NumFailed = 0;
+        TArray<TSharedPtr<FJsonValue>> ResultValues;
         RunGameThread([&]()
         {
-            bOk = FMcpBlueprintMutator::SaveBlueprint(Blueprint, OutError);
+            for (const TSharedPtr<FJsonValue>& TargetValue : *TargetArray)
+            {
+                TSharedRef<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+                ResultValues.Add(MakeShared<FJsonValueObject>(ResultObj));
+
+                const TSharedPtr<FJsonObject>* TargetObj = nullptr;
+                FString AssetPath;
+                FString GraphName;
+                if (!TargetValue->TryGetObject(TargetObj) ||
+                    !(*TargetObj)->TryGetStringField(TEXT("asset_path"), AssetPath) ||
+                    !(*TargetObj)->TryGetStringField(TEXT("graph"), GraphName))
+                {
+                    ResultObj->SetStringField(TEXT("error"), TEXT("Target needs 'asset_path' and 'graph'."));
+                    ++NumFailed;
+                    continue;
+                }
+
+                ResultObj->SetStringField(TEXT("asset_path"), AssetPath);
+                double PosX = 0;
+                double PosY = 0;
+                (*TargetObj)->TryGetNumberField(TEXT("x"), PosX);
+                (*TargetObj)->TryGetNumberField(TEXT("y"), PosY);
+
+                UBlueprint* Blueprint = Blueprints->Load(AssetPath);
+                if (!Blueprint)
+                {
+                    ResultObj->SetStringField(TEXT("error"), TEXT("Blueprint not found."));
+                    ++NumFailed;
+                    continue;
+                }
+
+                TMap<FString, FGuid> NodeGuids;
+                FString TargetError;
+                if (!Templates->Instantiate(TemplateName, Blueprint, FName(*GraphName), FVector2D(PosX, PosY), PinOverrides, NodeGuids, TargetError))
+                {
+                    ResultObj->SetStringField(TEXT("error"), TargetError);
+                    ++NumFailed;
+                    continue;
+                }
+
+                TSharedRef<FJsonObject> GuidsObj = MakeShared<FJsonObject>();
+                for (const TPair<FString, FGuid>& Pair : NodeGuids)
+                {
+                    GuidsObj->SetStringField(Pair.Key, Pair.Value.ToString(EGuidFormats::DigitsWithHyphens));
+                }
+                ResultObj->SetObjectField(TEXT("node_guids"), GuidsObj);
+            }
         });
-        if (!bOk)
+
+        if (NumFailed == ResultValues.Num() && NumFailed > 0)
         {
+            OutError = TEXT("Template could not be instantiated into any target.");
             return false;
         }
 
         TSharedRef<FJsonObject> ResponseObj = MakeShared<FJsonObject>();
-        ResponseObj->SetStringField(TEXT("status"), TEXT("ok"));
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutResponse);
-        FJsonSerializer::Serialize(ResponseObj, Writer);
-        Log(FString::Printf(TEXT("Saved Blueprint '%s'."), *AssetPath));
+        ResponseObj->SetArrayField(TEXT("results"), ResultValues);
+        ResponseObj->SetNumberField(TEXT("failed"), NumFailed);
+        McpServer::SerializeResponse(ResponseObj, OutResponse);
+        Log(FString::Printf(TEXT("Instantiated template '%s' into %d targets (%d failed)."), *TemplateName, ResultValues.Num() - NumFailed, NumFailed));
         return true;
     }
 
@@ -810,19 +2513,59 @@ bool FMcpServer::DispatchAction(const FString& Action, const TSharedPtr<FJsonObj
     return false;
 }
 
-void FMcpServer::Log(const FString& Message) const
+void FMcpServer::Log(const FString& Message, EMcpLogSeverity Severity) const
 {
-    UE_LOG(LogTemp, Log, TEXT("[MCP] %s"), *Message);
+    switch (Severity)
+    {
+    case EMcpLogSeverity::Error:
+        UE_LOG(LogTemp, Error, TEXT("[MCP] %s"), *Message);
+        break;
+    case EMcpLogSeverity::Warning:
+        UE_LOG(LogTemp, Warning, TEXT("[MCP] %s"), *Message);
+        break;
+    default:
+        UE_LOG(LogTemp, Log, TEXT("[MCP] %s"), *Message);
+        break;
+    }
 
-    if (OnLog.IsBound())
+    if (!bLogCaptureEnabled.load(std::memory_order_relaxed))
     {
-        TWeakPtr<FMcpServer> SelfWeak = const_cast<FMcpServer*>(this)->AsShared();
-        AsyncTask(ENamedThreads::GameThread, [SelfWeak, Message]()
-        {
-            if (TSharedPtr<FMcpServer> Self = SelfWeak.Pin())
-            {
-                Self->OnLog.Broadcast(Message);
-            }
-        });
+        return;
+    }
+
+    // Bounded so a closed or hidden panel cannot make the queue grow without limit.
+    if (PendingLogCount.fetch_add(1, std::memory_order_relaxed) >= McpServer::MaxPendingLogEntries)
+    {
+        PendingLogCount.fetch_sub(1, std::memory_order_relaxed);
+        DroppedLogCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    FMcpLogEntry Entry;
+    Entry.Time = FDateTime::Now();
+    Entry.Severity = Severity;
+    Entry.Message = Message;
+    PendingLog.Enqueue(MoveTemp(Entry));
+}
+
+int32 FMcpServer::DrainLog(TArray<FMcpLogEntry>& OutEntries, int32 MaxEntries)
+{
+    const int32 Dropped = DroppedLogCount.exchange(0, std::memory_order_relaxed);
+    if (Dropped > 0)
+    {
+        FMcpLogEntry& Entry = OutEntries.AddDefaulted_GetRef();
+        Entry.Time = FDateTime::Now();
+        Entry.Severity = EMcpLogSeverity::Warning;
+        Entry.Message = FString::Printf(TEXT("%d log messages dropped."), Dropped);
+    }
+
+    int32 NumDrained = 0;
+    FMcpLogEntry Entry;
+    while (NumDrained < MaxEntries && PendingLog.Dequeue(Entry))
+    {
+        OutEntries.Add(MoveTemp(Entry));
+        ++NumDrained;
     }
+    PendingLogCount.fetch_sub(NumDrained, std::memory_order_relaxed);
+    return NumDrained;
 }
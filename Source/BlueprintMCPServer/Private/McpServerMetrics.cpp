@@ -0,0 +1,422 @@
+#include "McpServerMetrics.h"
+
+#include "Json.h"
+
+namespace McpServerMetrics
+{
+    static thread_local FMcpRequestTiming* CurrentTiming = nullptr;
+
+    static const TCHAR* OverflowActionName = TEXT("other");
+
+    static FString FormatSeconds(double Seconds)
+    {
+        return FString::SanitizeFloat(Seconds);
+    }
+
+    // Label values in the Prometheus text format escape backslash, double quote and line feed.
+    static FString EscapeLabel(const FString& Value)
+    {
+        return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")).Replace(TEXT("\n"), TEXT("\\n"));
+    }
+}
+
+const double FMcpLatencyHistogram::BucketUpperBounds[FMcpLatencyHistogram::NumBuckets] =
+{
+    0.00005, 0.0001, 0.00025, 0.0005,
+    0.001, 0.0025, 0.005, 0.01,
+    0.025, 0.05, 0.1, 0.25,
+    0.5, 1.0, 2.5, 5.0,
+    10.0, 30.0
+};
+
+FMcpRequestTimingScope::FMcpRequestTimingScope(FMcpRequestTiming& Timing)
+    : Previous(McpServerMetrics::CurrentTiming)
+{
+    McpServerMetrics::CurrentTiming = &Timing;
+}
+
+FMcpRequestTimingScope::~FMcpRequestTimingScope()
+{
+    McpServerMetrics::CurrentTiming = Previous;
+}
+
+FMcpRequestTiming* FMcpRequestTimingScope::GetCurrent()
+{
+    return McpServerMetrics::CurrentTiming;
+}
+
+FMcpScopedSerializationTimer::FMcpScopedSerializationTimer()
+    : StartTime(FPlatformTime::Seconds())
+{
+}
+
+FMcpScopedSerializationTimer::~FMcpScopedSerializationTimer()
+{
+    if (FMcpRequestTiming* Timing = FMcpRequestTimingScope::GetCurrent())
+    {
+        Timing->SerializationSeconds += FPlatformTime::Seconds() - StartTime;
+    }
+}
+
+FMcpLatencyHistogram::FMcpLatencyHistogram()
+{
+    for (std::atomic<uint64>& Count : Counts)
+    {
+        Count.store(0, std::memory_order_relaxed);
+    }
+    SumMicros.store(0, std::memory_order_relaxed);
+}
+
+void FMcpLatencyHistogram::Record(double Seconds)
+{
+    int32 Bucket = 0;
+    while (Bucket < NumBuckets && Seconds > BucketUpperBounds[Bucket])
+    {
+        ++Bucket;
+    }
+
+    Counts[Bucket].fetch_add(1, std::memory_order_relaxed);
+    SumMicros.fetch_add((uint64)FMath::Max(0.0, Seconds * 1000000.0), std::memory_order_relaxed);
+}
+
+uint64 FMcpLatencyHistogram::GetCount() const
+{
+    uint64 Total = 0;
+    for (const std::atomic<uint64>& Count : Counts)
+    {
+        Total += Count.load(std::memory_order_relaxed);
+    }
+    return Total;
+}
+
+double FMcpLatencyHistogram::GetSumSeconds() const
+{
+    return (double)SumMicros.load(std::memory_order_relaxed) / 1000000.0;
+}
+
+double FMcpLatencyHistogram::GetPercentile(double Fraction) const
+{
+    uint64 Snapshot[NumBuckets + 1];
+    for (int32 Index = 0; Index <= NumBuckets; ++Index)
+    {
+        Snapshot[Index] = Counts[Index].load(std::memory_order_relaxed);
+    }
+    return GetPercentile(Snapshot, Fraction);
+}
+
+double FMcpLatencyHistogram::GetPercentile(TConstArrayView<uint64> BucketCounts, double Fraction)
+{
+    check(BucketCounts.Num() == NumBuckets + 1);
+
+    uint64 Total = 0;
+    for (const uint64 Count : BucketCounts)
+    {
+        Total += Count;
+    }
+
+    if (Total == 0)
+    {
+        return 0.0;
+    }
+
+    // Interpolate linearly inside the bucket that contains the requested rank.
+    const double Rank = Fraction * (double)Total;
+    uint64 Cumulative = 0;
+    for (int32 Index = 0; Index <= NumBuckets; ++Index)
+    {
+        if (BucketCounts[Index] == 0)
+        {
+            continue;
+        }
+
+        if ((double)(Cumulative + BucketCounts[Index]) >= Rank)
+        {
+            const double Lower = Index == 0 ? 0.0 : BucketUpperBounds[Index - 1];
+            const double Upper = Index < NumBuckets ? BucketUpperBounds[Index] : BucketUpperBounds[NumBuckets - 1];
+            const double Within = (Rank - (double)Cumulative) / (double)BucketCounts[Index];
+            return Lower + (Upper - Lower) * FMath::Clamp(Within, 0.0, 1.0);
+        }
+        Cumulative += BucketCounts[Index];
+    }
+
+    return BucketUpperBounds[NumBuckets - 1];
+}
+
+FMcpServerMetrics& FMcpServerMetrics::Get()
+{
+    static FMcpServerMetrics Instance;
+    return Instance;
+}
+
+FMcpServerMetrics::FMcpServerMetrics()
+{
+    Actions[0].Action = McpServerMetrics::OverflowActionName;
+    NumActions.store(1, std::memory_order_release);
+}
+
+void FMcpServerMetrics::BeginRequest()
+{
+    InFlight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FMcpServerMetrics::EndRequest(const FString& Action, bool bSuccess, const FMcpRequestTiming& Timing)
+{
+    InFlight.fetch_sub(1, std::memory_order_relaxed);
+
+    FActionStats& Stats = FindAction(Action);
+    Stats.Requests.fetch_add(1, std::memory_order_relaxed);
+    if (!bSuccess)
+    {
+        Stats.Errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    Stats.RequestBytes.fetch_add((uint64)FMath::Max<int64>(0, Timing.RequestBytes), std::memory_order_relaxed);
+    Stats.ResponseBytes.fetch_add((uint64)FMath::Max<int64>(0, Timing.ResponseBytes), std::memory_order_relaxed);
+
+    Stats.Stages[(int32)EMcpLatencyStage::QueueWait].Record(Timing.QueueWaitSeconds);
+    Stats.Stages[(int32)EMcpLatencyStage::GameThread].Record(Timing.GameThreadSeconds);
+    Stats.Stages[(int32)EMcpLatencyStage::Serialization].Record(Timing.SerializationSeconds);
+    Stats.Stages[(int32)EMcpLatencyStage::Total].Record(Timing.TotalSeconds);
+}
+
+void FMcpServerMetrics::RegisterActions(TConstArrayView<const TCHAR*> Names)
+{
+    FScopeLock Lock(&RegistrationMutex);
+    for (const TCHAR* Name : Names)
+    {
+        const int32 Count = NumActions.load(std::memory_order_acquire);
+        bool bFound = false;
+        for (int32 Index = 0; Index < Count && !bFound; ++Index)
+        {
+            bFound = Actions[Index].Action == Name;
+        }
+        if (!bFound && ensureMsgf(Count < MaxActions, TEXT("Raise FMcpServerMetrics::MaxActions.")))
+        {
+            Actions[Count].Action = Name;
+            NumActions.store(Count + 1, std::memory_order_release);
+        }
+    }
+}
+
+FMcpServerMetrics::FActionStats& FMcpServerMetrics::FindAction(const FString& Action)
+{
+    // Slots never move once published, so lookups only need the acquire on the count.
+    const int32 Count = NumActions.load(std::memory_order_acquire);
+    for (int32 Index = 1; Index < Count; ++Index)
+    {
+        if (Actions[Index].Action == Action)
+        {
+            return Actions[Index];
+        }
+    }
+    return Actions[0];
+}
+
+void FMcpServerMetrics::RegisterCache(const FString& Name, FMcpCacheCounters* Counters)
+{
+    FScopeLock Lock(&CacheMutex);
+    Caches.Emplace(Name, Counters);
+}
+
+void FMcpServerMetrics::UnregisterCache(FMcpCacheCounters* Counters)
+{
+    FScopeLock Lock(&CacheMutex);
+    Caches.RemoveAll([Counters](const TPair<FString, FMcpCacheCounters*>& Entry)
+    {
+        return Entry.Value == Counters;
+    });
+}
+
+TSharedRef<FJsonObject> FMcpServerMetrics::BuildStatsJson() const
+{
+    TSharedRef<FJsonObject> StatsObj = MakeShared<FJsonObject>();
+    StatsObj->SetNumberField(TEXT("in_flight"), InFlight.load(std::memory_order_relaxed));
+
+    TSharedRef<FJsonObject> ActionsObj = MakeShared<FJsonObject>();
+    const int32 Count = NumActions.load(std::memory_order_acquire);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FActionStats& Stats = Actions[Index];
+        const uint64 Requests = Stats.Requests.load(std::memory_order_relaxed);
+        if (Requests == 0)
+        {
+            continue;
+        }
+
+        TSharedRef<FJsonObject> ActionObj = MakeShared<FJsonObject>();
+        ActionObj->SetNumberField(TEXT("requests"), (double)Requests);
+        ActionObj->SetNumberField(TEXT("errors"), (double)Stats.Errors.load(std::memory_order_relaxed));
+        ActionObj->SetNumberField(TEXT("request_bytes"), (double)Stats.RequestBytes.load(std::memory_order_relaxed));
+        ActionObj->SetNumberField(TEXT("response_bytes"), (double)Stats.ResponseBytes.load(std::memory_order_relaxed));
+
+        TSharedRef<FJsonObject> LatencyObj = MakeShared<FJsonObject>();
+        for (int32 Stage = 0; Stage < (int32)EMcpLatencyStage::Num; ++Stage)
+        {
+            const FMcpLatencyHistogram& Histogram = Stats.Stages[Stage];
+            const uint64 StageCount = Histogram.GetCount();
+
+            TSharedRef<FJsonObject> StageObj = MakeShared<FJsonObject>();
+            StageObj->SetNumberField(TEXT("p50"), Histogram.GetPercentile(0.50) * 1000.0);
+            StageObj->SetNumberField(TEXT("p95"), Histogram.GetPercentile(0.95) * 1000.0);
+            StageObj->SetNumberField(TEXT("p99"), Histogram.GetPercentile(0.99) * 1000.0);
+            StageObj->SetNumberField(TEXT("mean"), StageCount > 0 ? Histogram.GetSumSeconds() * 1000.0 / (double)StageCount : 0.0);
+            LatencyObj->SetObjectField(GetStageName((EMcpLatencyStage)Stage), StageObj);
+        }
+        ActionObj->SetObjectField(TEXT("latency_ms"), LatencyObj);
+
+        ActionsObj->SetObjectField(Stats.Action, ActionObj);
+    }
+    StatsObj->SetObjectField(TEXT("actions"), ActionsObj);
+
+    TSharedRef<FJsonObject> CachesObj = MakeShared<FJsonObject>();
+    {
+        FScopeLock Lock(&CacheMutex);
+        for (const TPair<FString, FMcpCacheCounters*>& Entry : Caches)
+        {
+            const uint64 Hits = Entry.Value->Hits.load(std::memory_order_relaxed);
+            const uint64 Misses = Entry.Value->Misses.load(std::memory_order_relaxed);
+
+            TSharedRef<FJsonObject> CacheObj = MakeShared<FJsonObject>();
+            CacheObj->SetNumberField(TEXT("hits"), (double)Hits);
+            CacheObj->SetNumberField(TEXT("misses"), (double)Misses);
+            CacheObj->SetNumberField(TEXT("hit_rate"), Hits + Misses > 0 ? (double)Hits / (double)(Hits + Misses) : 0.0);
+            CacheObj->SetNumberField(TEXT("rebuilds"), (double)Entry.Value->Rebuilds.load(std::memory_order_relaxed));
+            CachesObj->SetObjectField(Entry.Key, CacheObj);
+        }
+    }
+    StatsObj->SetObjectField(TEXT("caches"), CachesObj);
+
+    // Raw bucket counts let clients compute percentiles for a window from two snapshots.
+    TSharedRef<FJsonObject> FrameObj = MakeShared<FJsonObject>();
+    const uint64 FrameCount = FrameTimes.GetCount();
+    FrameObj->SetNumberField(TEXT("count"), (double)FrameCount);
+    FrameObj->SetNumberField(TEXT("p50"), FrameTimes.GetPercentile(0.50) * 1000.0);
+    FrameObj->SetNumberField(TEXT("p95"), FrameTimes.GetPercentile(0.95) * 1000.0);
+    FrameObj->SetNumberField(TEXT("p99"), FrameTimes.GetPercentile(0.99) * 1000.0);
+    FrameObj->SetNumberField(TEXT("mean"), FrameCount > 0 ? FrameTimes.GetSumSeconds() * 1000.0 / (double)FrameCount : 0.0);
+    TArray<TSharedPtr<FJsonValue>> BucketArray;
+    for (int32 Bucket = 0; Bucket <= FMcpLatencyHistogram::NumBuckets; ++Bucket)
+    {
+        BucketArray.Add(MakeShared<FJsonValueNumber>((double)FrameTimes.GetBucketCount(Bucket)));
+    }
+    FrameObj->SetArrayField(TEXT("buckets"), BucketArray);
+    StatsObj->SetObjectField(TEXT("frame_time_ms"), FrameObj);
+
+    return StatsObj;
+}
+
+FString FMcpServerMetrics::BuildPrometheusText() const
+{
+    FString Out;
+    Out.Reserve(16 * 1024);
+
+    Out += TEXT("# HELP mcp_in_flight_requests Requests currently being handled.\n");
+    Out += TEXT("# TYPE mcp_in_flight_requests gauge\n");
+    Out += FString::Printf(TEXT("mcp_in_flight_requests %d\n"), InFlight.load(std::memory_order_relaxed));
+
+    const int32 Count = NumActions.load(std::memory_order_acquire);
+
+    auto AppendCounter = [this, Count, &Out](const TCHAR* Name, const TCHAR* Help, TFunctionRef<uint64(const FActionStats&)> Getter)
+    {
+        Out += FString::Printf(TEXT("# HELP %s %s\n# TYPE %s counter\n"), Name, Help, Name);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            if (Actions[Index].Requests.load(std::memory_order_relaxed) > 0)
+            {
+                Out += FString::Printf(TEXT("%s{action=\"%s\"} %llu\n"), Name, *McpServerMetrics::EscapeLabel(Actions[Index].Action), Getter(Actions[Index]));
+            }
+        }
+    };
+
+    AppendCounter(TEXT("mcp_requests_total"), TEXT("Requests handled per action."),
+        [](const FActionStats& Stats) { return Stats.Requests.load(std::memory_order_relaxed); });
+    AppendCounter(TEXT("mcp_request_errors_total"), TEXT("Failed requests per action."),
+        [](const FActionStats& Stats) { return Stats.Errors.load(std::memory_order_relaxed); });
+    AppendCounter(TEXT("mcp_request_bytes_total"), TEXT("Request body bytes per action."),
+        [](const FActionStats& Stats) { return Stats.RequestBytes.load(std::memory_order_relaxed); });
+    AppendCounter(TEXT("mcp_response_bytes_total"), TEXT("Response body bytes per action."),
+        [](const FActionStats& Stats) { return Stats.ResponseBytes.load(std::memory_order_relaxed); });
+
+    Out += TEXT("# HELP mcp_request_duration_seconds Request latency per action and stage.\n");
+    Out += TEXT("# TYPE mcp_request_duration_seconds histogram\n");
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FActionStats& Stats = Actions[Index];
+        if (Stats.Requests.load(std::memory_order_relaxed) == 0)
+        {
+            continue;
+        }
+        const FString ActionLabel = McpServerMetrics::EscapeLabel(Stats.Action);
+
+        for (int32 Stage = 0; Stage < (int32)EMcpLatencyStage::Num; ++Stage)
+        {
+            const FMcpLatencyHistogram& Histogram = Stats.Stages[Stage];
+            const TCHAR* StageName = GetStageName((EMcpLatencyStage)Stage);
+
+            uint64 Cumulative = 0;
+            for (int32 Bucket = 0; Bucket < FMcpLatencyHistogram::NumBuckets; ++Bucket)
+            {
+                Cumulative += Histogram.GetBucketCount(Bucket);
+                Out += FString::Printf(TEXT("mcp_request_duration_seconds_bucket{action=\"%s\",stage=\"%s\",le=\"%s\"} %llu\n"),
+                    *ActionLabel, StageName, *McpServerMetrics::FormatSeconds(FMcpLatencyHistogram::BucketUpperBounds[Bucket]), Cumulative);
+            }
+            Cumulative += Histogram.GetBucketCount(FMcpLatencyHistogram::NumBuckets);
+            Out += FString::Printf(TEXT("mcp_request_duration_seconds_bucket{action=\"%s\",stage=\"%s\",le=\"+Inf\"} %llu\n"), *ActionLabel, StageName, Cumulative);
+            Out += FString::Printf(TEXT("mcp_request_duration_seconds_sum{action=\"%s\",stage=\"%s\"} %s\n"), *ActionLabel, StageName, *McpServerMetrics::FormatSeconds(Histogram.GetSumSeconds()));
+            Out += FString::Printf(TEXT("mcp_request_duration_seconds_count{action=\"%s\",stage=\"%s\"} %llu\n"), *ActionLabel, StageName, Cumulative);
+        }
+    }
+
+    if (const uint64 FrameCount = FrameTimes.GetCount())
+    {
+        Out += TEXT("# HELP mcp_frame_time_seconds Game thread frame time while the server runs.\n");
+        Out += TEXT("# TYPE mcp_frame_time_seconds histogram\n");
+        uint64 Cumulative = 0;
+        for (int32 Bucket = 0; Bucket < FMcpLatencyHistogram::NumBuckets; ++Bucket)
+        {
+            Cumulative += FrameTimes.GetBucketCount(Bucket);
+            Out += FString::Printf(TEXT("mcp_frame_time_seconds_bucket{le=\"%s\"} %llu\n"),
+                *McpServerMetrics::FormatSeconds(FMcpLatencyHistogram::BucketUpperBounds[Bucket]), Cumulative);
+        }
+        Out += FString::Printf(TEXT("mcp_frame_time_seconds_bucket{le=\"+Inf\"} %llu\n"), FrameCount);
+        Out += FString::Printf(TEXT("mcp_frame_time_seconds_sum %s\n"), *McpServerMetrics::FormatSeconds(FrameTimes.GetSumSeconds()));
+        Out += FString::Printf(TEXT("mcp_frame_time_seconds_count %llu\n"), FrameCount);
+    }
+
+    FScopeLock Lock(&CacheMutex);
+    if (Caches.Num() > 0)
+    {
+        Out += TEXT("# HELP mcp_cache_lookups_total Cache lookups by result.\n");
+        Out += TEXT("# TYPE mcp_cache_lookups_total counter\n");
+        for (const TPair<FString, FMcpCacheCounters*>& Entry : Caches)
+        {
+            Out += FString::Printf(TEXT("mcp_cache_lookups_total{cache=\"%s\",result=\"hit\"} %llu\n"), *McpServerMetrics::EscapeLabel(Entry.Key), Entry.Value->Hits.load(std::memory_order_relaxed));
+            Out += FString::Printf(TEXT("mcp_cache_lookups_total{cache=\"%s\",result=\"miss\"} %llu\n"), *McpServerMetrics::EscapeLabel(Entry.Key), Entry.Value->Misses.load(std::memory_order_relaxed));
+        }
+
+        Out += TEXT("# HELP mcp_cache_rebuilds_total Full cache rebuilds.\n");
+        Out += TEXT("# TYPE mcp_cache_rebuilds_total counter\n");
+        for (const TPair<FString, FMcpCacheCounters*>& Entry : Caches)
+        {
+            Out += FString::Printf(TEXT("mcp_cache_rebuilds_total{cache=\"%s\"} %llu\n"), *McpServerMetrics::EscapeLabel(Entry.Key), Entry.Value->Rebuilds.load(std::memory_order_relaxed));
+        }
+    }
+
+    return Out;
+}
+
+const TCHAR* FMcpServerMetrics::GetStageName(EMcpLatencyStage Stage)
+{
+    switch (Stage)
+    {
+    case EMcpLatencyStage::QueueWait:
+        return TEXT("queue_wait");
+    case EMcpLatencyStage::GameThread:
+        return TEXT("game_thread");
+    case EMcpLatencyStage::Serialization:
+        return TEXT("serialization");
+    case EMcpLatencyStage::Total:
+        return TEXT("total");
+    default:
+        return TEXT("unknown");
+    }
+}
@@ -0,0 +1,302 @@
+#include "McpSymbolResolver.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintInspector.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "McpTrace.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Class.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectIterator.h"
+
+namespace McpSymbols
+{
+    static bool IsTransientClass(const UClass* Class)
+    {
+        return Class->HasAnyClassFlags(CLASS_NewerVersionExists | CLASS_Deprecated)
+            || Class->GetName().StartsWith(TEXT("SKEL_"))
+            || Class->GetName().StartsWith(TEXT("REINST_"))
+            || Class->GetName().StartsWith(TEXT("TRASH_"))
+            || FMcpBlueprintInspector::IsScratchObject(Class);
+    }
+
+    static bool IsFullPath(const FString& Name)
+    {
+        return Name.StartsWith(TEXT("/"));
+    }
+
+    // Accepts "Class.Function", "Class:Function" and "Class::Function".
+    static bool SplitQualifiedFunction(const FString& Name, FString& OutClass, FString& OutFunction)
+    {
+        int32 Index = Name.Find(TEXT("::"));
+        if (Index != INDEX_NONE)
+        {
+            OutClass = Name.Left(Index);
+            OutFunction = Name.Mid(Index + 2);
+            return true;
+        }
+
+        if (Name.FindLastChar(TEXT(':'), Index) || Name.FindLastChar(TEXT('.'), Index))
+        {
+            OutClass = Name.Left(Index);
+            OutFunction = Name.Mid(Index + 1);
+            return true;
+        }
+        return false;
+    }
+}
+
+FMcpSymbolResolver::FMcpSymbolResolver()
+{
+    ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([this](FName, EModuleChangeReason)
+    {
+        Invalidate();
+    });
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+    {
+        Invalidate();
+    });
+    FMcpServerMetrics::Get().RegisterCache(TEXT("symbols"), &Counters);
+}
+
+FMcpSymbolResolver::~FMcpSymbolResolver()
+{
+    FMcpServerMetrics::Get().UnregisterCache(&Counters);
+    FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+    if (GEditor && BlueprintCompiledHandle.IsValid())
+    {
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+    }
+}
+
+void FMcpSymbolResolver::RegisterEditorHooks()
+{
+    // GEditor may not exist yet when the server is constructed during module startup.
+    if (GEditor && !BlueprintCompiledHandle.IsValid())
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]()
+        {
+            Invalidate();
+        });
+    }
+}
+
+void FMcpSymbolResolver::EnsureIndex()
+{
+    if (!bIndexValid)
+    {
+        Counters.RecordRebuild();
+        BuildIndex();
+    }
+}
+
+void FMcpSymbolResolver::BuildIndex()
+{
+    MCP_TRACE_SCOPE("Mcp::Symbols::BuildIndex");
+
+    RegisterEditorHooks();
+    ClassesByName.Reset();
+    FunctionsByName.Reset();
+
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        UClass* Class = *It;
+        if (McpSymbols::IsTransientClass(Class))
+        {
+            continue;
+        }
+
+        const FString ShortName = Class->GetName().ToLower();
+        ClassesByName.FindOrAdd(ShortName).Add(Class);
+        if (Class->IsNative())
+        {
+            const FString PrefixedName = (FString(Class->GetPrefixCPP()) + Class->GetName()).ToLower();
+            if (PrefixedName != ShortName)
+            {
+                ClassesByName.FindOrAdd(PrefixedName).Add(Class);
+            }
+        }
+        else if (ShortName.EndsWith(TEXT("_c")))
+        {
+            ClassesByName.FindOrAdd(ShortName.LeftChop(2)).Add(Class);
+        }
+
+        for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+        {
+            UFunction* Function = *FuncIt;
+            if (Function->HasAnyFunctionFlags(FUNC_BlueprintCallable | FUNC_BlueprintEvent))
+            {
+                FunctionsByName.FindOrAdd(Function->GetName().ToLower()).Add(Function);
+            }
+        }
+    }
+
+    bIndexValid = true;
+}
+
+template <typename T>
+T* FMcpSymbolResolver::PickUnique(const TArray<TWeakObjectPtr<T>>* Matches, const FString& Name, FString& OutError, TArray<FString>* OutCandidates)
+{
+    TArray<T*> Alive;
+    if (Matches)
+    {
+        for (const TWeakObjectPtr<T>& Match : *Matches)
+        {
+            if (T* Object = Match.Get())
+            {
+                Alive.Add(Object);
+            }
+        }
+    }
+
+    if (Alive.Num() == 1)
+    {
+        return Alive[0];
+    }
+
+    if (Alive.Num() == 0)
+    {
+        OutError = FString::Printf(TEXT("'%s' not found."), *Name);
+        return nullptr;
+    }
+
+    OutError = FString::Printf(TEXT("'%s' is ambiguous (%d matches)."), *Name, Alive.Num());
+    if (OutCandidates)
+    {
+        for (const T* Object : Alive)
+        {
+            OutCandidates->Add(Object->GetPathName());
+        }
+    }
+    return nullptr;
+}
+
+UClass* FMcpSymbolResolver::ResolveClass(const FString& Name, FString& OutError, TArray<FString>* OutCandidates)
+{
+    MCP_TRACE_SCOPE("Mcp::Symbols::ResolveClass");
+
+    if (Name.IsEmpty())
+    {
+        OutError = TEXT("Class name is empty.");
+        return nullptr;
+    }
+
+    if (McpSymbols::IsFullPath(Name))
+    {
+        UClass* Class = FindObject<UClass>(nullptr, *Name);
+        if (!Class)
+        {
+            Class = LoadObject<UClass>(nullptr, *Name, nullptr, LOAD_NoWarn | LOAD_Quiet);
+        }
+        if (!Class)
+        {
+            OutError = FString::Printf(TEXT("Class '%s' not found."), *Name);
+        }
+        return Class;
+    }
+
+    EnsureIndex();
+
+    // Short-name lookups count as hits when they resolve to exactly one class, wherever it was found.
+    if (const TArray<TWeakObjectPtr<UClass>>* Matches = ClassesByName.Find(Name.ToLower()))
+    {
+        UClass* Class = PickUnique(Matches, Name, OutError, OutCandidates);
+        Counters.Record(Class != nullptr);
+        return Class;
+    }
+
+    // Blueprint classes that are not loaded yet are found through the asset registry.
+    TArray<FString> Candidates;
+    UClass* Loaded = LoadBlueprintClassByName(Name, Candidates);
+    Counters.Record(Loaded != nullptr);
+    if (!Loaded)
+    {
+        OutError = Candidates.Num() > 1
+            ? FString::Printf(TEXT("'%s' is ambiguous (%d matches)."), *Name, Candidates.Num())
+            : FString::Printf(TEXT("Class '%s' not found."), *Name);
+        if (OutCandidates)
+        {
+            OutCandidates->Append(Candidates);
+        }
+    }
+    return Loaded;
+}
+
+UClass* FMcpSymbolResolver::LoadBlueprintClassByName(const FString& ShortName, TArray<FString>& OutCandidates)
+{
+    const FString AssetName = ShortName.EndsWith(TEXT("_C")) ? ShortName.LeftChop(2) : ShortName;
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), Assets, /*bSearchSubClasses=*/true);
+
+    const FAssetData* Found = nullptr;
+    for (const FAssetData& Asset : Assets)
+    {
+        if (Asset.AssetName.ToString().Equals(AssetName, ESearchCase::IgnoreCase))
+        {
+            Found = &Asset;
+            OutCandidates.Add(Asset.GetObjectPathString());
+        }
+    }
+
+    if (OutCandidates.Num() != 1)
+    {
+        return nullptr;
+    }
+
+    UBlueprint* Blueprint = Cast<UBlueprint>(Found->GetAsset());
+    if (!Blueprint || !Blueprint->GeneratedClass)
+    {
+        return nullptr;
+    }
+
+    UClass* Class = Blueprint->GeneratedClass;
+    ClassesByName.FindOrAdd(ShortName.ToLower()).Add(Class);
+    return Class;
+}
+
+UFunction* FMcpSymbolResolver::ResolveFunction(const FString& Name, FString& OutError, TArray<FString>* OutCandidates)
+{
+    MCP_TRACE_SCOPE("Mcp::Symbols::ResolveFunction");
+
+    if (Name.IsEmpty())
+    {
+        OutError = TEXT("Function name is empty.");
+        return nullptr;
+    }
+
+    if (McpSymbols::IsFullPath(Name))
+    {
+        if (UFunction* Function = FindObject<UFunction>(nullptr, *Name))
+        {
+            return Function;
+        }
+    }
+
+    FString ClassName;
+    FString FunctionName;
+    if (McpSymbols::SplitQualifiedFunction(Name, ClassName, FunctionName))
+    {
+        UClass* Class = ResolveClass(ClassName, OutError, OutCandidates);
+        if (!Class)
+        {
+            return nullptr;
+        }
+
+        UFunction* Function = Class->FindFunctionByName(FName(*FunctionName));
+        if (!Function)
+        {
+            OutError = FString::Printf(TEXT("Function '%s' not found on '%s'."), *FunctionName, *Class->GetPathName());
+        }
+        return Function;
+    }
+
+    EnsureIndex();
+
+    UFunction* Function = PickUnique(FunctionsByName.Find(Name.ToLower()), Name, OutError, OutCandidates);
+    Counters.Record(Function != nullptr);
+    return Function;
+}
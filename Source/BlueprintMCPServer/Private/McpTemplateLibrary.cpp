@@ -0,0 +1,257 @@
+#include "McpTemplateLibrary.h"
+
+#include "BlueprintMutator.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "McpTrace.h"
+#include "UObject/Package.h"
+
+bool FMcpTemplateLibrary::Capture(const FString& Name, UBlueprint* Blueprint, const FName& GraphName, const TArray<FGuid>& NodeGuids, TArray<FMcpTemplateNodeInfo>& OutNodes, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Templates::Capture");
+
+    if (Name.IsEmpty())
+    {
+        OutError = TEXT("Template name is empty.");
+        return false;
+    }
+
+    UEdGraph* Graph = FMcpBlueprintMutator::FindGraph(Blueprint, GraphName);
+    if (!Graph)
+    {
+        OutError = TEXT("Graph not found.");
+        return false;
+    }
+
+    TSet<UObject*> NodesToExport;
+    for (const FGuid& NodeGuid : NodeGuids)
+    {
+        UEdGraphNode* Node = FMcpBlueprintMutator::FindNode(Graph, NodeGuid);
+        if (!Node)
+        {
+            OutError = FString::Printf(TEXT("Node %s not found."), *NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+            return false;
+        }
+        if (!Node->CanDuplicateNode())
+        {
+            OutError = FString::Printf(TEXT("Node %s cannot be duplicated."), *NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+            return false;
+        }
+        NodesToExport.Add(Node);
+    }
+
+    if (NodesToExport.Num() == 0)
+    {
+        OutError = TEXT("No nodes to capture.");
+        return false;
+    }
+
+    FString ExportedText;
+    FEdGraphUtilities::ExportNodesToText(NodesToExport, ExportedText);
+
+    // The prototype is registered as an ubergraph page so event nodes import; whether a node fits
+    // the target graph is checked when the template is instantiated.
+    UBlueprint* Scratch = GetScratchBlueprint();
+    UEdGraph* Prototype = FBlueprintEditorUtils::CreateNewGraph(
+        Scratch,
+        MakeUniqueObjectName(Scratch, UEdGraph::StaticClass(), FName(*FString::Printf(TEXT("Template_%s"), *Name))),
+        UEdGraph::StaticClass(),
+        UEdGraphSchema_K2::StaticClass());
+    Scratch->UbergraphPages.Add(Prototype);
+
+    if (!FEdGraphUtilities::CanImportNodesFromText(Prototype, ExportedText))
+    {
+        OutError = TEXT("Captured nodes cannot be imported into an event graph.");
+        DiscardPrototype(Prototype);
+        return false;
+    }
+
+    TSet<UEdGraphNode*> Imported;
+    FEdGraphUtilities::ImportNodesFromText(Prototype, ExportedText, Imported);
+    if (Imported.Num() != NodesToExport.Num() || Prototype->Nodes.Num() != NodesToExport.Num())
+    {
+        OutError = FString::Printf(TEXT("Only %d of %d captured nodes could be imported."), Imported.Num(), NodesToExport.Num());
+        DiscardPrototype(Prototype);
+        return false;
+    }
+
+    FTemplate Template;
+    Template.Prototype = Prototype;
+    Template.Origin = FIntPoint(MAX_int32, MAX_int32);
+    for (UEdGraphNode* Node : Prototype->Nodes)
+    {
+        FMcpTemplateNodeInfo& Info = Template.Nodes.AddDefaulted_GetRef();
+        Info.Key = Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens);
+        Info.Class = Node->GetClass()->GetName();
+        Info.Title = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+        Template.Origin.X = FMath::Min(Template.Origin.X, Node->NodePosX);
+        Template.Origin.Y = FMath::Min(Template.Origin.Y, Node->NodePosY);
+    }
+
+    if (FTemplate* Existing = Templates.Find(Name))
+    {
+        DiscardPrototype(Existing->Prototype);
+    }
+
+    OutNodes = Template.Nodes;
+    Templates.Add(Name, MoveTemp(Template));
+    return true;
+}
+
+bool FMcpTemplateLibrary::Instantiate(const FString& Name, UBlueprint* Blueprint, const FName& GraphName, const FVector2D& Location,
+    const TMap<FString, TMap<FString, FString>>& PinOverrides, TMap<FString, FGuid>& OutNodeGuids, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Templates::Instantiate");
+
+    const FTemplate* Template = Templates.Find(Name);
+    if (!Template)
+    {
+        OutError = FString::Printf(TEXT("Template '%s' not found."), *Name);
+        return false;
+    }
+
+    UEdGraph* TargetGraph = FMcpBlueprintMutator::FindGraph(Blueprint, GraphName);
+    if (!TargetGraph)
+    {
+        OutError = TEXT("Graph not found.");
+        return false;
+    }
+
+    for (const UEdGraphNode* Node : Template->Prototype->Nodes)
+    {
+        if (Node && !Node->CanPasteHere(TargetGraph))
+        {
+            OutError = FString::Printf(TEXT("Node '%s' of template '%s' cannot be placed in graph '%s'."),
+                *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *Name, *GraphName.ToString());
+            return false;
+        }
+    }
+
+    // Overrides are checked against the prototype so a typo or bad value fails before anything is pasted.
+    const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+    for (const TPair<FString, TMap<FString, FString>>& NodeOverrides : PinOverrides)
+    {
+        UEdGraphNode* const* Found = Template->Prototype->Nodes.FindByPredicate([&NodeOverrides](const UEdGraphNode* Node)
+        {
+            return Node && Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens) == NodeOverrides.Key;
+        });
+        if (!Found)
+        {
+            OutError = FString::Printf(TEXT("Node '%s' not found in template '%s'."), *NodeOverrides.Key, *Name);
+            return false;
+        }
+
+        for (const TPair<FString, FString>& Override : NodeOverrides.Value)
+        {
+            const UEdGraphPin* Pin = FMcpBlueprintMutator::FindPin(*Found, Override.Key);
+            if (!Pin)
+            {
+                OutError = FString::Printf(TEXT("Pin '%s' not found on node '%s'."), *Override.Key, *NodeOverrides.Key);
+                return false;
+            }
+
+            FString DefaultValue;
+            TObjectPtr<UObject> DefaultObject = nullptr;
+            FText DefaultText;
+            Schema->GetPinDefaultValuesFromString(Pin->PinType, *Found, Override.Value, DefaultValue, DefaultObject, DefaultText);
+            const FString DefaultError = Schema->IsPinDefaultValid(Pin, DefaultValue, DefaultObject, DefaultText);
+            if (!DefaultError.IsEmpty())
+            {
+                OutError = FString::Printf(TEXT("Value '%s' is not valid for pin '%s' on node '%s': %s"), *Override.Value, *Override.Key, *NodeOverrides.Key, *DefaultError);
+                return false;
+            }
+        }
+    }
+
+    // Duplicating the whole prototype keeps the links between its nodes; the nodes are then moved into the target.
+    UEdGraph* Copy = DuplicateObject<UEdGraph>(Template->Prototype, GetTransientPackage());
+    const FIntPoint Offset((int32)Location.X - Template->Origin.X, (int32)Location.Y - Template->Origin.Y);
+
+    TSet<UEdGraphNode*> Spawned;
+    for (UEdGraphNode* Node : Copy->Nodes)
+    {
+        if (!Node)
+        {
+            continue;
+        }
+
+        const FName UniqueName = MakeUniqueObjectName(TargetGraph, Node->GetClass(), Node->GetClass()->GetFName());
+        Node->Rename(*UniqueName.ToString(), TargetGraph, REN_DontCreateRedirectors | REN_NonTransactional);
+        TargetGraph->AddNode(Node, /*bFromUI=*/false, /*bSelectNewNode=*/false);
+        Spawned.Add(Node);
+    }
+    Copy->Nodes.Reset();
+    Copy->MarkAsGarbage();
+
+    FEdGraphUtilities::PostProcessPastedNodes(Spawned);
+
+    for (UEdGraphNode* Node : Spawned)
+    {
+        const FString Key = Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens);
+        Node->CreateNewGuid();
+        Node->NodePosX += Offset.X;
+        Node->NodePosY += Offset.Y;
+        OutNodeGuids.Add(Key, Node->NodeGuid);
+
+        if (const TMap<FString, FString>* Overrides = PinOverrides.Find(Key))
+        {
+            for (const TPair<FString, FString>& Override : *Overrides)
+            {
+                if (UEdGraphPin* Pin = FMcpBlueprintMutator::FindPin(Node, Override.Key))
+                {
+                    Schema->TrySetDefaultValue(*Pin, Override.Value);
+                }
+            }
+        }
+    }
+
+    FMcpBlueprintMutator::MarkStructurallyModified(Blueprint);
+    return true;
+}
+
+TArray<FString> FMcpTemplateLibrary::GetTemplateNames() const
+{
+    TArray<FString> Names;
+    Templates.GetKeys(Names);
+    return Names;
+}
+
+void FMcpTemplateLibrary::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObject(ScratchBlueprint);
+    for (TPair<FString, FTemplate>& Pair : Templates)
+    {
+        Collector.AddReferencedObject(Pair.Value.Prototype);
+    }
+}
+
+void FMcpTemplateLibrary::DiscardPrototype(UEdGraph* Prototype)
+{
+    if (ScratchBlueprint)
+    {
+        ScratchBlueprint->UbergraphPages.Remove(Prototype);
+    }
+    Prototype->MarkAsGarbage();
+}
+
+UBlueprint* FMcpTemplateLibrary::GetScratchBlueprint()
+{
+    if (!ScratchBlueprint)
+    {
+        ScratchBlueprint = FKismetEditorUtilities::CreateBlueprint(
+            AActor::StaticClass(),
+            GetTransientPackage(),
+            MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("McpTemplateScratch")),
+            BPTYPE_Normal,
+            UBlueprint::StaticClass(),
+            UBlueprintGeneratedClass::StaticClass());
+    }
+    return ScratchBlueprint;
+}
@@ -0,0 +1,146 @@
+#include "McpTimeSlicer.h"
+
+#include "Editor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Json.h"
+#include "McpTrace.h"
+
+namespace McpTimeSlicer
+{
+    static float BudgetMs = 4.0f;
+    static FAutoConsoleVariableRef CVarBudgetMs(
+        TEXT("Mcp.TimeSlice.BudgetMs"),
+        BudgetMs,
+        TEXT("Game-thread milliseconds per frame for sliced MCP work such as get_blueprint_structure. 0 runs it in one go."));
+
+    // Fractions of the budget used while a PIE session runs or the user is typing or dragging.
+    static constexpr double PlayInEditorScale = 0.25;
+    static constexpr double UserActiveScale = 0.5;
+    static constexpr double UserIdleSeconds = 0.5;
+
+    static bool IsUserActive()
+    {
+        if (!FSlateApplication::IsInitialized())
+        {
+            return false;
+        }
+        const FSlateApplication& Slate = FSlateApplication::Get();
+        return Slate.GetCurrentTime() - Slate.GetLastUserInteractionTime() < UserIdleSeconds;
+    }
+}
+
+FMcpTimeSlicer::~FMcpTimeSlicer()
+{
+    CancelAll();
+}
+
+bool FMcpTimeSlicer::IsEnabled()
+{
+    return McpTimeSlicer::BudgetMs > 0.0f && !IsRunningCommandlet();
+}
+
+double FMcpTimeSlicer::GetFrameBudgetSeconds()
+{
+    double Budget = McpTimeSlicer::BudgetMs / 1000.0;
+    if (GEditor && GEditor->IsPlaySessionInProgress())
+    {
+        Budget *= McpTimeSlicer::PlayInEditorScale;
+    }
+    else if (McpTimeSlicer::IsUserActive())
+    {
+        Budget *= McpTimeSlicer::UserActiveScale;
+    }
+    return Budget;
+}
+
+void FMcpTimeSlicer::Add(FStepFunction&& Step, FDoneFunction&& OnDone)
+{
+    check(IsInGameThread());
+
+    Jobs.Add({ MoveTemp(Step), MoveTemp(OnDone) });
+    ActiveJobs = Jobs.Num();
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMcpTimeSlicer::Tick));
+    }
+}
+
+void FMcpTimeSlicer::CancelAll()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    TArray<FJob> Cancelled = MoveTemp(Jobs);
+    Jobs.Reset();
+    NextJob = 0;
+    ActiveJobs = 0;
+    for (FJob& Job : Cancelled)
+    {
+        Job.OnDone(false);
+    }
+}
+
+bool FMcpTimeSlicer::Tick(float DeltaTime)
+{
+    MCP_TRACE_SCOPE("Mcp::TimeSlice::Tick");
+
+    if (Jobs.Num() == 0)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    const double Budget = GetFrameBudgetSeconds();
+    const double Deadline = FPlatformTime::Seconds() + Budget;
+    LastBudgetMs = Budget * 1000.0;
+
+    // Round-robin so one huge job cannot starve the rest; every tick advances at least one job.
+    do
+    {
+        NextJob = NextJob % Jobs.Num();
+        FJob& Job = Jobs[NextJob];
+        ++TotalSlices;
+
+        bool bFinished = false;
+        {
+            MCP_TRACE_SCOPE("Mcp::TimeSlice::Step");
+            bFinished = Job.Step(Deadline);
+        }
+        if (bFinished)
+        {
+            FDoneFunction OnDone = MoveTemp(Job.OnDone);
+            Jobs.RemoveAt(NextJob);
+            ActiveJobs = Jobs.Num();
+            ++CompletedJobs;
+            OnDone(true);
+        }
+        else
+        {
+            ++NextJob;
+        }
+    }
+    while (Jobs.Num() > 0 && FPlatformTime::Seconds() < Deadline);
+
+    if (Jobs.Num() == 0)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+TSharedRef<FJsonObject> FMcpTimeSlicer::BuildStatsJson() const
+{
+    TSharedRef<FJsonObject> StatsObj = MakeShared<FJsonObject>();
+    StatsObj->SetBoolField(TEXT("enabled"), IsEnabled());
+    StatsObj->SetNumberField(TEXT("budget_ms"), McpTimeSlicer::BudgetMs);
+    StatsObj->SetNumberField(TEXT("last_budget_ms"), LastBudgetMs.load());
+    StatsObj->SetNumberField(TEXT("active_jobs"), ActiveJobs.load());
+    StatsObj->SetNumberField(TEXT("completed_jobs"), (double)CompletedJobs.load());
+    StatsObj->SetNumberField(TEXT("slices"), (double)TotalSlices.load());
+    return StatsObj;
+}
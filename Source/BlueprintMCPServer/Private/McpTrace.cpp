@@ -0,0 +1,38 @@
+#include "McpTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(McpChannel);
+LLM_DEFINE_TAG(BlueprintMCP);
+
+UE_TRACE_EVENT_BEGIN(BlueprintMCP, RequestBegin)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(int64, RequestBytes)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Action)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, AssetPath)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(BlueprintMCP, RequestEnd)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(int64, ResponseBytes)
+    UE_TRACE_EVENT_FIELD(double, TotalSeconds)
+    UE_TRACE_EVENT_FIELD(bool, Success)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Action)
+UE_TRACE_EVENT_END()
+
+void FMcpTrace::RequestBegin(const FString& Action, const FString& AssetPath, int64 RequestBytes)
+{
+    UE_TRACE_LOG(BlueprintMCP, RequestBegin, McpChannel)
+        << RequestBegin.Cycle(FPlatformTime::Cycles64())
+        << RequestBegin.RequestBytes(RequestBytes)
+        << RequestBegin.Action(*Action, Action.Len())
+        << RequestBegin.AssetPath(*AssetPath, AssetPath.Len());
+}
+
+void FMcpTrace::RequestEnd(const FString& Action, bool bSuccess, int64 ResponseBytes, double TotalSeconds)
+{
+    UE_TRACE_LOG(BlueprintMCP, RequestEnd, McpChannel)
+        << RequestEnd.Cycle(FPlatformTime::Cycles64())
+        << RequestEnd.ResponseBytes(ResponseBytes)
+        << RequestEnd.TotalSeconds(TotalSeconds)
+        << RequestEnd.Success(bSuccess)
+        << RequestEnd.Action(*Action, Action.Len());
+}
@@ -0,0 +1,689 @@
+#include "McpUnixSocketTransport.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
+#include "Json.h"
+#include "McpServer.h"
+#include "McpServerMetrics.h"
+#include "McpTrace.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define MCP_WITH_UNIX_SOCKETS 1
+#else
+#define MCP_WITH_UNIX_SOCKETS 0
+#endif
+
+namespace McpUnixSocket
+{
+    static constexpr int32 MaxHeaderBytes = 64 * 1024;
+    static constexpr int32 MaxBodyBytes = 16 * 1024 * 1024;
+    // Room for one complete request (headers, blank line, body); reading pauses at this size until it is taken.
+    static constexpr int32 MaxBufferedBytes = MaxHeaderBytes + 4 + MaxBodyBytes;
+    static constexpr int32 ReadChunkBytes = 64 * 1024;
+    static constexpr int32 PollTimeoutMs = 500;
+
+    static FString DefaultPath;
+    static FAutoConsoleVariableRef CVarDefaultPath(
+        TEXT("Mcp.UnixSocket.Path"),
+        DefaultPath,
+        TEXT("Unix domain socket path for local MCP clients. Empty disables the listener. Takes effect when the server starts."));
+
+    static const TCHAR* GetStatusText(int32 Status)
+    {
+        switch (Status)
+        {
+        case 200:
+            return TEXT("OK");
+        case 400:
+            return TEXT("Bad Request");
+        case 404:
+            return TEXT("Not Found");
+        case 413:
+            return TEXT("Payload Too Large");
+        case 429:
+            return TEXT("Too Many Requests");
+        default:
+            return TEXT("Service Unavailable");
+        }
+    }
+
+    using FBodyWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+    // Framed replies carry ok/status in the body because there is no status line to hold them.
+    static FString MakeErrorBody(const FString& Error, int32 RetryAfterSeconds, bool bFramed, int32 Status)
+    {
+        FString Text;
+        TSharedRef<FBodyWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+        Writer->WriteObjectStart();
+        if (bFramed)
+        {
+            Writer->WriteValue(TEXT("ok"), false);
+            Writer->WriteValue(TEXT("status"), Status);
+        }
+        Writer->WriteValue(TEXT("error"), Error);
+        if (RetryAfterSeconds > 0)
+        {
+            Writer->WriteValue(TEXT("retry_after"), RetryAfterSeconds);
+        }
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return Text;
+    }
+
+    // The action's response is already serialized, so it is spliced in rather than parsed again.
+    static FString MakeResultFrameBody(const FString& ResultJson)
+    {
+        FString Text;
+        TSharedRef<FBodyWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("ok"), true);
+        Writer->WriteRawJSONValue(TEXT("result"), ResultJson);
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return Text;
+    }
+
+    static void AppendUtf8(TArray<uint8>& Out, const FString& Text)
+    {
+        const FTCHARToUTF8 Utf8(*Text, Text.Len());
+        Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+}
+
+FMcpUnixSocketTransport::FMcpUnixSocketTransport(TWeakPtr<FMcpServer> InServer)
+    : ServerWeak(MoveTemp(InServer))
+{
+}
+
+FMcpUnixSocketTransport::~FMcpUnixSocketTransport()
+{
+    Shutdown();
+}
+
+bool FMcpUnixSocketTransport::IsSupported()
+{
+    return MCP_WITH_UNIX_SOCKETS != 0;
+}
+
+FString FMcpUnixSocketTransport::GetDefaultPath()
+{
+    return McpUnixSocket::DefaultPath;
+}
+
+bool FMcpUnixSocketTransport::Start(const FString& InPath, FString& OutError)
+{
+#if MCP_WITH_UNIX_SOCKETS
+    if (Thread)
+    {
+        OutError = TEXT("Unix socket listener already running.");
+        return false;
+    }
+
+    const FTCHARToUTF8 PathUtf8(*InPath);
+    sockaddr_un Address = {};
+    Address.sun_family = AF_UNIX;
+    if (InPath.IsEmpty() || PathUtf8.Length() >= (int32)sizeof(Address.sun_path))
+    {
+        OutError = FString::Printf(TEXT("Invalid Unix socket path '%s'."), *InPath);
+        return false;
+    }
+    FMemory::Memcpy(Address.sun_path, PathUtf8.Get(), PathUtf8.Length());
+
+    // A socket file left behind by a crashed editor would make bind fail; anything else at the path is kept.
+    struct stat Existing;
+    if (lstat(PathUtf8.Get(), &Existing) == 0)
+    {
+        if (!S_ISSOCK(Existing.st_mode))
+        {
+            OutError = FString::Printf(TEXT("'%s' exists and is not a socket."), *InPath);
+            return false;
+        }
+        unlink(PathUtf8.Get());
+    }
+
+    ListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool bBound = false;
+    if (ListenFd >= 0)
+    {
+        // The file is created owner-only; a chmod after bind would leave a window where anyone could connect.
+        const mode_t PreviousMask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+        bBound = bind(ListenFd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) == 0;
+        umask(PreviousMask);
+    }
+
+    if (!bBound
+        || listen(ListenFd, 64) != 0
+        || fcntl(ListenFd, F_SETFL, O_NONBLOCK) != 0
+        || pipe(WakeFds) != 0)
+    {
+        OutError = FString::Printf(TEXT("Failed to listen on Unix socket '%s' (errno %d)."), *InPath, errno);
+        SocketPath = InPath;
+        Shutdown();
+        return false;
+    }
+
+    fcntl(WakeFds[0], F_SETFL, O_NONBLOCK);
+    fcntl(WakeFds[1], F_SETFL, O_NONBLOCK);
+
+    SocketPath = InPath;
+    bStopping = false;
+    Thread = FRunnableThread::Create(this, TEXT("McpUnixSocket"), 0, TPri_AboveNormal);
+    if (!Thread)
+    {
+        OutError = TEXT("Failed to create Unix socket thread.");
+        Shutdown();
+        return false;
+    }
+    return true;
+#else
+    OutError = TEXT("Unix domain sockets are not supported on this platform.");
+    return false;
+#endif
+}
+
+void FMcpUnixSocketTransport::Shutdown()
+{
+#if MCP_WITH_UNIX_SOCKETS
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    for (FConnection& Connection : Connections)
+    {
+        CloseConnection(Connection);
+    }
+    Connections.Reset();
+    Outgoing.Empty();
+
+    auto CloseFd = [](int32& Fd)
+    {
+        if (Fd >= 0)
+        {
+            close(Fd);
+            Fd = -1;
+        }
+    };
+    CloseFd(ListenFd);
+    CloseFd(WakeFds[0]);
+    CloseFd(WakeFds[1]);
+
+    if (!SocketPath.IsEmpty())
+    {
+        unlink(TCHAR_TO_UTF8(*SocketPath));
+        SocketPath.Reset();
+    }
+#endif
+}
+
+void FMcpUnixSocketTransport::Stop()
+{
+    bStopping = true;
+    Wake();
+}
+
+uint32 FMcpUnixSocketTransport::Run()
+{
+#if MCP_WITH_UNIX_SOCKETS
+    TArray<pollfd> PollFds;
+    while (!bStopping)
+    {
+        PollFds.Reset();
+        PollFds.Add({ WakeFds[0], POLLIN, 0 });
+        PollFds.Add({ ListenFd, POLLIN, 0 });
+        for (const FConnection& Connection : Connections)
+        {
+            // A full buffer or a finished peer is not read from; poll skips entries with a negative fd.
+            const bool bRead = !Connection.bPeerClosed && Connection.In.Num() < McpUnixSocket::MaxBufferedBytes;
+            const short Events = (short)((bRead ? POLLIN : 0) | (Connection.Out.Num() > 0 ? POLLOUT : 0));
+            PollFds.Add({ Events != 0 ? Connection.Fd : -1, Events, 0 });
+        }
+
+        if (poll(PollFds.GetData(), PollFds.Num(), McpUnixSocket::PollTimeoutMs) < 0 && errno != EINTR)
+        {
+            break;
+        }
+
+        MCP_TRACE_SCOPE("Mcp::UnixSocket::Poll");
+
+        if (PollFds[0].revents & POLLIN)
+        {
+            uint8 Drain[64];
+            while (read(WakeFds[0], Drain, sizeof(Drain)) > 0)
+            {
+            }
+        }
+        DrainOutgoing();
+
+        // Connections accepted now are polled from the next iteration on.
+        const int32 NumPolled = PollFds.Num() - 2;
+        for (int32 Index = 0; Index < NumPolled; ++Index)
+        {
+            FConnection& Connection = Connections[Index];
+            const short Events = PollFds[Index + 2].revents;
+            if (Events & (POLLIN | POLLHUP | POLLERR))
+            {
+                ReadConnection(Connection);
+            }
+            if (!Connection.bClosed && (Events & POLLOUT))
+            {
+                WriteConnection(Connection);
+            }
+        }
+
+        for (FConnection& Connection : Connections)
+        {
+            if (!Connection.bClosed)
+            {
+                ProcessInput(Connection);
+                if (Connection.Out.Num() > 0)
+                {
+                    WriteConnection(Connection);
+                }
+
+                // Once the peer is done sending, close after the last complete request it sent is answered.
+                if (!Connection.bClosed && Connection.bPeerClosed && !Connection.bInFlight && Connection.Out.Num() == 0)
+                {
+                    CloseConnection(Connection);
+                }
+            }
+        }
+
+        if (PollFds[1].revents & POLLIN)
+        {
+            AcceptConnections();
+        }
+
+        Connections.RemoveAll([](const FConnection& Connection)
+        {
+            return Connection.bClosed;
+        });
+    }
+#endif
+    return 0;
+}
+
+void FMcpUnixSocketTransport::AcceptConnections()
+{
+#if MCP_WITH_UNIX_SOCKETS
+    for (;;)
+    {
+        const int32 Fd = accept(ListenFd, nullptr, nullptr);
+        if (Fd < 0)
+        {
+            return;
+        }
+        fcntl(Fd, F_SETFL, O_NONBLOCK);
+        fcntl(Fd, F_SETFD, FD_CLOEXEC);
+
+        FConnection& Connection = Connections.AddDefaulted_GetRef();
+        Connection.Fd = Fd;
+        Connection.Id = NextConnectionId++;
+    }
+#endif
+}
+
+void FMcpUnixSocketTransport::ReadConnection(FConnection& Connection)
+{
+#if MCP_WITH_UNIX_SOCKETS
+    while (!Connection.bPeerClosed)
+    {
+        // Requests are taken one at a time, so a client pipelining while one is in flight is held back here.
+        const int32 Offset = Connection.In.Num();
+        const int32 ChunkBytes = FMath::Min(McpUnixSocket::ReadChunkBytes, McpUnixSocket::MaxBufferedBytes - Offset);
+        if (ChunkBytes <= 0)
+        {
+            return;
+        }
+
+        Connection.In.AddUninitialized(ChunkBytes);
+        const ssize_t Read = read(Connection.Fd, Connection.In.GetData() + Offset, ChunkBytes);
+        Connection.In.SetNum(Offset + FMath::Max<ssize_t>(Read, 0), EAllowShrinking::No);
+
+        if (Read > 0)
+        {
+            continue;
+        }
+        if (Read == 0)
+        {
+            // End of input: what was already received is still processed.
+            Connection.bPeerClosed = true;
+            return;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return;
+        }
+
+        // The connection failed; a response still being computed is dropped when it arrives.
+        CloseConnection(Connection);
+        return;
+    }
+#endif
+}
+
+void FMcpUnixSocketTransport::WriteConnection(FConnection& Connection)
+{
+#if MCP_WITH_UNIX_SOCKETS
+    while (Connection.Out.Num() > 0)
+    {
+        const ssize_t Written = send(Connection.Fd, Connection.Out.GetData(), Connection.Out.Num(), MSG_NOSIGNAL);
+        if (Written < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                CloseConnection(Connection);
+            }
+            return;
+        }
+        Connection.Out.RemoveAt(0, Written, EAllowShrinking::No);
+    }
+
+    if (Connection.bCloseAfterWrite && !Connection.bInFlight)
+    {
+        CloseConnection(Connection);
+    }
+#endif
+}
+
+void FMcpUnixSocketTransport::ProcessInput(FConnection& Connection)
+{
+    if (Connection.bInFlight || Connection.bCloseAfterWrite || Connection.In.Num() == 0)
+    {
+        return;
+    }
+
+    if (Connection.Protocol == EProtocol::Unknown)
+    {
+        // Frames start with the high byte of a length below 16 MiB; HTTP starts with a method name.
+        Connection.Protocol = FChar::IsAlpha((TCHAR)Connection.In[0]) ? EProtocol::Http : EProtocol::Framed;
+    }
+
+    if (Connection.Protocol == EProtocol::Http)
+    {
+        TakeHttpRequest(Connection);
+    }
+    else
+    {
+        TakeFrame(Connection);
+    }
+}
+
+bool FMcpUnixSocketTransport::TakeHttpRequest(FConnection& Connection)
+{
+    static const uint8 HeaderEnd[] = { '\r', '\n', '\r', '\n' };
+
+    int32 HeaderLength = INDEX_NONE;
+    for (int32 Index = 0; Index + 4 <= Connection.In.Num(); ++Index)
+    {
+        if (FMemory::Memcmp(Connection.In.GetData() + Index, HeaderEnd, 4) == 0)
+        {
+            HeaderLength = Index;
+            break;
+        }
+    }
+
+    if (HeaderLength == INDEX_NONE || HeaderLength > McpUnixSocket::MaxHeaderBytes)
+    {
+        if (HeaderLength != INDEX_NONE || Connection.In.Num() > McpUnixSocket::MaxHeaderBytes)
+        {
+            Connection.bInFlight = true;
+            Respond(Connection.Id, EProtocol::Http, 413, TEXT("Headers too large"), 0, /*bClose=*/true);
+        }
+        return false;
+    }
+
+    const FUTF8ToTCHAR HeaderConverter(reinterpret_cast<const ANSICHAR*>(Connection.In.GetData()), HeaderLength);
+    TArray<FString> Lines;
+    FString(HeaderConverter.Length(), HeaderConverter.Get()).ParseIntoArray(Lines, TEXT("\r\n"));
+
+    TArray<FString> RequestLine;
+    if (Lines.Num() > 0)
+    {
+        Lines[0].ParseIntoArrayWS(RequestLine);
+    }
+
+    int64 ContentLength = 0;
+    FString ClientKey;
+    FString SessionId;
+    bool bClose = RequestLine.Num() < 3 || RequestLine[2] == TEXT("HTTP/1.0");
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        FString Name;
+        FString Value;
+        if (!Lines[LineIndex].Split(TEXT(":"), &Name, &Value))
+        {
+            continue;
+        }
+        Name.TrimStartAndEndInline();
+        Value.TrimStartAndEndInline();
+
+        if (Name.Equals(TEXT("Content-Length"), ESearchCase::IgnoreCase))
+        {
+            LexFromString(ContentLength, *Value);
+        }
+        else if (Name.Equals(TEXT("X-MCP-Client"), ESearchCase::IgnoreCase))
+        {
+            ClientKey = Value;
+        }
+        else if (Name.Equals(TEXT("Mcp-Session-Id"), ESearchCase::IgnoreCase))
+        {
+            SessionId = Value;
+        }
+        else if (Name.Equals(TEXT("Connection"), ESearchCase::IgnoreCase))
+        {
+            bClose = Value.Equals(TEXT("close"), ESearchCase::IgnoreCase);
+        }
+    }
+
+    if (ContentLength < 0 || ContentLength > McpUnixSocket::MaxBodyBytes)
+    {
+        Connection.bInFlight = true;
+        Respond(Connection.Id, EProtocol::Http, 413, TEXT("Body too large"), 0, /*bClose=*/true);
+        return false;
+    }
+
+    const int32 RequestLength = HeaderLength + 4 + (int32)ContentLength;
+    if (Connection.In.Num() < RequestLength)
+    {
+        return false;
+    }
+
+    TArray<uint8> Body(Connection.In.GetData() + HeaderLength + 4, (int32)ContentLength);
+    Connection.In.RemoveAt(0, RequestLength, EAllowShrinking::No);
+    Connection.bCloseAfterWrite = bClose;
+
+    if (RequestLine.Num() < 2 || RequestLine[0] != TEXT("POST") || RequestLine[1] != TEXT("/mcp"))
+    {
+        Connection.bInFlight = true;
+        Respond(Connection.Id, EProtocol::Http, 404, TEXT("Not found"), 0, bClose);
+        return true;
+    }
+
+    Submit(Connection, MoveTemp(Body), ClientKey.IsEmpty() && !SessionId.IsEmpty() ? TEXT("session:") + SessionId : ClientKey);
+    return true;
+}
+
+bool FMcpUnixSocketTransport::TakeFrame(FConnection& Connection)
+{
+    if (Connection.In.Num() < 4)
+    {
+        return false;
+    }
+
+    const uint8* Header = Connection.In.GetData();
+    const uint32 Length = ((uint32)Header[0] << 24) | ((uint32)Header[1] << 16) | ((uint32)Header[2] << 8) | (uint32)Header[3];
+    if (Length > (uint32)McpUnixSocket::MaxBodyBytes)
+    {
+        Connection.bInFlight = true;
+        Respond(Connection.Id, EProtocol::Framed, 413, TEXT("Frame too large"), 0, /*bClose=*/true);
+        return false;
+    }
+
+    if (Connection.In.Num() < 4 + (int32)Length)
+    {
+        return false;
+    }
+
+    TArray<uint8> Body(Connection.In.GetData() + 4, (int32)Length);
+    Connection.In.RemoveAt(0, 4 + (int32)Length, EAllowShrinking::No);
+    Submit(Connection, MoveTemp(Body), FString());
+    return true;
+}
+
+void FMcpUnixSocketTransport::Submit(FConnection& Connection, TArray<uint8>&& Body, const FString& ClientKey)
+{
+    MCP_TRACE_SCOPE("Mcp::UnixSocket::Submit");
+
+    Connection.bInFlight = true;
+    const uint32 ConnectionId = Connection.Id;
+    const EProtocol Protocol = Connection.Protocol;
+    const bool bClose = Connection.bCloseAfterWrite;
+
+    TSharedPtr<FMcpServer> Server = ServerWeak.Pin();
+    if (!Server.IsValid())
+    {
+        Respond(ConnectionId, Protocol, 503, TEXT("Server stopped."), 0, /*bClose=*/true);
+        return;
+    }
+
+    FMcpRequestTiming Timing;
+    Timing.StartTime = FPlatformTime::Seconds();
+    Timing.Transport = TEXT("uds");
+    Timing.Client = FString::Printf(TEXT("uds:%u"), ConnectionId);
+
+    TWeakPtr<FMcpUnixSocketTransport, ESPMode::ThreadSafe> SelfWeak = AsShared();
+    FString ParseError;
+    int32 RetryAfterSeconds = 0;
+    const EMcpSubmitResult Result = Server->SubmitRequest(Body, ClientKey, Timing,
+        [SelfWeak, ConnectionId, Protocol, bClose](bool bOk, const FString& Response, const FString& Error)
+        {
+            if (TSharedPtr<FMcpUnixSocketTransport, ESPMode::ThreadSafe> Self = SelfWeak.Pin())
+            {
+                Self->Respond(ConnectionId, Protocol, bOk ? 200 : 400, bOk ? Response : Error, 0, bClose);
+            }
+        },
+        ParseError, RetryAfterSeconds);
+
+    if (Result == EMcpSubmitResult::BadRequest)
+    {
+        Respond(ConnectionId, Protocol, 400, ParseError, 0, bClose);
+    }
+    else if (Result == EMcpSubmitResult::Busy)
+    {
+        Respond(ConnectionId, Protocol, 429, TEXT("Server busy"), RetryAfterSeconds, bClose);
+    }
+    else if (Result == EMcpSubmitResult::Warming)
+    {
+        Respond(ConnectionId, Protocol, 503, ParseError, RetryAfterSeconds, bClose);
+    }
+}
+
+void FMcpUnixSocketTransport::Respond(uint32 ConnectionId, EProtocol Protocol, int32 Status, const FString& Body, int32 RetryAfterSeconds, bool bClose)
+{
+    FOutgoing Response;
+    Response.ConnectionId = ConnectionId;
+    Response.bClose = bClose;
+    if (Protocol == EProtocol::Http)
+    {
+        Response.Bytes = MakeHttpResponse(Status, Status == 200 ? Body : McpUnixSocket::MakeErrorBody(Body, RetryAfterSeconds, /*bFramed=*/false, Status), RetryAfterSeconds, bClose);
+    }
+    else
+    {
+        Response.Bytes = MakeFrame(Status == 200
+            ? McpUnixSocket::MakeResultFrameBody(Body)
+            : McpUnixSocket::MakeErrorBody(Body, RetryAfterSeconds, /*bFramed=*/true, Status));
+    }
+
+    Outgoing.Enqueue(MoveTemp(Response));
+    Wake();
+}
+
+void FMcpUnixSocketTransport::DrainOutgoing()
+{
+    FOutgoing Response;
+    while (Outgoing.Dequeue(Response))
+    {
+        FConnection* Connection = Connections.FindByPredicate([&Response](const FConnection& Candidate)
+        {
+            return Candidate.Id == Response.ConnectionId;
+        });
+        if (!Connection || Connection->bClosed)
+        {
+            continue;
+        }
+
+        Connection->Out.Append(MoveTemp(Response.Bytes));
+        Connection->bInFlight = false;
+        Connection->bCloseAfterWrite |= Response.bClose;
+    }
+}
+
+void FMcpUnixSocketTransport::CloseConnection(FConnection& Connection)
+{
+#if MCP_WITH_UNIX_SOCKETS
+    if (Connection.Fd >= 0)
+    {
+        close(Connection.Fd);
+        Connection.Fd = -1;
+    }
+#endif
+    Connection.bClosed = true;
+}
+
+void FMcpUnixSocketTransport::Wake()
+{
+#if MCP_WITH_UNIX_SOCKETS
+    if (WakeFds[1] >= 0)
+    {
+        // A full pipe already guarantees a wake-up, so a failed write is fine.
+        const uint8 Byte = 1;
+        const ssize_t Written = write(WakeFds[1], &Byte, 1);
+        (void)Written;
+    }
+#endif
+}
+
+TArray<uint8> FMcpUnixSocketTransport::MakeHttpResponse(int32 Status, const FString& Body, int32 RetryAfterSeconds, bool bClose)
+{
+    const FTCHARToUTF8 BodyUtf8(*Body, Body.Len());
+
+    FString Head = FString::Printf(TEXT("HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %d\r\n"),
+        Status, McpUnixSocket::GetStatusText(Status), BodyUtf8.Length());
+    if (RetryAfterSeconds > 0)
+    {
+        Head += FString::Printf(TEXT("Retry-After: %d\r\n"), RetryAfterSeconds);
+    }
+    Head += bClose ? TEXT("Connection: close\r\n\r\n") : TEXT("Connection: keep-alive\r\n\r\n");
+
+    TArray<uint8> Bytes;
+    Bytes.Reserve(Head.Len() + BodyUtf8.Length());
+    McpUnixSocket::AppendUtf8(Bytes, Head);
+    Bytes.Append(reinterpret_cast<const uint8*>(BodyUtf8.Get()), BodyUtf8.Length());
+    return Bytes;
+}
+
+TArray<uint8> FMcpUnixSocketTransport::MakeFrame(const FString& Body)
+{
+    const FTCHARToUTF8 BodyUtf8(*Body, Body.Len());
+    const uint32 Length = (uint32)BodyUtf8.Length();
+
+    TArray<uint8> Bytes;
+    Bytes.Reserve(4 + Length);
+    Bytes.Add((uint8)(Length >> 24));
+    Bytes.Add((uint8)(Length >> 16));
+    Bytes.Add((uint8)(Length >> 8));
+    Bytes.Add((uint8)Length);
+    Bytes.Append(reinterpret_cast<const uint8*>(BodyUtf8.Get()), Length);
+    return Bytes;
+}
@@ -0,0 +1,230 @@
+#include "McpValidationSandbox.h"
+
+#include "BlueprintCompilationManager.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraphToken.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Logging/TokenizedMessage.h"
+#include "McpTrace.h"
+#include "Misc/UObjectToken.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace McpValidation
+{
+    static const TCHAR* DescribeSeverity(EMessageSeverity::Type Severity)
+    {
+        switch (Severity)
+        {
+        case EMessageSeverity::Error:
+            return TEXT("error");
+        case EMessageSeverity::Warning:
+        case EMessageSeverity::PerformanceWarning:
+            return TEXT("warning");
+        default:
+            return TEXT("info");
+        }
+    }
+
+    static const UEdGraphNode* FindMessageNode(const FTokenizedMessage& Message)
+    {
+        for (const TSharedRef<IMessageToken>& Token : Message.GetMessageTokens())
+        {
+            const UObject* Object = nullptr;
+            if (Token->GetType() == EMessageToken::EdGraph)
+            {
+                const FEdGraphToken& GraphToken = static_cast<const FEdGraphToken&>(Token.Get());
+                Object = GraphToken.GetPin() ? GraphToken.GetPin()->GetOwningNodeUnchecked() : GraphToken.GetGraphObject();
+            }
+            else if (Token->GetType() == EMessageToken::Object)
+            {
+                Object = static_cast<const FUObjectToken&>(Token.Get()).GetObject().Get();
+            }
+
+            if (const UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+            {
+                return Node;
+            }
+        }
+        return nullptr;
+    }
+}
+
+FMcpValidationSandbox::FMcpValidationSandbox()
+{
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMcpValidationSandbox::OnObjectModified);
+}
+
+FMcpValidationSandbox::~FMcpValidationSandbox()
+{
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    for (TPair<TObjectKey<UBlueprint>, FEntry>& Pair : Entries)
+    {
+        Release(Pair.Value);
+    }
+}
+
+UBlueprint* FMcpValidationSandbox::Acquire(UBlueprint* Source, const TArray<FString>& EditKeys, int32& OutAppliedCount, FString& OutError)
+{
+    MCP_TRACE_SCOPE("Mcp::Validation::Acquire");
+
+    OutAppliedCount = 0;
+    if (FEntry* Existing = Entries.Find(Source))
+    {
+        const TArray<FString>& Applied = Existing->AppliedEdits;
+        bool bIsPrefix = Applied.Num() <= EditKeys.Num();
+        for (int32 Index = 0; bIsPrefix && Index < Applied.Num(); ++Index)
+        {
+            bIsPrefix = Applied[Index] == EditKeys[Index];
+        }
+
+        if (bIsPrefix && Existing->Copy)
+        {
+            Existing->LastUse = ++UseCounter;
+            OutAppliedCount = Applied.Num();
+            return Existing->Copy;
+        }
+        Discard(Source);
+    }
+
+    if (Entries.Num() >= MaxCopies)
+    {
+        TObjectKey<UBlueprint> OldestKey;
+        uint64 OldestUse = MAX_uint64;
+        for (const TPair<TObjectKey<UBlueprint>, FEntry>& Pair : Entries)
+        {
+            if (Pair.Value.LastUse < OldestUse)
+            {
+                OldestUse = Pair.Value.LastUse;
+                OldestKey = Pair.Key;
+            }
+        }
+        if (FEntry* Oldest = Entries.Find(OldestKey))
+        {
+            Release(*Oldest);
+            Entries.Remove(OldestKey);
+        }
+    }
+
+    UBlueprint* Copy = nullptr;
+    {
+        MCP_TRACE_SCOPE("Mcp::Validation::Duplicate");
+        // A package of its own lets PostDuplicate give the copy its own generated class.
+        UPackage* Package = CreatePackage(*FString::Printf(TEXT("/Temp/McpValidation/%s_%d"), *Source->GetName(), ++CopyCounter));
+        Package->SetFlags(RF_Transient);
+        Copy = DuplicateObject<UBlueprint>(Source, Package, Source->GetFName());
+    }
+    if (!Copy)
+    {
+        OutError = TEXT("Failed to duplicate Blueprint.");
+        return nullptr;
+    }
+
+    FEntry& Entry = Entries.Add(Source);
+    Entry.Copy = Copy;
+    Entry.Source = Source;
+    Entry.LastUse = ++UseCounter;
+    Entry.CompiledHandle = Source->OnCompiled().AddLambda([this](UBlueprint* Compiled)
+    {
+        Discard(Compiled);
+    });
+    return Copy;
+}
+
+void FMcpValidationSandbox::MarkApplied(UBlueprint* Source, const TArray<FString>& EditKeys)
+{
+    if (FEntry* Entry = Entries.Find(Source))
+    {
+        Entry->AppliedEdits = EditKeys;
+    }
+}
+
+void FMcpValidationSandbox::Discard(const UBlueprint* Source)
+{
+    if (FEntry* Entry = Entries.Find(Source))
+    {
+        Release(*Entry);
+        Entries.Remove(Source);
+    }
+}
+
+void FMcpValidationSandbox::Release(FEntry& Entry)
+{
+    if (UBlueprint* Source = Entry.Source.Get())
+    {
+        Source->OnCompiled().Remove(Entry.CompiledHandle);
+    }
+
+    // The copy inherits RF_Standalone from the source; clear it so the next GC can collect the package.
+    if (Entry.Copy)
+    {
+        ForEachObjectWithPackage(Entry.Copy->GetOutermost(), [](UObject* Object)
+        {
+            Object->ClearFlags(RF_Standalone | RF_Public);
+            return true;
+        });
+        Entry.Copy->GetOutermost()->ClearFlags(RF_Standalone | RF_Public);
+    }
+    Entry.Copy = nullptr;
+}
+
+void FMcpValidationSandbox::OnObjectModified(UObject* Object)
+{
+    if (Entries.Num() == 0 || !Object)
+    {
+        return;
+    }
+
+    const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+    if (!Blueprint)
+    {
+        Blueprint = Object->GetTypedOuter<UBlueprint>();
+    }
+    if (Blueprint && Entries.Contains(Blueprint))
+    {
+        Discard(Blueprint);
+    }
+}
+
+bool FMcpValidationSandbox::Compile(UBlueprint* Copy, TArray<FMcpValidationDiagnostic>& OutDiagnostics)
+{
+    MCP_TRACE_SCOPE("Mcp::Validation::Compile");
+
+    FCompilerResultsLog Results;
+    Results.bSilentMode = true;
+    Results.SetSourcePath(Copy->GetPathName());
+
+    // The copy has no instances and nobody reads its defaults, so reinstancing and CDO checks are skipped;
+    // the graphs are still compiled, since that is where node errors are reported.
+    const EBlueprintCompileOptions Options = EBlueprintCompileOptions::SkipGarbageCollection
+        | EBlueprintCompileOptions::SkipSave
+        | EBlueprintCompileOptions::SkipFiBSearchMetaUpdate
+        | EBlueprintCompileOptions::SkipReinstancing
+        | EBlueprintCompileOptions::SkipDefaultObjectValidation
+        | EBlueprintCompileOptions::SkipNewVariableDefaultsDetection;
+    FBlueprintCompilationManager::CompileSynchronously(FBPCompileRequest(Copy, Options, &Results));
+
+    for (const TSharedRef<FTokenizedMessage>& Message : Results.Messages)
+    {
+        FMcpValidationDiagnostic& Diagnostic = OutDiagnostics.AddDefaulted_GetRef();
+        Diagnostic.Severity = McpValidation::DescribeSeverity(Message->GetSeverity());
+        Diagnostic.Message = Message->ToText().ToString();
+        if (const UEdGraphNode* Node = McpValidation::FindMessageNode(*Message))
+        {
+            Diagnostic.NodeGuid = Node->NodeGuid;
+            Diagnostic.Graph = Node->GetGraph() ? Node->GetGraph()->GetName() : FString();
+        }
+    }
+
+    return Results.NumErrors == 0 && Copy->Status != EBlueprintStatus::BS_Error;
+}
+
+void FMcpValidationSandbox::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (TPair<TObjectKey<UBlueprint>, FEntry>& Pair : Entries)
+    {
+        Collector.AddReferencedObject(Pair.Value.Copy);
+    }
+}
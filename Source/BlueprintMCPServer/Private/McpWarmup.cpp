@@ -0,0 +1,113 @@
+#include "McpWarmup.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Json.h"
+#include "McpTrace.h"
+
+namespace McpWarmup
+{
+    // Steps wait while the user is typing or dragging, but never longer than this.
+    static constexpr double UserIdleSeconds = 0.5;
+    static constexpr double MaxDeferSeconds = 5.0;
+
+    static bool IsUserActive()
+    {
+        if (!FSlateApplication::IsInitialized())
+        {
+            return false;
+        }
+        const FSlateApplication& Slate = FSlateApplication::Get();
+        return Slate.GetCurrentTime() - Slate.GetLastUserInteractionTime() < UserIdleSeconds;
+    }
+}
+
+FMcpWarmup::~FMcpWarmup()
+{
+    Cancel();
+}
+
+void FMcpWarmup::Begin(TArray<FStep>&& InSteps)
+{
+    Cancel();
+
+    Steps = MoveTemp(InSteps);
+    if (Steps.Num() == 0)
+    {
+        return;
+    }
+
+    StartTime = FPlatformTime::Seconds();
+    LastStepTime = StartTime;
+    NumSteps = Steps.Num();
+    CompletedSteps = 0;
+    ElapsedSeconds = 0.0;
+    CurrentStep = Steps[0].Name;
+    bWarming.store(true, std::memory_order_release);
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMcpWarmup::Tick));
+}
+
+void FMcpWarmup::Cancel()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    bWarming.store(false, std::memory_order_release);
+    CurrentStep = nullptr;
+}
+
+bool FMcpWarmup::Tick(float DeltaTime)
+{
+    MCP_TRACE_SCOPE("Mcp::Warmup::Tick");
+
+    const double Now = FPlatformTime::Seconds();
+    ElapsedSeconds = Now - StartTime;
+    if (McpWarmup::IsUserActive() && Now - LastStepTime < McpWarmup::MaxDeferSeconds)
+    {
+        return true;
+    }
+
+    const int32 Index = CompletedSteps.load();
+    if (!Steps[Index].Run())
+    {
+        return true;
+    }
+
+    LastStepTime = FPlatformTime::Seconds();
+    CompletedSteps = Index + 1;
+    if (Index + 1 < Steps.Num())
+    {
+        CurrentStep = Steps[Index + 1].Name;
+        return true;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("[MCP] Warm-up finished in %.2fs."), LastStepTime - StartTime);
+    TickerHandle.Reset();
+    CurrentStep = nullptr;
+    bWarming.store(false, std::memory_order_release);
+    return false;
+}
+
+FString FMcpWarmup::Describe() const
+{
+    const TCHAR* Step = CurrentStep.load();
+    return FString::Printf(TEXT("Server warming up (%d/%d: %s)"), CompletedSteps.load(), NumSteps.load(), Step ? Step : TEXT("done"));
+}
+
+TSharedRef<FJsonObject> FMcpWarmup::BuildStatusJson() const
+{
+    const int32 Total = NumSteps.load();
+    const TCHAR* Step = CurrentStep.load();
+
+    TSharedRef<FJsonObject> StatusObj = MakeShared<FJsonObject>();
+    StatusObj->SetStringField(TEXT("status"), IsWarming() ? TEXT("warming") : TEXT("ready"));
+    StatusObj->SetNumberField(TEXT("progress"), Total > 0 ? (double)CompletedSteps.load() / Total : 1.0);
+    if (Step)
+    {
+        StatusObj->SetStringField(TEXT("step"), Step);
+    }
+    StatusObj->SetNumberField(TEXT("elapsed_s"), ElapsedSeconds.load());
+    return StatusObj;
+}
@@ -0,0 +1,394 @@
+#include "McpWebSocketTransport.h"
+
+#include "INetworkingWebSocket.h"
+#include "IWebSocketNetworkingModule.h"
+#include "IWebSocketServer.h"
+#include "Json.h"
+#include "McpServer.h"
+#include "McpServerMetrics.h"
+#include "McpTrace.h"
+#include "WebSocketNetworkingDelegates.h"
+
+namespace McpWebSocket
+{
+    static constexpr int32 ParseError = -32700;
+    static constexpr int32 InvalidRequest = -32600;
+    static constexpr int32 ActionFailed = -32000;
+    static constexpr int32 ServerBusy = -32001;
+    static constexpr int32 ServerWarming = -32002;
+    static constexpr int32 MaxMessageBytes = 16 * 1024 * 1024;
+
+    using FMessageWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+    // JSON-RPC ids are strings or numbers; integral numbers are echoed without a fraction so clients can match them.
+    static void WriteId(const TSharedRef<FMessageWriter>& Writer, const TSharedPtr<FJsonValue>& Id)
+    {
+        if (Id.IsValid() && Id->Type == EJson::String)
+        {
+            Writer->WriteValue(TEXT("id"), Id->AsString());
+        }
+        else if (Id.IsValid() && Id->Type == EJson::Number)
+        {
+            const double Number = Id->AsNumber();
+            Writer->WriteRawJSONValue(TEXT("id"), FMath::IsNearlyEqual(Number, FMath::RoundToDouble(Number))
+                ? FString::Printf(TEXT("%lld"), (int64)Number)
+                : FString::SanitizeFloat(Number));
+        }
+        else
+        {
+            Writer->WriteNull(TEXT("id"));
+        }
+    }
+}
+
+// INetworkingWebSocket hands over fragments without the frame's FIN bit or remaining length, so a
+// message is complete once its top-level object or array closes, counted outside string literals.
+// Anything that does not open with '{' or '[' is complete as is and fails to parse. The scan resumes
+// where the previous fragment stopped, so a message is read once however many fragments it takes.
+bool FMcpWebSocketTransport::FMessageScan::Advance(TConstArrayView<uint8> Bytes)
+{
+    for (; Offset < Bytes.Num(); ++Offset)
+    {
+        const uint8 Byte = Bytes[Offset];
+        if (bInString)
+        {
+            if (bEscaped)
+            {
+                bEscaped = false;
+            }
+            else if (Byte == '\\')
+            {
+                bEscaped = true;
+            }
+            else if (Byte == '"')
+            {
+                bInString = false;
+                if (Depth == 0)
+                {
+                    return true;
+                }
+            }
+            continue;
+        }
+
+        switch (Byte)
+        {
+        case ' ': case '\t': case '\r': case '\n':
+            break;
+        case '"':
+            bInString = true;
+            break;
+        case '{': case '[':
+            ++Depth;
+            break;
+        case '}': case ']':
+            if (--Depth <= 0)
+            {
+                return true;
+            }
+            break;
+        default:
+            if (Depth == 0)
+            {
+                return true;
+            }
+            break;
+        }
+    }
+    return false;
+}
+
+FMcpWebSocketTransport::FMcpWebSocketTransport(TWeakPtr<FMcpServer> InServer)
+    : ServerWeak(MoveTemp(InServer))
+{
+}
+
+FMcpWebSocketTransport::~FMcpWebSocketTransport()
+{
+    Stop();
+}
+
+bool FMcpWebSocketTransport::Start(uint16 InPort, FString& OutError)
+{
+    if (Server.IsValid())
+    {
+        OutError = TEXT("WebSocket listener already running.");
+        return false;
+    }
+
+    IWebSocketNetworkingModule& Module = FModuleManager::LoadModuleChecked<IWebSocketNetworkingModule>(TEXT("WebSocketNetworking"));
+    Server = Module.CreateServer();
+
+    FWebSocketClientConnectedCallBack ConnectedCallback;
+    ConnectedCallback.BindRaw(this, &FMcpWebSocketTransport::OnClientConnected);
+
+    if (!Server.IsValid() || !Server->Init(InPort, ConnectedCallback, TEXT("127.0.0.1")))
+    {
+        OutError = FString::Printf(TEXT("Failed to start WebSocket listener on port %d"), InPort);
+        Server.Reset();
+        return false;
+    }
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FMcpWebSocketTransport::Tick));
+    return true;
+}
+
+void FMcpWebSocketTransport::Stop()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    Connections.Reset();
+    Server.Reset();
+}
+
+bool FMcpWebSocketTransport::Tick(float DeltaTime)
+{
+    MCP_LLM_SCOPE();
+    MCP_TRACE_SCOPE("Mcp::WebSocket::Tick");
+
+    if (Server.IsValid())
+    {
+        Server->Tick();
+    }
+
+    // Sockets are released here rather than inside their own close callback.
+    Connections.RemoveAll([](const TUniquePtr<FConnection>& Connection)
+    {
+        return Connection->bClosed;
+    });
+
+    return true;
+}
+
+void FMcpWebSocketTransport::OnClientConnected(INetworkingWebSocket* Socket)
+{
+    if (!Socket)
+    {
+        return;
+    }
+
+    TUniquePtr<FConnection> Connection = MakeUnique<FConnection>();
+    Connection->Id = NextConnectionId++;
+    Connection->Socket.Reset(Socket);
+    Connection->RemoteAddress = Socket->RemoteEndPoint(/*bAppendPort=*/true);
+    Connection->ClientKey = Socket->RemoteEndPoint(/*bAppendPort=*/false);
+
+    FWebSocketPacketReceivedCallBack ReceiveCallback;
+    ReceiveCallback.BindRaw(this, &FMcpWebSocketTransport::OnReceive, Connection->Id);
+    Socket->SetReceiveCallBack(ReceiveCallback);
+
+    FWebSocketInfoCallBack ClosedCallback;
+    ClosedCallback.BindRaw(this, &FMcpWebSocketTransport::OnClosed, Connection->Id);
+    Socket->SetSocketClosedCallBack(ClosedCallback);
+
+    if (TSharedPtr<FMcpServer> McpServer = ServerWeak.Pin())
+    {
+        McpServer->Log(FString::Printf(TEXT("WebSocket client %u connected."), Connection->Id));
+    }
+
+    Connections.Add(MoveTemp(Connection));
+}
+
+void FMcpWebSocketTransport::OnReceive(void* Data, int32 Count, uint32 ConnectionId)
+{
+    FConnection* Connection = FindConnection(ConnectionId);
+    if (!Connection || Count <= 0)
+    {
+        return;
+    }
+
+    Connection->Buffer.Append(static_cast<const uint8*>(Data), Count);
+
+    // Large messages can arrive as several fragments; wait until the buffered bytes close the message.
+    if (!Connection->Scan.Advance(Connection->Buffer))
+    {
+        if (Connection->Buffer.Num() > McpWebSocket::MaxMessageBytes)
+        {
+            Connection->Buffer.Reset();
+            Connection->Scan = FMessageScan();
+            SendText(ConnectionId, MakeErrorMessage(nullptr, McpWebSocket::InvalidRequest, TEXT("Message too large")));
+        }
+        return;
+    }
+
+    FString Message;
+    {
+        const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Connection->Buffer.GetData()), Connection->Buffer.Num());
+        Message = FString(Converter.Length(), Converter.Get());
+    }
+
+    Connection->Buffer.Reset();
+    Connection->Scan = FMessageScan();
+    HandleMessage(ConnectionId, Message);
+}
+
+void FMcpWebSocketTransport::OnClosed(uint32 ConnectionId)
+{
+    if (FConnection* Connection = FindConnection(ConnectionId))
+    {
+        Connection->bClosed = true;
+    }
+
+    if (TSharedPtr<FMcpServer> McpServer = ServerWeak.Pin())
+    {
+        McpServer->Log(FString::Printf(TEXT("WebSocket client %u disconnected."), ConnectionId));
+    }
+}
+
+void FMcpWebSocketTransport::HandleMessage(uint32 ConnectionId, const FString& Message)
+{
+    MCP_LLM_SCOPE();
+    MCP_TRACE_SCOPE("Mcp::WebSocket::HandleMessage");
+
+    TSharedPtr<FJsonObject> RequestObj;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+    if (!FJsonSerializer::Deserialize(Reader, RequestObj) || !RequestObj.IsValid())
+    {
+        SendText(ConnectionId, MakeErrorMessage(nullptr, McpWebSocket::ParseError, TEXT("Malformed JSON")));
+        return;
+    }
+
+    TSharedPtr<FJsonValue> Id = RequestObj->TryGetField(TEXT("id"));
+    if (Id.IsValid() && Id->IsNull())
+    {
+        Id.Reset();
+    }
+
+    FString Action;
+    if (!RequestObj->TryGetStringField(TEXT("method"), Action) && !RequestObj->TryGetStringField(TEXT("action"), Action))
+    {
+        SendText(ConnectionId, MakeErrorMessage(Id, McpWebSocket::InvalidRequest, TEXT("Missing 'method'")));
+        return;
+    }
+
+    const TSharedPtr<FJsonObject>* ParamsObj = nullptr;
+    RequestObj->TryGetObjectField(TEXT("params"), ParamsObj);
+    const TSharedPtr<FJsonObject> Params = ParamsObj ? *ParamsObj : MakeShared<FJsonObject>();
+
+    FMcpRequestTiming Timing;
+    Timing.StartTime = FPlatformTime::Seconds();
+    Timing.RequestBytes = FPlatformString::ConvertedLength<UTF8CHAR>(*Message, Message.Len());
+    Timing.Transport = TEXT("ws");
+    FString ClientKey;
+    if (FConnection* Connection = FindConnection(ConnectionId))
+    {
+        // Agents on one host name themselves with a top-level `client`, like X-MCP-Client over HTTP.
+        FString ClientName;
+        if (RequestObj->TryGetStringField(TEXT("client"), ClientName) && !ClientName.IsEmpty())
+        {
+            Connection->ClientKey = ClientName;
+        }
+        Timing.Client = Connection->RemoteAddress;
+        ClientKey = Connection->ClientKey;
+    }
+
+    // Each request is admitted independently so a slow action does not hold back responses to later ones.
+    TSharedPtr<FMcpServer> McpServer = ServerWeak.Pin();
+    if (!McpServer.IsValid())
+    {
+        SendResult(ConnectionId, Id, false, FString(), TEXT("Server stopped."));
+        return;
+    }
+
+    if (McpServer->IsWarmingUp(Action))
+    {
+        if (Id.IsValid())
+        {
+            SendText(ConnectionId, MakeErrorMessage(Id, McpWebSocket::ServerWarming, McpServer->GetWarmupStatus(), /*RetryAfterSeconds=*/1));
+        }
+        return;
+    }
+
+    TWeakPtr<FMcpWebSocketTransport> SelfWeak = AsShared();
+    int32 RetryAfterSeconds = 0;
+    const bool bAdmitted = McpServer->SubmitAction(Action, Params, ClientKey, Timing,
+        [SelfWeak, ConnectionId, Id](bool bOk, const FString& Response, const FString& Error)
+        {
+            if (TSharedPtr<FMcpWebSocketTransport> Self = SelfWeak.Pin())
+            {
+                Self->SendResult(ConnectionId, Id, bOk, Response, Error);
+            }
+        },
+        RetryAfterSeconds);
+
+    if (!bAdmitted && Id.IsValid())
+    {
+        SendText(ConnectionId, MakeErrorMessage(Id, McpWebSocket::ServerBusy, TEXT("Server busy"), RetryAfterSeconds));
+    }
+}
+
+void FMcpWebSocketTransport::SendResult(uint32 ConnectionId, const TSharedPtr<FJsonValue>& Id, bool bOk, const FString& Payload, const FString& Error)
+{
+    // Requests without an id are notifications and get no reply.
+    if (!Id.IsValid())
+    {
+        return;
+    }
+
+    SendText(ConnectionId, bOk ? MakeResultMessage(Id, Payload) : MakeErrorMessage(Id, McpWebSocket::ActionFailed, Error));
+}
+
+void FMcpWebSocketTransport::SendText(uint32 ConnectionId, const FString& Text)
+{
+    FConnection* Connection = FindConnection(ConnectionId);
+    if (!Connection || Connection->bClosed || !Connection->Socket.IsValid())
+    {
+        return;
+    }
+
+    const FTCHARToUTF8 Utf8(*Text);
+    Connection->Socket->Send(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), /*bPrependSize=*/false);
+}
+
+FMcpWebSocketTransport::FConnection* FMcpWebSocketTransport::FindConnection(uint32 ConnectionId)
+{
+    for (const TUniquePtr<FConnection>& Connection : Connections)
+    {
+        if (Connection->Id == ConnectionId)
+        {
+            return Connection.Get();
+        }
+    }
+    return nullptr;
+}
+
+FString FMcpWebSocketTransport::MakeResultMessage(const TSharedPtr<FJsonValue>& Id, const FString& ResultJson)
+{
+    // The action's response is already serialized, so it is spliced in rather than parsed again.
+    FString Text;
+    TSharedRef<McpWebSocket::FMessageWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("jsonrpc"), TEXT("2.0"));
+    McpWebSocket::WriteId(Writer, Id);
+    Writer->WriteRawJSONValue(TEXT("result"), ResultJson);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+    return Text;
+}
+
+FString FMcpWebSocketTransport::MakeErrorMessage(const TSharedPtr<FJsonValue>& Id, int32 Code, const FString& Message, int32 RetryAfterSeconds)
+{
+    FString Text;
+    TSharedRef<McpWebSocket::FMessageWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("jsonrpc"), TEXT("2.0"));
+    McpWebSocket::WriteId(Writer, Id);
+    Writer->WriteObjectStart(TEXT("error"));
+    Writer->WriteValue(TEXT("code"), Code);
+    Writer->WriteValue(TEXT("message"), Message);
+    if (RetryAfterSeconds > 0)
+    {
+        Writer->WriteObjectStart(TEXT("data"));
+        Writer->WriteValue(TEXT("retry_after"), RetryAfterSeconds);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteObjectEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+    return Text;
+}
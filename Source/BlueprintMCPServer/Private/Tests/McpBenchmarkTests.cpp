@@ -0,0 +1,131 @@
+#include "McpBenchmark.h"
+
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "K2Node_CallFunction.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMcpBenchmarkGeneratorTest, "BlueprintMCP.Benchmark.Generator",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMcpBenchmarkGeneratorTest::RunTest(const FString& Parameters)
+{
+    FMcpBenchmarkConfig Config;
+    Config.NumGraphs = 2;
+    Config.NodesPerGraph = 5;
+    Config.LinksPerNode = 2;
+
+    FString Error;
+    UBlueprint* Blueprint = FMcpBenchmark::GenerateSyntheticBlueprint(Config, Error);
+    if (!TestNotNull(FString::Printf(TEXT("Synthetic Blueprint (%s)"), *Error), Blueprint))
+    {
+        return false;
+    }
+
+    for (int32 GraphIndex = 0; GraphIndex < Config.NumGraphs; ++GraphIndex)
+    {
+        const FName GraphName(*FString::Printf(TEXT("BenchGraph_%d"), GraphIndex));
+        UEdGraph* const* Graph = Blueprint->FunctionGraphs.FindByPredicate([&GraphName](const UEdGraph* Candidate)
+        {
+            return Candidate && Candidate->GetFName() == GraphName;
+        });
+        if (!TestNotNull(FString::Printf(TEXT("Graph %s"), *GraphName.ToString()), Graph))
+        {
+            continue;
+        }
+
+        int32 NumCalls = 0;
+        int32 NumLinks = 0;
+        for (UEdGraphNode* Node : (*Graph)->Nodes)
+        {
+            if (!Cast<UK2Node_CallFunction>(Node))
+            {
+                continue;
+            }
+
+            ++NumCalls;
+            if (const UEdGraphPin* ReturnPin = Node->FindPin(TEXT("ReturnValue")))
+            {
+                NumLinks += ReturnPin->LinkedTo.Num();
+            }
+        }
+
+        // Node i feeds nodes i+1..i+K that exist: 2 + 2 + 2 + 1 + 0 for five nodes and two links.
+        TestEqual(FString::Printf(TEXT("Call nodes in %s"), *GraphName.ToString()), NumCalls, 5);
+        TestEqual(FString::Printf(TEXT("Links in %s"), *GraphName.ToString()), NumLinks, 7);
+    }
+
+    FMcpBenchmark::DiscardSyntheticBlueprint(Blueprint);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMcpBenchmarkCompareTest, "BlueprintMCP.Benchmark.CompareWithBaseline",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMcpBenchmarkCompareTest::RunTest(const FString& Parameters)
+{
+    auto MakeResult = [](const TCHAR* Case, double MedianMs, bool bFailed = false)
+    {
+        FMcpBenchmarkResult Result;
+        Result.Case = Case;
+        Result.Iterations = 10;
+        Result.MedianMs = MedianMs;
+        Result.P99Ms = MedianMs;
+        Result.bFailed = bFailed;
+        Result.Error = bFailed ? TEXT("Node not found.") : TEXT("");
+        return Result;
+    };
+
+    FMcpBenchmarkConfig Config;
+    Config.RegressionThreshold = 0.10;
+    Config.BaselineCsv = FPaths::AutomationTransientDir() / TEXT("McpBenchmarkBaseline.csv");
+
+    const TArray<FMcpBenchmarkResult> Baseline =
+    {
+        MakeResult(TEXT("steady"), 1.0),
+        MakeResult(TEXT("slower"), 1.0),
+        MakeResult(TEXT("broken"), 1.0),
+        MakeResult(TEXT("was_failing"), 0.0, true)
+    };
+
+    FString Error;
+    if (!FMcpBenchmark::WriteCsv(Config, Baseline, Config.BaselineCsv, Error))
+    {
+        AddError(Error);
+        return false;
+    }
+
+    const TArray<FMcpBenchmarkResult> Current =
+    {
+        MakeResult(TEXT("steady"), 1.05),
+        MakeResult(TEXT("slower"), 1.5),
+        MakeResult(TEXT("broken"), 0.0, true),
+        MakeResult(TEXT("was_failing"), 5.0)
+    };
+
+    TArray<FString> Regressions;
+    TestTrue(TEXT("Compare succeeds"), FMcpBenchmark::CompareWithBaseline(Config, Current, Regressions, Error));
+    TestEqual(TEXT("Regression count"), Regressions.Num(), 2);
+    TestTrue(TEXT("Slower case reported"), Regressions.ContainsByPredicate([](const FString& Line) { return Line.StartsWith(TEXT("slower ")); }));
+    TestTrue(TEXT("Failed case reported"), Regressions.ContainsByPredicate([](const FString& Line) { return Line.StartsWith(TEXT("broken ")); }));
+
+    // Results for another graph size do not match the baseline rows.
+    FMcpBenchmarkConfig OtherSize = Config;
+    OtherSize.NodesPerGraph = Config.NodesPerGraph * 2;
+    Regressions.Reset();
+    TestTrue(TEXT("Compare other size succeeds"), FMcpBenchmark::CompareWithBaseline(OtherSize, { MakeResult(TEXT("slower"), 1.5) }, Regressions, Error));
+    TestEqual(TEXT("No regressions across sizes"), Regressions.Num(), 0);
+
+    FMcpBenchmarkConfig Missing = Config;
+    Missing.BaselineCsv = FPaths::AutomationTransientDir() / TEXT("McpBenchmarkMissing.csv");
+    TestFalse(TEXT("Missing baseline fails"), FMcpBenchmark::CompareWithBaseline(Missing, Current, Regressions, Error));
+
+    IFileManager::Get().Delete(*Config.BaselineCsv);
+    return true;
+}
+
+#endif
@@ -1,18 +1,78 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 class UBlueprint;
 
+struct FMcpExportOptions
+{
+    bool bIncludeTitles = true;
+    bool bIncludeFullTitles = false;
+    bool bIncludeTooltips = false;
+};
+
 class FMcpBlueprintInspector
 {
 public:
     static bool BuildBlueprintJson(const FString& BlueprintPath, TSharedRef<class FJsonObject>& OutJson, FString& OutError);
+    static bool BuildBlueprintJson(UBlueprint* Blueprint, TSharedRef<class FJsonObject>& OutJson, FString& OutError, const FMcpExportOptions& Options = FMcpExportOptions());
     static bool ListBlueprints(const TArray<FString>& Roots, TArray<FString>& OutBlueprints, FString& OutError);
     static bool GetReferences(const FString& BlueprintPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError);
+    static FString DescribePinType(const struct FEdGraphPinType& PinType);
+    // Function a call node targets or an event implements; empty for other nodes.
+    static FString GetFunctionName(const class UEdGraphNode* Node);
+
+    // Scratch objects are copies that are not project assets: the transient package, /Temp (validation
+    // sandboxes, benchmarks) and saved revisions loaded for diffing. Indexes and events skip them.
+    static bool IsScratchObject(const UObject* Object);
+    static bool IsScratchPath(const FString& Path);
 
 private:
-    static bool GatherGraphs(UBlueprint* Blueprint, TArray<TSharedPtr<FJsonValue>>& OutGraphs);
-    static void SerializeNode(const class UEdGraphNode* Node, TSharedRef<class FJsonObject>& OutJson);
-    static FString DescribePinType(const struct FEdGraphPinType& PinType);
+    friend class FMcpBlueprintJsonBuilder;
+
+    static void SerializeNode(const class UEdGraphNode* Node, const FMcpExportOptions& Options, TSharedRef<class FJsonObject>& OutJson);
+};
+
+// Resumable BuildBlueprintJson: Step serializes nodes until Deadline (FPlatformTime::Seconds) and
+// picks up where it stopped on the next call, so a huge Blueprint can be exported across frames.
+// If the Blueprint is modified while suspended the export starts over; after a few restarts it
+// finishes in one step so constant editing cannot starve it. Game thread only.
+class FMcpBlueprintJsonBuilder
+{
+public:
+    FMcpBlueprintJsonBuilder(UBlueprint* InBlueprint, const FMcpExportOptions& InOptions, const TSharedRef<class FJsonObject>& InJson);
+    ~FMcpBlueprintJsonBuilder();
+
+    // Returns true once the export has completed or failed; always makes progress.
+    bool Step(double Deadline);
+
+    bool Succeeded() const { return bDone && Error.IsEmpty(); }
+    const TSharedRef<class FJsonObject>& GetJson() const { return Json; }
+    const FString& GetError() const { return Error; }
+    int32 GetRestarts() const { return Restarts; }
+
+private:
+    static constexpr int32 MaxRestarts = 3;
+
+    void Restart();
+    void Finish(const FString& InError = FString());
+    void OnObjectModified(UObject* Object);
+
+    TWeakObjectPtr<UBlueprint> Blueprint;
+    FMcpExportOptions Options;
+    TSharedRef<class FJsonObject> Json;
+
+    TArray<class UEdGraph*> Graphs;
+    TArray<TSharedPtr<class FJsonValue>> GraphArray;
+    TArray<TSharedPtr<class FJsonValue>> NodeArray;
+    int32 GraphIndex = 0;
+    int32 NodeIndex = 0;
+    bool bStarted = false;
+    bool bDone = false;
+    bool bModified = false;
+    int32 Restarts = 0;
+    FString Error;
+
+    FDelegateHandle ObjectModifiedHandle;
 };
@@ -13,8 +13,10 @@ public:
 private:
     void RegisterMenus();
     void UnregisterMenus();
+    void AutoStartServer();
     TSharedRef<class SDockTab> SpawnMainTab(const class FSpawnTabArgs& Args);
 
     TSharedPtr<FMcpServer> McpServer;
     FDelegateHandle MenuExtenderHandle;
+    FDelegateHandle FilesLoadedHandle;
 };
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BlueprintMcpServerCommandlet.generated.h"
+
+/**
+ * Serves MCP without the editor UI.
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=BlueprintMcpServer -port=9000 [-wsport=9001] [-allowwrites] [-unixsocket=<path>] [-capture=<file>]
+ */
+UCLASS()
+class UBlueprintMcpServerCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBlueprintMcpServerCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
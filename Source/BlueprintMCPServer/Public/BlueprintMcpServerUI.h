@@ -1,9 +1,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "McpServer.h"
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
 
-class FMcpServer;
+class ITableRow;
+class STableViewBase;
+
+struct FMcpLogItem
+{
+    FMcpLogEntry Entry;
+    FString Summary;
+    bool bCollapsible = false;
+    bool bExpanded = false;
+};
 
 class SBlueprintMcpServerPanel : public SCompoundWidget
 {
@@ -15,25 +26,53 @@ public:
     void Construct(const FArguments& InArgs);
     virtual ~SBlueprintMcpServerPanel();
 
+    virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
 private:
-    void OnServerLog(const FString& Message);
-    void AppendLog(const FString& Message);
+    void AppendLog(const FString& Message, EMcpLogSeverity Severity = EMcpLogSeverity::Info);
+    void PushLogEntry(FMcpLogEntry&& Entry);
+    // Full refilter of the ring, after a filter, retention or clear. New entries otherwise go
+    // through PendingVisible and AppendVisibleLog without touching the rest.
+    void RebuildVisibleLog();
+    void AppendVisibleLog();
+    bool IsFollowingTail() const;
+    void RefreshLogView(bool bFollowTail);
+    void SetRetention(int32 NewRetention);
+    bool PassesFilter(const FMcpLogItem& Item) const;
+    void OnToggleSeverity(ECheckBoxState State, EMcpLogSeverity Severity);
+    FReply OnClearLog();
+    TSharedRef<ITableRow> OnGenerateLogRow(TSharedPtr<FMcpLogItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
 
     FReply OnToggleServer();
     FReply OnExportJson();
     void OnToggleWrites(ECheckBoxState State);
 
     FText GetStatusText() const;
+    FText GetQueueText() const;
     FText GetErrorText() const;
     bool IsServerRunning() const;
 
     TWeakPtr<FMcpServer> McpServerWeak;
     TSharedPtr<class SEditableTextBox> PortTextBox;
+    TSharedPtr<class SEditableTextBox> WebSocketPortTextBox;
     TSharedPtr<class SEditableTextBox> BlueprintPathTextBox;
-    TSharedPtr<class SMultiLineEditableTextBox> LogTextBox;
+    TSharedPtr<SListView<TSharedPtr<FMcpLogItem>>> LogListView;
 
     FString LastError;
-    TArray<FString> LogLines;
-    FDelegateHandle LogDelegateHandle;
+
+    // Fixed-size ring of the most recent entries; LogHead is the slot the next entry overwrites.
+    TArray<TSharedPtr<FMcpLogItem>> LogRing;
+    int32 LogHead = 0;
+    int32 LogRetention = 2000;
+    TArray<TSharedPtr<FMcpLogItem>> VisibleLog;
+    // Entries pushed since the last update that pass the filters, and how many visible entries the ring
+    // has overwritten meanwhile.
+    TArray<TSharedPtr<FMcpLogItem>> PendingVisible;
+    int32 NumEvictedVisible = 0;
+    TArray<FMcpLogEntry> DrainScratch;
+    bool bLogNeedsRebuild = false;
+    bool bShowInfo = true;
+    bool bShowWarnings = true;
+    bool bShowErrors = true;
     bool bAllowWrites = false;
 };
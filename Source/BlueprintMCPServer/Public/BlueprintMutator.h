@@ -5,6 +5,8 @@
 class UBlueprint;
 class UEdGraph;
 class UK2Node_CallFunction;
+class UEdGraphNode;
+class UEdGraphPin;
 
 struct FMcpCreationResult
 {
@@ -13,6 +15,48 @@ struct FMcpCreationResult
     FString AssetPath;
 };
 
+struct FMcpGraphNodeSpec
+{
+    FString Id;
+    // Exactly one of these identifies the node: an existing node, a function to call, or an event.
+    FGuid ExistingGuid;
+    UFunction* Function = nullptr;
+    FName EventName;
+    FVector2D Position = FVector2D::ZeroVector;
+    bool bHasPosition = false;
+    TMap<FString, FString> Defaults;
+};
+
+struct FMcpGraphLinkSpec
+{
+    FString FromId;
+    FString FromPin;
+    FString ToId;
+    FString ToPin;
+};
+
+struct FMcpGraphSpec
+{
+    // Namespaces the deterministic node GUIDs so different clients do not collide.
+    FString ClientId;
+    TArray<FMcpGraphNodeSpec> Nodes;
+    TArray<FMcpGraphLinkSpec> Links;
+    bool bRemoveUnlisted = true;
+};
+
+struct FMcpGraphEdit
+{
+    FString Op;
+    FString Target;
+    FString Detail;
+};
+
+struct FMcpGraphApplyResult
+{
+    TMap<FString, FGuid> NodeGuids;
+    TArray<FMcpGraphEdit> Edits;
+};
+
 class FMcpBlueprintMutator
 {
 public:
@@ -27,7 +71,10 @@ public:
     static bool ConnectPins(UBlueprint* Blueprint, const FName& GraphName, const FGuid& FromNode, const FString& FromPin, const FGuid& ToNode, const FString& ToPin, FString& OutError);
     static bool Compile(UBlueprint* Blueprint, FString& OutError);
     static bool SaveBlueprint(UBlueprint* Blueprint, FString& OutError);
+    static bool ApplyGraph(UBlueprint* Blueprint, const FName& GraphName, const FMcpGraphSpec& Spec, FMcpGraphApplyResult& OutResult, FString& OutError);
 
-private:
     static UEdGraph* FindGraph(UBlueprint* Blueprint, const FName& GraphName);
+    static UEdGraphNode* FindNode(UEdGraph* Graph, const FGuid& NodeGuid);
+    static UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName);
+    static void MarkStructurallyModified(UBlueprint* Blueprint);
 };
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "McpServerMetrics.h"
+#include <atomic>
+
+class FRunnableThread;
+class IFileHandle;
+
+struct FMcpAccessRecord
+{
+    FDateTime Timestamp;
+    FString Transport;
+    FString Client;
+    FString Action;
+    FString AssetPath;
+    FString Error;
+    bool bSuccess = false;
+    int32 SampleInterval = 1;
+    FMcpRequestTiming Timing;
+};
+
+// JSON Lines access log. Requests only enqueue a record; formatting, file IO and rotation run on a dedicated thread.
+class FMcpAccessLog : public FRunnable
+{
+public:
+    FMcpAccessLog();
+    virtual ~FMcpAccessLog() override;
+
+    bool Start(FString& OutError);
+    void Shutdown();
+
+    // Returns the sampling interval the record should carry, or 0 when it should be skipped.
+    int32 ShouldRecord(bool bReadAction, bool bSuccess);
+    void Record(FMcpAccessRecord&& AccessRecord);
+
+    const FString& GetFilePath() const { return FilePath; }
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    void WritePending();
+    void WriteRaw(const FString& Line);
+    bool OpenFile();
+    void RotateIfNeeded();
+
+    static FString FormatRecord(const FMcpAccessRecord& AccessRecord);
+
+    FString Directory;
+    FString FilePath;
+    TUniquePtr<IFileHandle> FileHandle;
+    int64 FileSize = 0;
+
+    TQueue<FMcpAccessRecord, EQueueMode::Mpsc> Pending;
+    std::atomic<int32> PendingCount{0};
+    std::atomic<int32> DroppedCount{0};
+    std::atomic<uint64> ReadCounter{0};
+    std::atomic<bool> bStopping{false};
+    std::atomic<bool> bAccepting{false};
+
+    FEvent* WakeEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+enum class EMcpLane : uint8
+{
+    CheapRead,
+    HeavyRead,
+    Write,
+    Num
+};
+
+struct FMcpLaneConfig
+{
+    int32 MaxConcurrent = 1;
+    int32 MaxQueued = 16;
+};
+
+struct FMcpLaneStats
+{
+    int32 Running = 0;
+    int32 Queued = 0;
+    uint64 Completed = 0;
+    uint64 Rejected = 0;
+};
+
+// Queues requests per lane, runs up to MaxConcurrent of each lane on the thread pool and
+// round-robins between clients so one busy client cannot starve the others.
+class FMcpAdmissionController : public TSharedFromThis<FMcpAdmissionController, ESPMode::ThreadSafe>
+{
+public:
+    FMcpAdmissionController();
+
+    static EMcpLane Classify(const FString& Action);
+    static const TCHAR* GetLaneName(EMcpLane Lane);
+
+    // Run is invoked on a worker thread once admitted; Cancel is invoked instead if the queue is flushed.
+    // Returns false with a Retry-After estimate when the lane's queue is full.
+    bool Submit(EMcpLane Lane, const FString& Client, TFunction<void()>&& Run, TFunction<void()>&& Cancel, int32& OutRetryAfterSeconds);
+    void CancelQueued();
+
+    FMcpLaneStats GetLaneStats(EMcpLane Lane) const;
+    TSharedRef<FJsonObject> BuildStatsJson() const;
+
+private:
+    struct FWorkItem
+    {
+        TFunction<void()> Run;
+        TFunction<void()> Cancel;
+    };
+
+    struct FLane
+    {
+        FMcpLaneConfig Config;
+        TArray<FString> Clients;
+        TMap<FString, TArray<FWorkItem>> PerClient;
+        int32 NextClient = 0;
+        int32 Running = 0;
+        int32 Queued = 0;
+        uint64 Completed = 0;
+        uint64 Rejected = 0;
+        double AverageSeconds = 0.0;
+    };
+
+    bool PopNext(FLane& Lane, FWorkItem& OutItem);
+    void Pump(EMcpLane LaneIndex);
+    void OnFinished(EMcpLane LaneIndex, double Seconds);
+
+    FLane Lanes[(int32)EMcpLane::Num];
+    mutable FCriticalSection Mutex;
+};
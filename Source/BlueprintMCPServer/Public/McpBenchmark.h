@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+
+struct FMcpBenchmarkConfig
+{
+    int32 NumGraphs = 4;
+    int32 NodesPerGraph = 50;
+    int32 LinksPerNode = 1;
+    int32 Iterations = 20;
+    double RegressionThreshold = 0.10;
+    FString OutputCsv;
+    FString BaselineCsv;
+};
+
+struct FMcpBenchmarkResult
+{
+    FString Case;
+    int32 Iterations = 0;
+    double MedianMs = 0.0;
+    double P99Ms = 0.0;
+    double MeanAllocs = 0.0;
+    // Set when an iteration returned an error; timings then cover only the iterations before it.
+    bool bFailed = false;
+    FString Error;
+};
+
+class FMcpBenchmark
+{
+public:
+    static bool Run(const FMcpBenchmarkConfig& Config, TArray<FMcpBenchmarkResult>& OutResults, FString& OutError);
+    static bool WriteCsv(const FMcpBenchmarkConfig& Config, const TArray<FMcpBenchmarkResult>& Results, const FString& Path, FString& OutError);
+    static bool CompareWithBaseline(const FMcpBenchmarkConfig& Config, const TArray<FMcpBenchmarkResult>& Results, TArray<FString>& OutRegressions, FString& OutError);
+    static UBlueprint* GenerateSyntheticBlueprint(const FMcpBenchmarkConfig& Config, FString& OutError);
+    static void DiscardSyntheticBlueprint(UBlueprint* Blueprint);
+
+private:
+    // Body returns false with an error to fail the case. Teardown runs after each iteration, outside the timing.
+    static FMcpBenchmarkResult Measure(const FString& Case, int32 Iterations, TFunctionRef<bool(int32, FString&)> Body, const TFunction<void(int32)>& Teardown = nullptr);
+    static uint64 GetAllocationCount();
+    static FString MakeSizeKey(const FMcpBenchmarkConfig& Config);
+};
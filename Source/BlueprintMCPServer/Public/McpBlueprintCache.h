@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "McpServerMetrics.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UBlueprint;
+struct FAssetData;
+
+// Bounded LRU of loaded Blueprints keyed by normalized object path, so repeated edits of the same
+// asset skip LoadObject's path parsing and object hash lookup. Entries are weak and are dropped on
+// asset rename/removal and after garbage collection. Game thread only.
+class FMcpBlueprintCache
+{
+public:
+    explicit FMcpBlueprintCache(int32 InCapacity = 128);
+    ~FMcpBlueprintCache();
+
+    UBlueprint* Load(const FString& AssetPath);
+    void Remove(const FString& AssetPath);
+    void Empty();
+
+    static FString NormalizePath(const FString& AssetPath);
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<UBlueprint> Blueprint;
+        uint64 LastUse = 0;
+    };
+
+    void EvictOldest();
+    void PurgeStale();
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+    TMap<FString, FEntry> Entries;
+    int32 Capacity;
+    uint64 UseCounter = 0;
+    FMcpCacheCounters Counters;
+
+    FDelegateHandle PostGarbageCollectHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "McpServerMetrics.h"
+#include "UObject/GCObject.h"
+
+class FJsonObject;
+class UBlueprint;
+
+// Structural diff between two Blueprints: parent class, variables, components, graphs, nodes, pin
+// defaults and links. Variables, components and graphs are paired by GUID, then by name; nodes by
+// GUID, then by class, pin layout and nearest position for nodes an edit recreated. Node and link
+// references in the result use the target's node GUIDs.
+// Saved revisions are loaded from a copy of the package file and kept until the file changes, so
+// diffing an asset against disk after every edit only pays for the comparison. Game thread only.
+class FMcpBlueprintDiff : public FGCObject
+{
+public:
+    FMcpBlueprintDiff();
+    virtual ~FMcpBlueprintDiff() override;
+
+    static TSharedRef<FJsonObject> Diff(const UBlueprint* Base, const UBlueprint* Target);
+    UBlueprint* LoadSavedRevision(const UBlueprint* Blueprint, FString& OutError);
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override { return TEXT("FMcpBlueprintDiff"); }
+
+private:
+    static constexpr int32 MaxSavedRevisions = 8;
+
+    struct FSavedRevision
+    {
+        TObjectPtr<UBlueprint> Blueprint;
+        FDateTime Timestamp;
+    };
+
+    static void Release(FSavedRevision& Revision);
+
+    TMap<FString, FSavedRevision> SavedRevisions;
+    FMcpCacheCounters Counters;
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintMutator.h"
+#include "Containers/Ticker.h"
+#include "UObject/GCObject.h"
+
+class FJsonObject;
+class UBlueprint;
+class UEdGraphNode;
+class UEdGraphPin;
+class UK2Node_CallFunction;
+
+enum class EMcpRefactorOp : uint8
+{
+    ReplaceFunctionCall,
+    RenameVariable,
+    RetargetClass,
+    ReplaceComponentClass
+};
+
+struct FMcpRefactorSpec
+{
+    EMcpRefactorOp Op = EMcpRefactorOp::ReplaceFunctionCall;
+
+    // replace_function_call. PinMap renames pins of the old call to pins of the new one; unmapped pins keep their name.
+    TObjectPtr<UFunction> FromFunction = nullptr;
+    TObjectPtr<UFunction> ToFunction = nullptr;
+    TMap<FName, FName> PinMap;
+
+    // rename_variable: a member variable of Owner.
+    TObjectPtr<UBlueprint> Owner = nullptr;
+    FName FromVariable;
+    FName ToVariable;
+
+    // retarget_class and replace_component_class.
+    TObjectPtr<UClass> FromClass = nullptr;
+    TObjectPtr<UClass> ToClass = nullptr;
+    bool bReparent = false;
+
+    // Content paths to scan when the target is native and the asset registry cannot narrow the search.
+    TArray<FString> Roots;
+    bool bDryRun = false;
+    bool bSave = false;
+};
+
+// Project-wide refactors run as a background job on the game thread. Candidate Blueprints come from
+// the asset registry (referencers of the package that defines the target, or every Blueprint under
+// Roots for native targets). One Blueprint is loaded, planned and edited per step, within the
+// time-slicer frame budget; each Blueprint's edits are one undo transaction, and nothing is touched
+// unless the whole plan for that Blueprint is valid. Edited Blueprints are compiled together in one
+// batch with a single reinstancing pass, then optionally saved. A dry run only plans and reports.
+// Cancelling stops editing, still compiles what was already edited, and skips saving.
+class FMcpBulkRefactor : public FGCObject
+{
+public:
+    ~FMcpBulkRefactor();
+
+    bool Start(const FMcpRefactorSpec& InSpec, int32& OutJobId, FString& OutError);
+    bool Cancel(int32 JobId, FString& OutError);
+    void CancelAll();
+    bool IsRunning() const { return TickerHandle.IsValid(); }
+
+    // Null when JobId is unknown; only the most recent jobs are kept.
+    TSharedPtr<FJsonObject> BuildJobJson(int32 JobId) const;
+
+    static bool ParseOp(const FString& Name, EMcpRefactorOp& OutOp);
+    static const TCHAR* GetOpName(EMcpRefactorOp Op);
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override { return TEXT("FMcpBulkRefactor"); }
+
+private:
+    enum class EStatus : uint8
+    {
+        Running,
+        Finished,
+        Cancelled
+    };
+
+    enum class EPhase : uint8
+    {
+        Edit,
+        Compile,
+        Save,
+        Done
+    };
+
+    struct FBlueprintResult
+    {
+        FString AssetPath;
+        // Held from the edit until the job finishes.
+        TObjectPtr<UBlueprint> Blueprint = nullptr;
+        TArray<FMcpGraphEdit> Edits;
+        FString Error;
+        bool bApplied = false;
+        bool bCompiled = false;
+        bool bSaved = false;
+    };
+
+    struct FJob
+    {
+        int32 Id = 0;
+        FMcpRefactorSpec Spec;
+        EStatus Status = EStatus::Running;
+        EPhase Phase = EPhase::Edit;
+        bool bCancelRequested = false;
+        FString Error;
+        double StartTime = 0.0;
+        double EndTime = 0.0;
+
+        TArray<FString> Candidates;
+        int32 NextCandidate = 0;
+        TArray<FBlueprintResult> Results;
+        int32 NextSave = 0;
+        // replace_function_call: a detached call to ToFunction in a transient scratch Blueprint, so
+        // planning checks pins, links and defaults without creating anything under the edited assets.
+        TObjectPtr<UK2Node_CallFunction> ProbeNode = nullptr;
+        int32 NumEdits = 0;
+        int32 NumFailed = 0;
+    };
+
+    bool Tick(float DeltaTime);
+    bool FindCandidates(FJob& Job, FString& OutError) const;
+    void ProcessBlueprint(FJob& Job, const FString& AssetPath);
+    bool Plan(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const;
+    void CompileEdited(FJob& Job);
+    static UK2Node_CallFunction* CreateProbeNode(UFunction* Function);
+    static void DiscardProbeNode(FJob& Job);
+    void Finish(FJob& Job, EStatus InStatus);
+    const FJob* FindJob(int32 JobId) const;
+    FJob* GetActiveJob();
+
+    bool PlanReplaceFunctionCall(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const;
+    // Pairs each connected or defaulted pin of Node with its counterpart on Replacement, failing when a link or default cannot move.
+    bool MatchCallPins(const FJob& Job, UEdGraphNode* Node, UK2Node_CallFunction* Replacement, TArray<TPair<UEdGraphPin*, UEdGraphPin*>>& OutMoves, TArray<FMcpGraphEdit>* OutEdits, FString& OutError) const;
+    bool PlanRenameVariable(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const;
+    bool PlanRetargetClass(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const;
+    bool PlanReplaceComponentClass(const FJob& Job, UBlueprint* Blueprint, bool bApply, TArray<FMcpGraphEdit>& OutEdits, FString& OutError) const;
+
+    TArray<TUniquePtr<FJob>> Jobs;
+    int32 ActiveJobId = INDEX_NONE;
+    int32 NextJobId = 1;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
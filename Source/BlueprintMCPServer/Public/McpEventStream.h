@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpResultCallback.h"
+#include "HttpServerRequest.h"
+
+struct FAssetData;
+struct FObjectPostSaveContext;
+class UBlueprint;
+class UPackage;
+
+enum class EMcpEventType : uint8
+{
+    None = 0,
+    BlueprintCompiled = 1 << 0,
+    BlueprintChanged = 1 << 1,
+    BlueprintSaved = 1 << 2,
+    AssetAdded = 1 << 3,
+    AssetRemoved = 1 << 4,
+    AssetRenamed = 1 << 5,
+    JobCompleted = 1 << 6,
+    All = 0x7F
+};
+ENUM_CLASS_FLAGS(EMcpEventType);
+
+struct FMcpEvent
+{
+    uint64 Id = 0;
+    EMcpEventType Types = EMcpEventType::None;
+    FString AssetPath;
+    FString OldPath;
+    FString Detail;
+    double FirstTime = 0.0;
+    double LastTime = 0.0;
+};
+
+class FMcpEventStream
+{
+public:
+    FMcpEventStream();
+    ~FMcpEventStream();
+
+    void Publish(EMcpEventType Type, const FString& AssetPath, const FString& Detail = FString(), const FString& OldPath = FString());
+    bool HandleSubscribe(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+    static EMcpEventType ParseEventTypes(const FString& CommaSeparated);
+    static void DescribeEventTypes(EMcpEventType Types, TArray<FString>& OutNames);
+
+private:
+    struct FSubscription
+    {
+        TArray<FString> Paths;
+        TArray<FString> Roots;
+        EMcpEventType Types = EMcpEventType::All;
+        uint64 LastEventId = 0;
+        // Set when the resume id is older than the retained history, or from before an editor restart:
+        // the response starts with a reset event so the client re-reads state instead of trusting the gap.
+        const TCHAR* ResetReason = nullptr;
+        double Deadline = 0.0;
+        FHttpResultCallback OnComplete;
+    };
+
+    bool Tick(float DeltaTime);
+    void FlushPending(double Now);
+    bool CollectMatching(const FSubscription& Subscription, TArray<const FMcpEvent*>& OutEvents) const;
+    void CompleteSubscription(const FSubscription& Subscription, const TArray<const FMcpEvent*>& Events) const;
+    static bool MatchesFilter(const FSubscription& Subscription, const FMcpEvent& Event);
+
+    void OnObjectModified(UObject* Object);
+    void OnBlueprintPreCompile(UBlueprint* Blueprint);
+    void OnBlueprintCompiled();
+    void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+    mutable FCriticalSection Mutex;
+    TMap<FString, FMcpEvent> Pending;
+    TArray<FMcpEvent> History;
+    TArray<FSubscription> Subscriptions;
+    TSet<FString> CompilingBlueprints;
+    uint64 NextEventId = 1;
+    // Highest id dropped from History; resuming at or below it would skip events.
+    uint64 TrimmedThroughId = 0;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+    FDelegateHandle ObjectModifiedHandle;
+    FDelegateHandle PackageSavedHandle;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "McpExportCommandlet.generated.h"
+
+/**
+ * Writes every Blueprint in the project to sharded NDJSON files plus a manifest, as the
+ * export_project action does, without running a server.
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=McpExport [-out=<dir>] [-roots=/Game/A,/Game/B]
+ *        [-batch=32] [-shard=256] [-gcbatches=8] [-gcmb=1024] [-compress] [-incremental]
+ */
+UCLASS()
+class UMcpExportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMcpExportCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
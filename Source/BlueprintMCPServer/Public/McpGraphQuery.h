@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "McpServerMetrics.h"
+
+class FJsonValue;
+class UBlueprint;
+class UEdGraphNode;
+
+// A compiled graph pattern: a chain of node patterns joined by link steps, e.g.
+//   (cast:DynamicCast) -[data]-> (branch:IfThenElse)
+//   (start:Event {function=ReceiveBeginPlay}) -[exec*..20]-> (spawn:SpawnActorFromClass)
+//   (n {unconnected=exec_in})
+// Node patterns take an optional variable, a ":Class" shorthand and {key=value, key!=value} filters
+// on class, title, function, variable, pin, unconnected and guid; values are case-insensitive
+// wildcards. Steps are "-[kind]->" (output to input) or "<-[kind]-", kind being exec, data or empty
+// for any, with an optional "*min..max" hop range for reachability. Immutable once compiled, so one
+// instance can be reused across Blueprints.
+class FMcpGraphQuery
+{
+public:
+    static TSharedPtr<const FMcpGraphQuery> Compile(const FString& Text, FString& OutError);
+
+    // Appends matches in Blueprint to OutMatches until it holds Limit entries; returns false once the limit is hit.
+    bool Run(const UBlueprint* Blueprint, int32 Limit, TArray<TSharedPtr<FJsonValue>>& OutMatches) const;
+
+    static constexpr int32 MaxPathDepth = 32;
+
+private:
+    enum class EField : uint8
+    {
+        Class,
+        Title,
+        Function,
+        Variable,
+        Pin,
+        Unconnected,
+        Guid
+    };
+
+    enum class ELinkKind : uint8
+    {
+        Any,
+        Exec,
+        Data
+    };
+
+    struct FFilter
+    {
+        EField Field = EField::Class;
+        FString Pattern;
+        bool bNegate = false;
+    };
+
+    struct FNodePattern
+    {
+        FString Variable;
+        TArray<FFilter> Filters;
+    };
+
+    struct FStep
+    {
+        ELinkKind Kind = ELinkKind::Any;
+        bool bForward = true;
+        int32 MinHops = 1;
+        int32 MaxHops = 1;
+    };
+
+    class FParser;
+
+    bool Matches(const UEdGraphNode* Node, const FNodePattern& Pattern) const;
+    bool MatchesFilter(const UEdGraphNode* Node, const FFilter& Filter) const;
+    void CollectReachable(const UEdGraphNode* From, const FStep& Step, TArray<const UEdGraphNode*>& OutNodes) const;
+    bool Extend(int32 Position, TArray<const UEdGraphNode*>& Bound, const FString& AssetPath, const FString& GraphName, int32 Limit, TArray<TSharedPtr<FJsonValue>>& OutMatches) const;
+
+    static bool MatchesLinkKind(const class UEdGraphPin* Pin, ELinkKind Kind);
+
+    TArray<FNodePattern> Nodes;
+    TArray<FStep> Steps;
+};
+
+// Compiled queries keyed by their text, so an agent re-running a query skips parsing. Game thread only.
+class FMcpGraphQueryCache
+{
+public:
+    FMcpGraphQueryCache();
+    ~FMcpGraphQueryCache();
+
+    TSharedPtr<const FMcpGraphQuery> Get(const FString& Text, FString& OutError);
+
+private:
+    static constexpr int32 Capacity = 64;
+
+    TMap<FString, TSharedPtr<const FMcpGraphQuery>> Queries;
+    FMcpCacheCounters Counters;
+};
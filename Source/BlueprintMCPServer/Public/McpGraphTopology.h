@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class UBlueprint;
+
+// Flat graph topology for client-side analytics: per graph a node table (GUID, class index,
+// function index) and exec and data edges in compressed-sparse-row form. Edges run from output to
+// input pins; offsets[i]..offsets[i+1] are the edges leaving node i, with target node, source pin
+// and target pin indices. Pin indices match the pin order of get_blueprint_structure.
+// In binary form each graph's arrays are packed as little-endian int32 and base64-encoded in the
+// order: guids (4 per node), classes, functions, exec offsets, targets, source pins, target pins,
+// then the same four arrays for data edges.
+class FMcpGraphTopology
+{
+public:
+    // GraphName limits the export to one graph; empty exports all of them.
+    static bool Build(const UBlueprint* Blueprint, const FString& GraphName, bool bBinary, TSharedPtr<FJsonObject>& OutJson, FString& OutError);
+};
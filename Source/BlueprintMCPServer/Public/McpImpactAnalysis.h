@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+// Reverse-dependency walk over the asset registry: which Blueprints recompile if an asset or class
+// changes. Packages are never loaded; node counts come from loaded Blueprints or are estimated from
+// package size.
+class FMcpImpactAnalysis
+{
+public:
+    // Exactly one of AssetPath (any asset: Blueprint, struct, enum, ...) or ClassPath (native or
+    // Blueprint-generated class path) is expected.
+    static bool Analyze(const FString& AssetPath, const FString& ClassPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError);
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "McpLoadGenCommandlet.generated.h"
+
+/**
+ * Drives a running MCP server with recorded or synthetic traffic and reports throughput, latency,
+ * error rates and the server's frame-time impact.
+ * Replay:    UnrealEditor-Cmd <Project>.uproject -run=McpLoadGen -capture=<file.jsonl> [-speed=1.0] [-loops=1]
+ * Synthetic: UnrealEditor-Cmd <Project>.uproject -run=McpLoadGen -mix=get_blueprint_structure=4,list_blueprints=1 -asset=/Game/BP_Foo [-duration=30]
+ * Common:    [-url=http://127.0.0.1:9000/mcp] [-concurrency=8] [-rate=0] [-baseline=5] [-seed=0] [-out=<report.json>]
+ */
+UCLASS()
+class UMcpLoadGenCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMcpLoadGenCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
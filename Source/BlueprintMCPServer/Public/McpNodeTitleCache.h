@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "McpServerMetrics.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+class UEdGraphNode;
+
+// ListView node titles per Blueprint, keyed by node GUID. A Blueprint's titles are dropped when it
+// or one of its graphs/nodes is modified (node reconstruction calls Modify) or when it is compiled.
+// Game thread only. Created on first use; the module destroys it on shutdown, which unhooks it.
+class FMcpNodeTitleCache
+{
+public:
+    static FMcpNodeTitleCache& Get();
+    static void Shutdown();
+
+    ~FMcpNodeTitleCache();
+
+    const FString& GetTitle(const UEdGraphNode* Node);
+    void Invalidate(const UBlueprint* Blueprint);
+
+private:
+    FMcpNodeTitleCache();
+
+    void RegisterEditorHooks();
+    void OnObjectModified(UObject* Object);
+    void OnBlueprintCompiled();
+    void PurgeStale();
+
+    struct FBlueprintTitles
+    {
+        TMap<FGuid, FString> Titles;
+    };
+
+    TMap<TObjectKey<UBlueprint>, FBlueprintTitles> Blueprints;
+    FString UncachedTitle;
+    FMcpCacheCounters Counters;
+
+    FDelegateHandle ObjectModifiedHandle;
+    FDelegateHandle PostGarbageCollectHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+
+    static TUniquePtr<FMcpNodeTitleCache> Instance;
+};
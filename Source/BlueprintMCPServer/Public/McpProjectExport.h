@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintInspector.h"
+#include "Containers/Ticker.h"
+
+class FJsonObject;
+class UPackage;
+
+struct FMcpProjectExportConfig
+{
+    FString OutputDir;
+    TArray<FString> Roots;
+    int32 BatchSize = 32;
+    int32 ShardSize = 256;
+    // Garbage is collected after this many batches, or sooner once memory use grows by GcMemoryGrowthMB.
+    int32 GcEveryBatches = 8;
+    int32 GcMemoryGrowthMB = 1024;
+    bool bCompress = false;
+    bool bIncremental = false;
+    FMcpExportOptions Options;
+};
+
+// Writes every Blueprint under Roots to <OutputDir>/shard_<generation>_<n>.ndjson[.gz], one
+// get_blueprint_structure object per line, plus manifest.json with per-shard MD5s and each asset's
+// package hash and shard. Blueprints are loaded and converted to JSON on the game thread one batch
+// per tick; serialization, compression and writes run on the thread pool while the next batch
+// loads. Shards hold at least ShardSize records, rounded up to whole batches. Blueprint packages the
+// export loaded itself are released after each batch and garbage collected every GcEveryBatches
+// batches, or earlier when memory grows by GcMemoryGrowthMB, to keep memory flat.
+// Incremental runs re-export only packages whose saved hash changed (or that are dirty) and carry
+// the other manifest entries forward, so a record in an older shard is superseded by the shard the
+// manifest names for that asset. Game thread only.
+class FMcpProjectExporter
+{
+public:
+    ~FMcpProjectExporter();
+
+    bool Start(const FMcpProjectExportConfig& InConfig, FString& OutError);
+    void Cancel();
+    bool IsRunning() const { return TickerHandle.IsValid(); }
+    bool HasFailed() const { return Status == EStatus::Failed; }
+
+    TSharedRef<FJsonObject> BuildStatusJson() const;
+
+    static FString GetDefaultOutputDir();
+
+private:
+    enum class EStatus : uint8
+    {
+        Idle,
+        Running,
+        Finished,
+        Cancelled,
+        Failed
+    };
+
+    struct FAssetEntry
+    {
+        FString PackageHash;
+        FString Shard;
+        bool bDirty = false;
+    };
+
+    struct FShardResult
+    {
+        FString File;
+        int32 Records = 0;
+        int64 Bytes = 0;
+        FString Hash;
+        FString Error;
+    };
+
+    struct FBatch
+    {
+        TFuture<TArray<uint8>> Lines;
+        TArray<FString> Assets;
+    };
+
+    struct FPendingAsset
+    {
+        FString ObjectPath;
+        FName PackageName;
+        FString PackageHash;
+        bool bDirty = false;
+    };
+
+    bool Tick(float DeltaTime);
+    void ExportBatch();
+    void CollectBatches(bool bWait);
+    void FlushShard();
+    void CollectShards(bool bWait);
+    void ReleaseLoadedPackages(const TArray<UPackage*>& LoadedPackages);
+    bool ReadManifest(TMap<FString, FAssetEntry>& OutAssets, TMap<FString, FShardResult>& OutShards, int32& OutGeneration, FString& OutError) const;
+    bool WriteManifest(FString& OutError) const;
+    FString GetManifestPath() const;
+    void Finish(EStatus InStatus, const FString& InError = FString());
+
+    FMcpProjectExportConfig Config;
+    EStatus Status = EStatus::Idle;
+    FString Error;
+    int32 Generation = 0;
+    double StartTime = 0.0;
+    double EndTime = 0.0;
+
+    TArray<FPendingAsset> Pending;
+    int32 NextPending = 0;
+    int32 Exported = 0;
+    int32 Unchanged = 0;
+    TArray<FString> Failures;
+    int32 NumFailures = 0;
+
+    int32 BatchesSinceGc = 0;
+    uint64 UsedPhysicalAfterGc = 0;
+    int32 NumGarbageCollections = 0;
+
+    // Batches being serialized, lines waiting for the current shard to fill, and shards being written.
+    TArray<FBatch> PendingBatches;
+    TArray<uint8> ShardBuffer;
+    TArray<FString> ShardAssets;
+    TArray<TFuture<FShardResult>> PendingShards;
+
+    TMap<FString, FAssetEntry> Assets;
+    TMap<FString, FShardResult> Shards;
+    TSet<FString> WrittenShardFiles;
+    TSet<FString> StaleShardFiles;
+    int32 NextShard = 0;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FJsonObject;
+class FRunnableThread;
+class IFileHandle;
+
+// Captures incoming requests (arrival time, transport, client, action and params) as JSON Lines so
+// they can be replayed with the McpLoadGen commandlet. Off unless started via Mcp.Capture.Start or
+// the server commandlet's -capture= argument. Record() is cheap when not capturing and thread-safe.
+class FMcpRequestRecorder : public FRunnable
+{
+public:
+    static FMcpRequestRecorder& Get();
+
+    bool Start(const FString& InPath, FString& OutError);
+    void Shutdown();
+    bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+    const FString& GetPath() const { return FilePath; }
+
+    void Record(const TCHAR* Transport, const FString& Client, const FString& Action, const TSharedPtr<FJsonObject>& Payload);
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    FMcpRequestRecorder() = default;
+    virtual ~FMcpRequestRecorder() override;
+
+    void WritePending();
+
+    FString FilePath;
+    TUniquePtr<IFileHandle> FileHandle;
+    double StartTime = 0.0;
+
+    TQueue<FString, EQueueMode::Mpsc> Pending;
+    std::atomic<int32> PendingCount{0};
+    std::atomic<int32> DroppedCount{0};
+    std::atomic<bool> bRecording{false};
+    std::atomic<bool> bStopping{false};
+
+    FEvent* WakeEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+};
@@ -5,11 +5,52 @@
 #include "HttpServerRequest.h"
 #include "HttpRequestHandler.h"
 #include "HttpResultCallback.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include <atomic>
 
-DECLARE_MULTICAST_DELEGATE_OneParam(FMcpLogDelegate, const FString& /*Message*/);
+enum class EMcpLogSeverity : uint8
+{
+    Info,
+    Warning,
+    Error
+};
+
+using FMcpActionCallback = TFunction<void(bool /*bOk*/, const FString& /*Response*/, const FString& /*Error*/)>;
+
+enum class EMcpSubmitResult : uint8
+{
+    Admitted,
+    BadRequest,
+    Busy,
+    Warming
+};
+
+struct FMcpLogEntry
+{
+    FDateTime Time;
+    EMcpLogSeverity Severity = EMcpLogSeverity::Info;
+    FString Message;
+};
 
 class FHttpServerModule;
 class IHttpRouter;
+class FMcpEventStream;
+class FMcpWebSocketTransport;
+class FMcpUnixSocketTransport;
+class FMcpAccessLog;
+class FMcpAdmissionController;
+class FMcpTemplateLibrary;
+class FMcpSymbolResolver;
+class FMcpBlueprintCache;
+class FMcpValidationSandbox;
+class FMcpWarmup;
+class FMcpBlueprintDiff;
+class FMcpGraphQueryCache;
+class FMcpProjectExporter;
+class FMcpBulkRefactor;
+class FMcpTimeSlicer;
+struct FMcpRequestTiming;
 
 class FMcpServer : public TSharedFromThis<FMcpServer>
 {
@@ -22,15 +63,52 @@ public:
 
     bool IsRunning() const { return bIsRunning; }
     uint16 GetPort() const { return Port; }
+    uint16 GetWebSocketPort() const { return WebSocketTransport.IsValid() ? WebSocketPort : 0; }
     void SetAllowWrites(bool bInAllowWrites) { bAllowWrites = bInAllowWrites; }
+    bool GetAllowWrites() const { return bAllowWrites; }
+    void SetWebSocketPort(uint16 InPort) { WebSocketPort = InPort; }
+    // Empty falls back to Mcp.UnixSocket.Path.
+    void SetUnixSocketPath(const FString& InPath) { UnixSocketPath = InPath; }
+    void SetAllowShutdown(bool bInAllowShutdown) { bAllowShutdown = bInAllowShutdown; }
+    bool IsShutdownRequested() const { return bShutdownRequested.load(); }
+    // Warm caches and editor modules after Start; requests other than get_server_stats get a "warming" reply meanwhile.
+    void SetWarmUpOnStart(bool bInWarmUp) { bWarmUpOnStart = bInWarmUp; }
+    bool IsWarmingUp(const FString& Action) const;
+    FString GetWarmupStatus() const;
 
-    FMcpLogDelegate OnLog;
+    bool ExecuteAction(const FString& Action, const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError, FMcpRequestTiming& Timing) const;
+    // Queues the action in its admission lane; OnDone runs on the game thread. Returns false when the lane is full.
+    // Safe to call from any thread.
+    bool SubmitAction(const FString& Action, const TSharedPtr<FJsonObject>& Payload, const FString& ClientKey, const FMcpRequestTiming& Timing, FMcpActionCallback&& OnDone, int32& OutRetryAfterSeconds);
+    // Parses a UTF-8 `{ "action", "params" }` body and submits it. Shared by all request/response transports.
+    EMcpSubmitResult SubmitRequest(TConstArrayView<uint8> Body, const FString& ClientKey, FMcpRequestTiming& Timing, FMcpActionCallback&& OnDone, FString& OutError, int32& OutRetryAfterSeconds);
+    const FMcpAdmissionController& GetAdmission() const { return *Admission; }
+    void NotifyActionCompleted(const FString& Action, const TSharedPtr<FJsonObject>& Payload);
+    void Log(const FString& Message, EMcpLogSeverity Severity = EMcpLogSeverity::Info) const;
+
+    // Moves pending log entries into OutEntries. Single consumer (the UI panel on the game thread).
+    int32 DrainLog(TArray<FMcpLogEntry>& OutEntries, int32 MaxEntries);
+    void SetLogCaptureEnabled(bool bEnabled) { bLogCaptureEnabled = bEnabled; }
 
 private:
     bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+    bool HandleMetricsRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+    bool HandleEventsRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
     bool DispatchAction(const FString& Action, const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError) const;
-    void Log(const FString& Message) const;
+    // get_blueprint_structure from a worker thread, with the game-thread part spread over frames.
+    bool ExportStructureSliced(const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError, FMcpRequestTiming& Timing) const;
+    // query_graph from a worker thread; root scans load the Blueprints they visit a slice at a time.
+    bool QueryGraphSliced(const TSharedPtr<FJsonObject>& Payload, FString& OutResponse, FString& OutError, FMcpRequestTiming& Timing) const;
+    void RecordAccess(const FString& Action, const TSharedPtr<FJsonObject>& Payload, bool bSuccess, const FString& Error, const FMcpRequestTiming& Timing) const;
+    static void RunGameThread(TFunction<void()>&& InFunc);
+    void BeginWarmup();
     bool bAllowWrites = false;
+    uint16 WebSocketPort = 0;
+    FString UnixSocketPath;
+    bool bAllowShutdown = false;
+    bool bWarmUpOnStart = false;
+    mutable std::atomic<bool> bShutdownRequested{false};
+    mutable bool bValidatingEdits = false;
 
     bool bIsRunning;
     uint16 Port;
@@ -38,4 +116,25 @@ private:
     class FHttpServerModule* HttpServerModule;
     TSharedPtr<class IHttpRouter> Router;
     TArray<FHttpRouteHandle> RouteHandles;
+    FTSTicker::FDelegateHandle FrameTickerHandle;
+    TUniquePtr<FMcpEventStream> EventStream;
+    TSharedPtr<FMcpWebSocketTransport> WebSocketTransport;
+    TSharedPtr<FMcpUnixSocketTransport, ESPMode::ThreadSafe> UnixSocketTransport;
+    TUniquePtr<FMcpAccessLog> AccessLog;
+    TSharedRef<FMcpAdmissionController, ESPMode::ThreadSafe> Admission;
+    TUniquePtr<FMcpTemplateLibrary> Templates;
+    TUniquePtr<FMcpSymbolResolver> Symbols;
+    TUniquePtr<FMcpBlueprintCache> Blueprints;
+    TUniquePtr<FMcpValidationSandbox> Validation;
+    TUniquePtr<FMcpWarmup> Warmup;
+    TUniquePtr<FMcpBlueprintDiff> Diffs;
+    TUniquePtr<FMcpGraphQueryCache> Queries;
+    TUniquePtr<FMcpProjectExporter> Exporter;
+    TUniquePtr<FMcpTimeSlicer> Slicer;
+    TUniquePtr<FMcpBulkRefactor> Refactors;
+
+    mutable TQueue<FMcpLogEntry, EQueueMode::Mpsc> PendingLog;
+    mutable std::atomic<int32> PendingLogCount{0};
+    mutable std::atomic<int32> DroppedLogCount{0};
+    std::atomic<bool> bLogCaptureEnabled{false};
 };
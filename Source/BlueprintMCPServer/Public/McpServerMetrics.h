@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FJsonObject;
+
+enum class EMcpLatencyStage : uint8
+{
+    QueueWait,
+    GameThread,
+    Serialization,
+    Total,
+    Num
+};
+
+struct FMcpRequestTiming
+{
+    // Who sent the request; recorded in the access log.
+    const TCHAR* Transport = TEXT("internal");
+    FString Client;
+
+    double StartTime = 0.0;
+    double QueueWaitSeconds = 0.0;
+    double GameThreadSeconds = 0.0;
+    double SerializationSeconds = 0.0;
+    double TotalSeconds = 0.0;
+    int64 RequestBytes = 0;
+    int64 ResponseBytes = 0;
+};
+
+// Makes a request's timing visible to code that runs on the current thread, e.g. response serialization.
+struct FMcpRequestTimingScope
+{
+    explicit FMcpRequestTimingScope(FMcpRequestTiming& Timing);
+    ~FMcpRequestTimingScope();
+
+    static FMcpRequestTiming* GetCurrent();
+
+private:
+    FMcpRequestTiming* Previous;
+};
+
+struct FMcpScopedSerializationTimer
+{
+    FMcpScopedSerializationTimer();
+    ~FMcpScopedSerializationTimer();
+
+private:
+    double StartTime;
+};
+
+struct FMcpCacheCounters
+{
+    std::atomic<uint64> Hits{0};
+    std::atomic<uint64> Misses{0};
+    // Times the whole cache was rebuilt, for caches that are built in one go rather than per entry.
+    std::atomic<uint64> Rebuilds{0};
+
+    void Record(bool bHit)
+    {
+        (bHit ? Hits : Misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RecordRebuild()
+    {
+        Rebuilds.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+class FMcpLatencyHistogram
+{
+public:
+    static constexpr int32 NumBuckets = 18;
+    static const double BucketUpperBounds[NumBuckets];
+
+    FMcpLatencyHistogram();
+
+    void Record(double Seconds);
+    uint64 GetCount() const;
+    double GetSumSeconds() const;
+    double GetPercentile(double Fraction) const;
+    // Same interpolation over NumBuckets + 1 raw counts, e.g. the difference of two stats snapshots.
+    static double GetPercentile(TConstArrayView<uint64> BucketCounts, double Fraction);
+    uint64 GetBucketCount(int32 Index) const { return Counts[Index].load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64> Counts[NumBuckets + 1];
+    std::atomic<uint64> SumMicros;
+};
+
+class FMcpServerMetrics
+{
+public:
+    static FMcpServerMetrics& Get();
+
+    void BeginRequest();
+    // Only registered actions get their own slot; anything else a client sends is counted as "other".
+    void RegisterActions(TConstArrayView<const TCHAR*> Names);
+    void EndRequest(const FString& Action, bool bSuccess, const FMcpRequestTiming& Timing);
+    void RegisterCache(const FString& Name, FMcpCacheCounters* Counters);
+    void UnregisterCache(FMcpCacheCounters* Counters);
+    // Game-thread frame durations while the server runs; lets load tests see the editor-side cost.
+    void RecordFrameTime(double Seconds) { FrameTimes.Record(Seconds); }
+
+    TSharedRef<FJsonObject> BuildStatsJson() const;
+    FString BuildPrometheusText() const;
+
+    static const TCHAR* GetStageName(EMcpLatencyStage Stage);
+
+private:
+    static constexpr int32 MaxActions = 96;
+
+    struct FActionStats
+    {
+        FString Action;
+        std::atomic<uint64> Requests{0};
+        std::atomic<uint64> Errors{0};
+        std::atomic<uint64> RequestBytes{0};
+        std::atomic<uint64> ResponseBytes{0};
+        FMcpLatencyHistogram Stages[(int32)EMcpLatencyStage::Num];
+    };
+
+    FMcpServerMetrics();
+    FActionStats& FindAction(const FString& Action);
+
+    FActionStats Actions[MaxActions];
+    std::atomic<int32> NumActions{0};
+    std::atomic<int32> InFlight{0};
+    FCriticalSection RegistrationMutex;
+
+    FMcpLatencyHistogram FrameTimes;
+
+    mutable FCriticalSection CacheMutex;
+    TArray<TPair<FString, FMcpCacheCounters*>> Caches;
+};
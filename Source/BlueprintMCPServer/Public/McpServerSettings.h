@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "McpServerSettings.generated.h"
+
+// Project Settings > Plugins > Blueprint MCP Server.
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Blueprint MCP Server"))
+class UMcpServerSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+    // Start the server when the editor opens, once the asset registry has finished its initial scan.
+    UPROPERTY(config, EditAnywhere, Category = "Startup")
+    bool bAutoStart = false;
+
+    UPROPERTY(config, EditAnywhere, Category = "Startup", meta = (ClampMin = 1, ClampMax = 65535, EditCondition = "bAutoStart"))
+    int32 Port = 9000;
+
+    // 0 disables the WebSocket transport.
+    UPROPERTY(config, EditAnywhere, Category = "Startup", meta = (ClampMin = 0, ClampMax = 65535, EditCondition = "bAutoStart"))
+    int32 WebSocketPort = 0;
+
+    UPROPERTY(config, EditAnywhere, Category = "Startup", meta = (EditCondition = "bAutoStart"))
+    bool bAllowWrites = false;
+
+    // After any start, load editor modules and build the symbol index during idle frames. Requests get
+    // HTTP 503 with progress until it finishes.
+    UPROPERTY(config, EditAnywhere, Category = "Startup")
+    bool bWarmUp = true;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "McpServerMetrics.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+// Resolves class and Blueprint-callable function names given as full object paths or short names
+// (e.g. "Actor", "AActor", "PrintString", "KismetSystemLibrary.PrintString"). The short-name index
+// is built lazily and rebuilt after module loads, hot reloads and Blueprint compiles.
+class FMcpSymbolResolver
+{
+public:
+    FMcpSymbolResolver();
+    ~FMcpSymbolResolver();
+
+    UClass* ResolveClass(const FString& Name, FString& OutError, TArray<FString>* OutCandidates = nullptr);
+    UFunction* ResolveFunction(const FString& Name, FString& OutError, TArray<FString>* OutCandidates = nullptr);
+    void Invalidate() { bIndexValid = false; }
+    void Warm() { EnsureIndex(); }
+
+private:
+    void EnsureIndex();
+    void BuildIndex();
+    void RegisterEditorHooks();
+    UClass* LoadBlueprintClassByName(const FString& ShortName, TArray<FString>& OutCandidates);
+
+    template <typename T>
+    static T* PickUnique(const TArray<TWeakObjectPtr<T>>* Matches, const FString& Name, FString& OutError, TArray<FString>* OutCandidates);
+
+    TMap<FString, TArray<TWeakObjectPtr<UClass>>> ClassesByName;
+    TMap<FString, TArray<TWeakObjectPtr<UFunction>>> FunctionsByName;
+    bool bIndexValid = false;
+    FMcpCacheCounters Counters;
+
+    FDelegateHandle ModulesChangedHandle;
+    FDelegateHandle ReloadCompleteHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+};
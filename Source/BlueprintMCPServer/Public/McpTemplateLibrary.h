@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+
+struct FMcpTemplateNodeInfo
+{
+    // Stable key for the node inside the template: the GUID it had when captured.
+    FString Key;
+    FString Class;
+    FString Title;
+};
+
+// Named node clusters captured from graphs. Each template is imported once into a prototype graph
+// on a transient scratch Blueprint; instantiating duplicates that graph instead of re-parsing text.
+class FMcpTemplateLibrary : public FGCObject
+{
+public:
+    bool Capture(const FString& Name, UBlueprint* Blueprint, const FName& GraphName, const TArray<FGuid>& NodeGuids, TArray<FMcpTemplateNodeInfo>& OutNodes, FString& OutError);
+    bool Instantiate(const FString& Name, UBlueprint* Blueprint, const FName& GraphName, const FVector2D& Location,
+        const TMap<FString, TMap<FString, FString>>& PinOverrides, TMap<FString, FGuid>& OutNodeGuids, FString& OutError);
+    TArray<FString> GetTemplateNames() const;
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override { return TEXT("FMcpTemplateLibrary"); }
+
+private:
+    struct FTemplate
+    {
+        TObjectPtr<UEdGraph> Prototype;
+        TArray<FMcpTemplateNodeInfo> Nodes;
+        FIntPoint Origin = FIntPoint::ZeroValue;
+    };
+
+    UBlueprint* GetScratchBlueprint();
+    void DiscardPrototype(UEdGraph* Prototype);
+
+    TObjectPtr<UBlueprint> ScratchBlueprint;
+    TMap<FString, FTemplate> Templates;
+};
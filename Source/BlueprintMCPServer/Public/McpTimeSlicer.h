@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+class FJsonObject;
+
+// Runs resumable game-thread jobs a slice at a time from a core ticker, sharing one per-frame budget
+// (Mcp.TimeSlice.BudgetMs) round-robin between jobs. The budget shrinks during PIE and while the
+// user is interacting with the editor. Add/CancelAll on the game thread; stats from any thread.
+class FMcpTimeSlicer
+{
+public:
+    // Does work until Deadline (FPlatformTime::Seconds) and returns true once the job is finished.
+    using FStepFunction = TFunction<bool(double Deadline)>;
+    // bCompleted is false when the job was cancelled.
+    using FDoneFunction = TFunction<void(bool bCompleted)>;
+
+    ~FMcpTimeSlicer();
+
+    void Add(FStepFunction&& Step, FDoneFunction&& OnDone);
+    void CancelAll();
+
+    // False in commandlets and when the budget is 0; callers then run their work synchronously.
+    static bool IsEnabled();
+    static double GetFrameBudgetSeconds();
+
+    TSharedRef<FJsonObject> BuildStatsJson() const;
+
+private:
+    struct FJob
+    {
+        FStepFunction Step;
+        FDoneFunction OnDone;
+    };
+
+    bool Tick(float DeltaTime);
+
+    TArray<FJob> Jobs;
+    int32 NextJob = 0;
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    std::atomic<int32> ActiveJobs{0};
+    std::atomic<uint64> TotalSlices{0};
+    std::atomic<uint64> CompletedJobs{0};
+    std::atomic<double> LastBudgetMs{0.0};
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+UE_TRACE_CHANNEL_EXTERN(McpChannel, BLUEPRINTMCPSERVER_API);
+LLM_DECLARE_TAG_API(BlueprintMCP, BLUEPRINTMCPSERVER_API);
+
+#define MCP_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, McpChannel)
+#define MCP_TRACE_SCOPE_TEXT(Text) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Text, McpChannel)
+#define MCP_LLM_SCOPE() LLM_SCOPE_BYTAG(BlueprintMCP)
+
+class FMcpTrace
+{
+public:
+    static void RequestBegin(const FString& Action, const FString& AssetPath, int64 RequestBytes);
+    static void RequestEnd(const FString& Action, bool bSuccess, int64 ResponseBytes, double TotalSeconds);
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FMcpServer;
+class FRunnableThread;
+
+// Local listener on a Unix domain socket (mode 0600). Each connection speaks either HTTP/1.1
+// (`POST /mcp`, same bodies and status codes as the TCP server) or length-prefixed frames: a 4-byte
+// big-endian length followed by a UTF-8 JSON request. The protocol is picked from the first byte.
+// Requests on one connection are answered in order, one at a time; open more connections for
+// parallelism. All socket IO runs on one thread; actions go through FMcpServer::SubmitRequest.
+class FMcpUnixSocketTransport : public FRunnable, public TSharedFromThis<FMcpUnixSocketTransport, ESPMode::ThreadSafe>
+{
+public:
+    explicit FMcpUnixSocketTransport(TWeakPtr<FMcpServer> InServer);
+    virtual ~FMcpUnixSocketTransport() override;
+
+    static bool IsSupported();
+    // Path from Mcp.UnixSocket.Path, used when the server has none set explicitly.
+    static FString GetDefaultPath();
+
+    bool Start(const FString& InPath, FString& OutError);
+    void Shutdown();
+
+    const FString& GetPath() const { return SocketPath; }
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    enum class EProtocol : uint8
+    {
+        Unknown,
+        Http,
+        Framed
+    };
+
+    struct FConnection
+    {
+        int32 Fd = -1;
+        uint32 Id = 0;
+        EProtocol Protocol = EProtocol::Unknown;
+        TArray<uint8> In;
+        TArray<uint8> Out;
+        bool bInFlight = false;
+        // The peer shut down its side; buffered requests are still answered before closing.
+        bool bPeerClosed = false;
+        bool bCloseAfterWrite = false;
+        bool bClosed = false;
+    };
+
+    struct FOutgoing
+    {
+        uint32 ConnectionId = 0;
+        TArray<uint8> Bytes;
+        bool bClose = false;
+    };
+
+    void AcceptConnections();
+    void ReadConnection(FConnection& Connection);
+    void WriteConnection(FConnection& Connection);
+    void ProcessInput(FConnection& Connection);
+    bool TakeHttpRequest(FConnection& Connection);
+    bool TakeFrame(FConnection& Connection);
+    void Submit(FConnection& Connection, TArray<uint8>&& Body, const FString& ClientKey);
+    void DrainOutgoing();
+    void CloseConnection(FConnection& Connection);
+
+    // Called from any thread; hands a finished response to the IO thread.
+    void Respond(uint32 ConnectionId, EProtocol Protocol, int32 Status, const FString& Body, int32 RetryAfterSeconds, bool bClose);
+    void Wake();
+
+    static TArray<uint8> MakeHttpResponse(int32 Status, const FString& Body, int32 RetryAfterSeconds, bool bClose);
+    static TArray<uint8> MakeFrame(const FString& Body);
+
+    TWeakPtr<FMcpServer> ServerWeak;
+    FString SocketPath;
+    int32 ListenFd = -1;
+    int32 WakeFds[2] = { -1, -1 };
+    TArray<FConnection> Connections;
+    uint32 NextConnectionId = 1;
+
+    TQueue<FOutgoing, EQueueMode::Mpsc> Outgoing;
+    std::atomic<bool> bStopping{false};
+    FRunnableThread* Thread = nullptr;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+
+struct FMcpValidationDiagnostic
+{
+    FString Severity;
+    FString Message;
+    FString Graph;
+    FGuid NodeGuid;
+};
+
+// Transient copies of Blueprints used to dry-run edits. A copy is kept per source Blueprint together
+// with the edits already applied to it, so a validation whose edit list extends the previous one
+// only applies the new edits. Copies are discarded when the source is modified or compiled.
+// Game thread only.
+class FMcpValidationSandbox : public FGCObject
+{
+public:
+    FMcpValidationSandbox();
+    virtual ~FMcpValidationSandbox() override;
+
+    // Returns a copy of Source; OutAppliedCount is how many leading entries of EditKeys it already has.
+    UBlueprint* Acquire(UBlueprint* Source, const TArray<FString>& EditKeys, int32& OutAppliedCount, FString& OutError);
+    void MarkApplied(UBlueprint* Source, const TArray<FString>& EditKeys);
+    void Discard(const UBlueprint* Source);
+
+    static bool Compile(UBlueprint* Copy, TArray<FMcpValidationDiagnostic>& OutDiagnostics);
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override { return TEXT("FMcpValidationSandbox"); }
+
+private:
+    static constexpr int32 MaxCopies = 4;
+
+    struct FEntry
+    {
+        TObjectPtr<UBlueprint> Copy;
+        TWeakObjectPtr<UBlueprint> Source;
+        TArray<FString> AppliedEdits;
+        uint64 LastUse = 0;
+        FDelegateHandle CompiledHandle;
+    };
+
+    void Release(FEntry& Entry);
+    void OnObjectModified(UObject* Object);
+
+    TMap<TObjectKey<UBlueprint>, FEntry> Entries;
+    uint64 UseCounter = 0;
+    int32 CopyCounter = 0;
+    FDelegateHandle ObjectModifiedHandle;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+class FJsonObject;
+
+// Runs the server's one-off initialization (module loads, asset scan, symbol index) in small steps on
+// the game thread after Start, one step per tick and only while the user is not interacting with the
+// editor. A step returns false to be retried on a later tick. Progress can be read from any thread.
+class FMcpWarmup
+{
+public:
+    struct FStep
+    {
+        const TCHAR* Name;
+        TFunction<bool()> Run;
+    };
+
+    ~FMcpWarmup();
+
+    void Begin(TArray<FStep>&& InSteps);
+    void Cancel();
+
+    bool IsWarming() const { return bWarming.load(std::memory_order_acquire); }
+    FString Describe() const;
+    TSharedRef<FJsonObject> BuildStatusJson() const;
+
+private:
+    bool Tick(float DeltaTime);
+
+    TArray<FStep> Steps;
+    FTSTicker::FDelegateHandle TickerHandle;
+    double StartTime = 0.0;
+    double LastStepTime = 0.0;
+
+    std::atomic<bool> bWarming{false};
+    std::atomic<int32> NumSteps{0};
+    std::atomic<int32> CompletedSteps{0};
+    std::atomic<const TCHAR*> CurrentStep{nullptr};
+    std::atomic<double> ElapsedSeconds{0.0};
+};
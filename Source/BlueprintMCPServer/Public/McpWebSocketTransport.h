@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FMcpServer;
+class FJsonObject;
+class FJsonValue;
+class INetworkingWebSocket;
+class IWebSocketServer;
+
+class FMcpWebSocketTransport : public TSharedFromThis<FMcpWebSocketTransport>
+{
+public:
+    explicit FMcpWebSocketTransport(TWeakPtr<FMcpServer> InServer);
+    ~FMcpWebSocketTransport();
+
+    bool Start(uint16 InPort, FString& OutError);
+    void Stop();
+
+private:
+    // Where a fragmented message's completeness check stopped, carried across fragments.
+    struct FMessageScan
+    {
+        int32 Offset = 0;
+        int32 Depth = 0;
+        bool bInString = false;
+        bool bEscaped = false;
+
+        // Scans Bytes from Offset on; true once the top-level value has closed.
+        bool Advance(TConstArrayView<uint8> Bytes);
+    };
+
+    struct FConnection
+    {
+        uint32 Id = 0;
+        TUniquePtr<INetworkingWebSocket> Socket;
+        FString RemoteAddress;
+        // Fair-scheduling key: the last `client` a request on this connection named, else the address
+        // without the port, so one host cannot gain lanes by opening connections.
+        FString ClientKey;
+        TArray<uint8> Buffer;
+        FMessageScan Scan;
+        bool bClosed = false;
+    };
+
+    bool Tick(float DeltaTime);
+    void OnClientConnected(INetworkingWebSocket* Socket);
+    void OnReceive(void* Data, int32 Count, uint32 ConnectionId);
+    void OnClosed(uint32 ConnectionId);
+
+    void HandleMessage(uint32 ConnectionId, const FString& Message);
+    // Id is null for notifications, which get no reply.
+    void SendResult(uint32 ConnectionId, const TSharedPtr<FJsonValue>& Id, bool bOk, const FString& Payload, const FString& Error);
+    void SendText(uint32 ConnectionId, const FString& Text);
+    FConnection* FindConnection(uint32 ConnectionId);
+
+    static FString MakeResultMessage(const TSharedPtr<FJsonValue>& Id, const FString& ResultJson);
+    static FString MakeErrorMessage(const TSharedPtr<FJsonValue>& Id, int32 Code, const FString& Message, int32 RetryAfterSeconds = 0);
+
+    TWeakPtr<FMcpServer> ServerWeak;
+    TUniquePtr<IWebSocketServer> Server;
+    TArray<TUniquePtr<FConnection>> Connections;
+    FTSTicker::FDelegateHandle TickerHandle;
+    uint32 NextConnectionId = 1;
+};